@@ -0,0 +1,164 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <umps/messageFormats/text.hpp>
+#include <umps/proxyBroadcasts/heartbeat/status.hpp>
+
+/// Compares the streaming CBOR encoder/decoder used by the Status and Text
+/// messages with the equivalent nlohmann::json DOM-based implementation.
+
+using namespace UMPS::ProxyBroadcasts::Heartbeat;
+using namespace UMPS::MessageFormats;
+
+namespace
+{
+
+constexpr int N_ITERATIONS{200000};
+
+/// Times a function and returns the number of nanoseconds per iteration
+double timeIt(const std::function<void ()> &function)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < N_ITERATIONS; ++i){function();}
+    auto endTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::nano> elapsed = endTime - startTime;
+    return elapsed.count()/N_ITERATIONS;
+}
+
+void report(const std::string &name, const double domTime,
+            const double streamingTime)
+{
+    std::cout << std::setw(14) << name << ": DOM "
+              << std::fixed << std::setprecision(1) << std::setw(8)
+              << domTime << " ns, streaming "
+              << std::setw(8) << streamingTime << " ns, speedup "
+              << std::setprecision(2) << domTime/streamingTime
+              << "x" << std::endl;
+}
+
+/// The DOM-based Status encoder
+std::string toDOMMessage(const Status &status)
+{
+    nlohmann::json obj;
+    obj["MessageType"] = status.getMessageType();
+    obj["MessageVersion"] = status.getMessageVersion();
+    obj["Module"] = status.getModule();
+    obj["HostName"] = status.getHostName();
+    obj["ModuleStatus"] = static_cast<int> (status.getModuleStatus());
+    obj["TimeStamp"] = status.getTimeStamp();
+    std::string message;
+    nlohmann::json::to_cbor(obj, message);
+    return message;
+}
+
+/// The DOM-based Status decoder
+void fromDOMMessage(const std::string &message, Status *status)
+{
+    auto obj = nlohmann::json::from_cbor(message);
+    if (obj["MessageType"] != status->getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    status->setModule(obj["Module"].get<std::string> ());
+    status->setHostName(obj["HostName"].get<std::string> ());
+    status->setModuleStatus(static_cast<ModuleStatus> (obj["ModuleStatus"]));
+    status->setTimeStamp(obj["TimeStamp"].get<std::string> ());
+}
+
+/// The DOM-based Text encoder
+std::string toDOMMessage(const Text &text)
+{
+    nlohmann::json obj;
+    obj["MessageType"] = text.getMessageType();
+    obj["MessageVersion"] = text.getMessageVersion();
+    obj["Contents"] = text.getContents();
+    std::string message;
+    nlohmann::json::to_cbor(obj, message);
+    return message;
+}
+
+/// The DOM-based Text decoder
+void fromDOMMessage(const std::string &message, Text *text)
+{
+    auto obj = nlohmann::json::from_cbor(message);
+    if (obj["MessageType"] != text->getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    text->setContents(obj["Contents"].get<std::string> ());
+}
+
+}
+
+int main()
+{
+    Status status;
+    status.setModule("benchmarkModule");
+    status.setHostName("localhost");
+    status.setModuleStatus(ModuleStatus::Alive);
+
+    Text text;
+    text.setContents("A short text message that is representative of a log");
+
+    if (toDOMMessage(status) != status.toMessage() ||
+        toDOMMessage(text) != text.toMessage())
+    {
+        std::cerr << "Streaming and DOM encodings differ" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Averages over " << N_ITERATIONS << " iterations"
+              << std::endl;
+
+    // Encode
+    std::string buffer;
+    auto domTime = timeIt([&]()
+                          {
+                              buffer = toDOMMessage(status);
+                          });
+    auto streamingTime = timeIt([&]()
+                                {
+                                    buffer.clear();
+                                    status.serializeInto(&buffer);
+                                });
+    report("Status encode", domTime, streamingTime);
+
+    domTime = timeIt([&]()
+                     {
+                         buffer = toDOMMessage(text);
+                     });
+    streamingTime = timeIt([&]()
+                           {
+                               buffer.clear();
+                               text.serializeInto(&buffer);
+                           });
+    report("Text encode", domTime, streamingTime);
+
+    // Decode
+    const auto statusMessage = status.toMessage();
+    Status statusCopy;
+    domTime = timeIt([&]()
+                     {
+                         fromDOMMessage(statusMessage, &statusCopy);
+                     });
+    streamingTime = timeIt([&]()
+                           {
+                               statusCopy.fromMessage(statusMessage);
+                           });
+    report("Status decode", domTime, streamingTime);
+
+    const auto textMessage = text.toMessage();
+    Text textCopy;
+    domTime = timeIt([&]()
+                     {
+                         fromDOMMessage(textMessage, &textCopy);
+                     });
+    streamingTime = timeIt([&]()
+                           {
+                               textCopy.fromMessage(textMessage);
+                           });
+    report("Text decode", domTime, streamingTime);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <umps/proxyServices/command/moduleDetails.hpp>
+#include "private/proxyServices/command/modulesMap.hpp"
+
+/// Measures the cost of resolving a module name and instance to the
+/// backend worker address in the command proxy's module table as the
+/// number of registered modules grows.  The indexed lookup is compared to
+/// a linear scan of the modules.
+
+using namespace UMPS::ProxyServices::Command;
+
+namespace
+{
+
+constexpr int N_LOOKUPS{200000};
+constexpr uint16_t N_INSTANCES{4};
+
+/// The linear scan that resolved a module prior to the index
+std::string linearScan(const ::ModulesMap &modulesMap,
+                       const std::string &moduleName,
+                       const uint16_t instance)
+{
+    std::scoped_lock lock(modulesMap.mMutex);
+    for (const auto &m : modulesMap.mModules)
+    {
+        if (m.second.mDetails.haveName())
+        {
+            if (moduleName == m.second.mDetails.getName() &&
+                instance == m.second.mDetails.getInstance())
+            {
+                return m.first;
+            }
+        }
+    }
+    return "";
+}
+
+/// Times the lookups and returns the number of nanoseconds per lookup
+double timeIt(const std::vector<std::pair<std::string, uint16_t>> &queries,
+              const std::function<std::string (const std::string &,
+                                                const uint16_t)> &lookup)
+{
+    size_t nFound{0};
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < N_LOOKUPS; ++i)
+    {
+        const auto &query = queries[i%queries.size()];
+        if (!lookup(query.first, query.second).empty()){nFound = nFound + 1;}
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    if (nFound != static_cast<size_t> (N_LOOKUPS))
+    {
+        std::cerr << "Only found " << nFound << " modules" << std::endl;
+    }
+    std::chrono::duration<double, std::nano> elapsed = endTime - startTime;
+    return elapsed.count()/N_LOOKUPS;
+}
+
+void run(const int nModules)
+{
+    const std::vector<std::chrono::milliseconds> pingIntervals{
+        std::chrono::milliseconds {1000}};
+    ::ModulesMap modulesMap;
+    std::vector<std::pair<std::string, uint16_t>> queries;
+    for (int i = 0; i < nModules; ++i)
+    {
+        ModuleDetails details;
+        details.setName("module" + std::to_string(i/N_INSTANCES));
+        details.setInstance(static_cast<uint16_t> (i%N_INSTANCES));
+        // ZeroMQ's routing identifiers are 5 bytes
+        std::string workerAddress{"\0\0\0\0\0", 5};
+        for (int j = 0; j < 4; ++j)
+        {
+            workerAddress[j + 1] = static_cast<char> ((i >> (8*j)) & 0xFF);
+        }
+        modulesMap.insert(std::pair{workerAddress,
+                                    ::Module(details, pingIntervals)});
+        queries.push_back(std::pair{details.getName(),
+                                    details.getInstance()});
+    }
+    std::mt19937 generator(86754309);
+    std::shuffle(queries.begin(), queries.end(), generator);
+
+    auto scanTime = timeIt(queries,
+                           [&](const std::string &name, const uint16_t instance)
+                           {
+                               return linearScan(modulesMap, name, instance);
+                           });
+    auto indexTime = timeIt(queries,
+                            [&](const std::string &name, const uint16_t instance)
+                            {
+                                return modulesMap.getAddress(name, instance);
+                            });
+    std::cout << std::setw(6) << nModules << " modules: linear scan "
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << scanTime << " ns, index " << std::setw(6) << indexTime
+              << " ns, speedup " << std::setprecision(1)
+              << scanTime/indexTime << "x" << std::endl;
+}
+
+}
+
+int main()
+{
+    std::cout << "Average time to resolve a module over " << N_LOOKUPS
+              << " lookups" << std::endl;
+    for (const auto nModules : {10, 100, 1000, 5000, 10000})
+    {
+        run(nModules);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <umps/messaging/publisherSubscriber/publisher.hpp>
+#include <umps/messaging/publisherSubscriber/publisherOptions.hpp>
+#include <umps/messaging/publisherSubscriber/subscriber.hpp>
+#include <umps/messaging/publisherSubscriber/subscriberOptions.hpp>
+#include <umps/messageFormats/messages.hpp>
+#include <umps/messageFormats/text.hpp>
+
+/// Compares publishing bursts of small messages one at a time with send()
+/// versus publishing the same bursts with sendBatch().
+
+using namespace UMPS::Messaging::PublisherSubscriber;
+
+namespace
+{
+
+const std::string publisherAddress{"tcp://127.0.0.1:5555"};
+constexpr int N_BURSTS{200};
+constexpr int BURST_SIZE{500};
+constexpr int HIGH_WATER_MARK{N_BURSTS*BURST_SIZE};
+
+/// Receives messages until the expected number arrive or the
+/// subscriber times out.
+void subscriber(const int nExpected, int *nReceived)
+{
+    UMPS::MessageFormats::Messages messageTypes;
+    std::unique_ptr<UMPS::MessageFormats::IMessage> textMessageType
+        = std::make_unique<UMPS::MessageFormats::Text> ();
+    messageTypes.add(textMessageType);
+
+    SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(publisherAddress);
+    subscriberOptions.setMessageTypes(messageTypes);
+    subscriberOptions.setReceiveHighWaterMark(HIGH_WATER_MARK);
+    subscriberOptions.setReceiveTimeOut(std::chrono::milliseconds {2000});
+
+    Subscriber subscriber;
+    subscriber.initialize(subscriberOptions);
+
+    UMPS::MessageFormats::Text textMessage;
+    *nReceived = 0;
+    while (*nReceived < nExpected)
+    {
+        if (!subscriber.receive(&textMessage)){break;}
+        *nReceived = *nReceived + 1;
+    }
+}
+
+/// Publishes the bursts with either send() or sendBatch() and returns
+/// the time spent putting messages on the wire.
+std::chrono::duration<double>
+    publish(const std::vector<UMPS::MessageFormats::Text> &messages,
+            const bool useBatch)
+{
+    PublisherOptions publisherOptions;
+    publisherOptions.setAddress(publisherAddress);
+    publisherOptions.setSendHighWaterMark(HIGH_WATER_MARK);
+
+    Publisher publisher;
+    publisher.initialize(publisherOptions);
+    // Wait a bit for the subscriber to connect
+    std::this_thread::sleep_for(std::chrono::milliseconds(750));
+
+    std::vector<const UMPS::MessageFormats::IMessage *> burst;
+    burst.reserve(messages.size());
+    for (const auto &message : messages){burst.push_back(&message);}
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int iBurst = 0; iBurst < N_BURSTS; ++iBurst)
+    {
+        if (useBatch)
+        {
+            publisher.sendBatch(burst);
+        }
+        else
+        {
+            for (const auto &message : messages){publisher.send(message);}
+        }
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return endTime - startTime;
+}
+
+void run(const std::vector<UMPS::MessageFormats::Text> &messages,
+         const bool useBatch)
+{
+    const int nExpected = N_BURSTS*static_cast<int> (messages.size());
+    int nReceived{0};
+    auto subscriberThread = std::thread(subscriber, nExpected, &nReceived);
+    auto elapsed = publish(messages, useBatch);
+    subscriberThread.join();
+    auto rate = static_cast<double> (nExpected)/elapsed.count();
+    std::cout << std::setw(10) << (useBatch ? "sendBatch" : "send")
+              << ": " << std::fixed << std::setprecision(4)
+              << elapsed.count() << " s, "
+              << std::setprecision(0) << rate << " messages/s, received "
+              << nReceived << "/" << nExpected << std::endl;
+}
+
+}
+
+int main()
+{
+    std::vector<UMPS::MessageFormats::Text> messages(BURST_SIZE);
+    for (int i = 0; i < BURST_SIZE; ++i)
+    {
+        messages[i].setContents("Message number " + std::to_string(i + 1));
+    }
+    std::cout << "Publishing " << N_BURSTS << " bursts of " << BURST_SIZE
+              << " messages" << std::endl;
+    constexpr bool useBatch{true};
+    run(messages, !useBatch);
+    run(messages,  useBatch);
+    return EXIT_SUCCESS;
+}
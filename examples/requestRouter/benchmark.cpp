@@ -0,0 +1,132 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <umps/messaging/requestRouter/router.hpp>
+#include <umps/messaging/requestRouter/routerOptions.hpp>
+#include <umps/messaging/requestRouter/request.hpp>
+#include <umps/messaging/requestRouter/requestOptions.hpp>
+#include <umps/messageFormats/text.hpp>
+
+/// Measures the throughput and latency of a request/router service whose
+/// callback is slow when the callback is run on the router's polling thread
+/// versus a pool of workers.
+
+using namespace UMPS::Messaging::RequestRouter;
+
+namespace
+{
+
+const std::string routerAddress{"tcp://127.0.0.1:5555"};
+constexpr int N_CLIENTS{8};
+constexpr int N_REQUESTS_PER_CLIENT{50};
+constexpr std::chrono::milliseconds CALLBACK_TIME{2};
+
+/// A synthetic slow callback that echoes the request
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    callback(const std::string &messageType, const void *data,
+             const size_t length)
+{
+    auto response = std::make_unique<UMPS::MessageFormats::Text> ();
+    if (messageType == response->getMessageType())
+    {
+        response->fromMessage(static_cast<const char *> (data), length);
+    }
+    std::this_thread::sleep_for(CALLBACK_TIME);
+    return response;
+}
+
+/// Makes requests and records the round-trip time of each
+void client(std::vector<double> *latencies)
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> textMessageType
+        = std::make_unique<UMPS::MessageFormats::Text> ();
+    RequestOptions requestOptions;
+    requestOptions.setAddress(routerAddress);
+    requestOptions.addMessageFormat(textMessageType);
+    requestOptions.setTimeOut(std::chrono::milliseconds {5000});
+    Request request;
+    request.initialize(requestOptions);
+
+    UMPS::MessageFormats::Text text;
+    text.setContents("Request");
+    latencies->reserve(N_REQUESTS_PER_CLIENT);
+    for (int i = 0; i < N_REQUESTS_PER_CLIENT; ++i)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        auto response = request.request(text);
+        auto endTime = std::chrono::steady_clock::now();
+        if (response == nullptr){break;}
+        std::chrono::duration<double, std::milli> elapsed
+            = endTime - startTime;
+        latencies->push_back(elapsed.count());
+    }
+}
+
+void run(const int nWorkers)
+{
+    RouterOptions routerOptions;
+    routerOptions.setAddress(routerAddress);
+    routerOptions.setCallback(&callback);
+    routerOptions.setNumberOfWorkers(nWorkers);
+    Router router;
+    router.initialize(routerOptions);
+    auto routerThread = std::thread(&Router::start, &router);
+
+    std::vector<std::vector<double>> latencies(N_CLIENTS);
+    std::vector<std::thread> clients;
+    auto startTime = std::chrono::steady_clock::now();
+    for (auto &clientLatencies : latencies)
+    {
+        clients.push_back(std::thread(client, &clientLatencies));
+    }
+    for (auto &clientThread : clients){clientThread.join();}
+    auto endTime = std::chrono::steady_clock::now();
+    router.stop();
+    routerThread.join();
+
+    std::vector<double> allLatencies;
+    for (const auto &clientLatencies : latencies)
+    {
+        allLatencies.insert(allLatencies.end(),
+                            clientLatencies.begin(), clientLatencies.end());
+    }
+    if (allLatencies.empty())
+    {
+        std::cerr << "No responses received" << std::endl;
+        return;
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+    auto nResponses = allLatencies.size();
+    auto mean = std::accumulate(allLatencies.begin(), allLatencies.end(), 0.0)
+               /static_cast<double> (nResponses);
+    auto p50 = allLatencies[nResponses/2];
+    auto p99 = allLatencies[std::min(nResponses - 1, (99*nResponses)/100)];
+    std::chrono::duration<double> elapsed = endTime - startTime;
+    std::cout << std::setw(2) << nWorkers << " worker(s): "
+              << std::fixed << std::setprecision(1)
+              << static_cast<double> (nResponses)/elapsed.count()
+              << " requests/s, latency mean " << mean
+              << " ms, median " << p50 << " ms, p99 " << p99
+              << " ms (" << nResponses << " responses)" << std::endl;
+}
+
+}
+
+int main()
+{
+    std::cout << N_CLIENTS << " clients each making "
+              << N_REQUESTS_PER_CLIENT << " requests to a callback that takes "
+              << CALLBACK_TIME.count() << " ms" << std::endl;
+    for (const auto nWorkers : {1, 2, 4, 8})
+    {
+        run(nWorkers);
+        // Let the port be released
+        std::this_thread::sleep_for(std::chrono::milliseconds {250});
+    }
+    return EXIT_SUCCESS;
+}
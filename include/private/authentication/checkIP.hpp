@@ -2,63 +2,253 @@
 #define PRIVATE_AUTHENTICATION_CHECKIP_HPP
 #include <set>
 #include <string>
-#include <cstring>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <arpa/inet.h>
 #include "private/isEmpty.hpp"
 namespace
 {
-/// @brief Checks if an IP address matches another IP address.
-[[maybe_unused]]
+/// @brief An IPv4 or IPv6 network prefix, e.g., 10.0.0.0/8.
+struct IPPrefix
+{
+    /// The address in network byte order.  IPv4 uses the first 4 bytes.
+    std::array<uint8_t, 16> bytes{};
+    /// The number of leading bits of the address that must match.
+    int length{0};
+    /// True indicates this is an IPv6 prefix.
+    bool isIPv6{false};
+};
+
+/// @brief Parses a decimal number in [0, maxValue].
 [[nodiscard]]
-bool ipMatches(const std::string &ip,
-               const std::string &targetIP)
+bool parseDecimal(const std::string_view string, const int maxValue,
+                  int *value) noexcept
 {
-    if (ip.empty()){return false;}
-    if (targetIP.empty()){return false;}
-    if (ip == targetIP){return true;} // Match
-    if (targetIP == "*.*.*.*"){return true;} // Full wild card
-    // More general wild card
-    auto found = targetIP.find_first_of('*');
-    if (found != std::string::npos && found > 0L)
+    if (string.empty() || string.size() > 3){return false;}
+    int result = 0;
+    for (const auto c : string)
     {
-        if (std::strncmp(targetIP.c_str(), ip.c_str(), found - 1) == 0)
-        {
-            return true;
-        }
+        if (c < '0' || c > '9'){return false;}
+        result = 10*result + (c - '0');
     }
-    return false;
+    if (result > maxValue){return false;}
+    *value = result;
+    return true;
 }
 
-/// @brief Checks if an IP address matches the list of IP addresses.
-///        This is slightly more complicated since we allow wildcards.
+/// @brief Parses an address (e.g., 10.1.2.3 or ::1), a CIDR block
+///        (e.g., 10.0.0.0/8 or fe80::/10), or an IPv4 wildcard
+///        (e.g., 10.* or 10.1.*.*) into a prefix.  IPv4-mapped IPv6
+///        addresses are treated as IPv4 addresses.
+/// @result True indicates the entry was parsed.
 [[maybe_unused]]
 [[nodiscard]]
-bool ipExists(const std::string &ip,
-              const std::set<std::string> &ipAddresses)
+bool parseIPPrefix(const std::string &entry, IPPrefix *prefix) noexcept
 {
-    // Most straightforward thing is IP is actually in list
-    if (ipAddresses.contains(ip)){return true;}
-    // Everything - no wild-carding
-    if (ipAddresses.contains("*.*.*.*")){return true;}
-    // Now we need to try a bit harder
-    for (const auto &address : ipAddresses)
+    if (entry.empty()){return false;}
+    IPPrefix result;
+    auto slash = entry.find('/');
+    // IPv4 wildcard - leading octets followed only by wildcards
+    if (entry.find('*') != std::string::npos)
     {
-        if (ipMatches(ip, address)){return true;};
+        if (slash != std::string::npos){return false;}
+        const std::string_view view{entry};
+        int nOctets = 0;
+        int nComponents = 0;
+        bool inWildcard = false;
+        size_t start = 0;
+        while (true)
+        {
+            auto end = view.find('.', start);
+            auto component = view.substr(start, end == std::string::npos ?
+                                                std::string_view::npos :
+                                                end - start);
+            nComponents = nComponents + 1;
+            if (nComponents > 4){return false;}
+            if (component == "*")
+            {
+                inWildcard = true;
+            }
+            else
+            {
+                int octet;
+                if (inWildcard || !parseDecimal(component, 255, &octet))
+                {
+                    return false;
+                }
+                result.bytes[nOctets] = static_cast<uint8_t> (octet);
+                nOctets = nOctets + 1;
+            }
+            if (end == std::string::npos){break;}
+            start = end + 1;
+        }
+        // Only the total wild card may omit the leading octets
+        if (nOctets == 0 && nComponents != 4){return false;}
+        result.length = 8*nOctets;
+        *prefix = result;
+        return true;
+    }
+    // Address or CIDR block
+    auto address = entry.substr(0, slash);
+    int maxLength = 32;
+    if (inet_pton(AF_INET, address.c_str(), result.bytes.data()) != 1)
+    {
+        if (inet_pton(AF_INET6, address.c_str(), result.bytes.data()) != 1)
+        {
+            return false;
+        }
+        result.isIPv6 = true;
+        maxLength = 128;
     }
-    return false;
+    result.length = maxLength;
+    if (slash != std::string::npos)
+    {
+        if (!parseDecimal(std::string_view {entry}.substr(slash + 1),
+                          maxLength, &result.length))
+        {
+            return false;
+        }
+    }
+    // ::ffff:a.b.c.d
+    if (result.isIPv6 && result.length >= 96 &&
+        std::all_of(result.bytes.begin(), result.bytes.begin() + 10,
+                    [](const uint8_t byte){return byte == 0;}) &&
+        result.bytes[10] == 0xff && result.bytes[11] == 0xff)
+    {
+        std::copy(result.bytes.begin() + 12, result.bytes.end(),
+                  result.bytes.begin());
+        std::fill(result.bytes.begin() + 4, result.bytes.end(), 0);
+        result.length = result.length - 96;
+        result.isIPv6 = false;
+    }
+    *prefix = result;
+    return true;
 }
-/// @brief Determines if I can parse the given IP address
+
+/// @brief A compiled binary prefix trie of IPv4 and IPv6 network prefixes.
+/// @details Each entry is parsed once when it is inserted.  Checking an
+///          address then walks at most one node per address bit (32 for
+///          IPv4 and 128 for IPv6) regardless of the number of entries.
+///          The nodes are stored contiguously and the trie is not modified
+///          after it is built so a built trie can be shared by many
+///          readers; to change the entries build a new trie and replace
+///          the old one.
+class IPAddressTrie
+{
+public:
+    /// @brief Constructs an empty trie.
+    IPAddressTrie()
+    {
+        mNodes.resize(2);
+    }
+    /// @brief Builds the trie from the given entries.
+    /// @throws std::invalid_argument if an entry cannot be parsed.
+    explicit IPAddressTrie(const std::set<std::string> &entries) :
+        IPAddressTrie()
+    {
+        for (const auto &entry : entries){insert(entry);}
+    }
+    /// @brief Adds an address, CIDR block, or IPv4 wildcard to the trie.
+    ///        The total wild card, *.*.*.*, matches every IPv4 and IPv6
+    ///        address.
+    /// @throws std::invalid_argument if the entry cannot be parsed.
+    void insert(const std::string &entry)
+    {
+        IPPrefix prefix;
+        if (!parseIPPrefix(entry, &prefix))
+        {
+            throw std::invalid_argument("Could not parse IP address: "
+                                      + entry);
+        }
+        insert(prefix);
+        if (entry == "*.*.*.*")
+        {
+            prefix.isIPv6 = true;
+            insert(prefix);
+        }
+        mSize = mSize + 1;
+    }
+    /// @result True indicates the address, or every address in the CIDR
+    ///         block or wildcard, is matched by an entry in the trie.
+    ///         Entries that cannot be parsed are never matched.
+    [[nodiscard]] bool contains(const std::string &addressOrPattern)
+        const noexcept
+    {
+        IPPrefix prefix;
+        if (!parseIPPrefix(addressOrPattern, &prefix)){return false;}
+        return contains(prefix);
+    }
+    /// @result True indicates every address in the prefix is matched by an
+    ///         entry in the trie.
+    [[nodiscard]] bool contains(const IPPrefix &prefix) const noexcept
+    {
+        int node = prefix.isIPv6 ? IPV6_ROOT : IPV4_ROOT;
+        for (int i = 0; ; ++i)
+        {
+            if (mNodes[node].terminal){return true;}
+            if (i == prefix.length){return false;}
+            node = mNodes[node].children[bit(prefix, i)];
+            if (node < 0){return false;}
+        }
+    }
+    /// @result The number of entries inserted into the trie.
+    [[nodiscard]] int size() const noexcept
+    {
+        return mSize;
+    }
+    /// @result True indicates the trie has no entries.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+private:
+    void insert(const IPPrefix &prefix)
+    {
+        int node = prefix.isIPv6 ? IPV6_ROOT : IPV4_ROOT;
+        for (int i = 0; i < prefix.length; ++i)
+        {
+            // A shorter prefix already covers this one
+            if (mNodes[node].terminal){return;}
+            auto b = bit(prefix, i);
+            if (mNodes[node].children[b] < 0)
+            {
+                mNodes[node].children[b] = static_cast<int> (mNodes.size());
+                mNodes.emplace_back();
+            }
+            node = mNodes[node].children[b];
+        }
+        // This prefix covers any longer prefixes so they can be dropped
+        mNodes[node].terminal = true;
+        mNodes[node].children = {-1, -1};
+    }
+    [[nodiscard]] static int bit(const IPPrefix &prefix, const int i) noexcept
+    {
+        return (prefix.bytes[i/8] >> (7 - i%8)) & 1;
+    }
+    struct Node
+    {
+        std::array<int, 2> children{-1, -1};
+        bool terminal{false};
+    };
+    static constexpr int IPV4_ROOT{0};
+    static constexpr int IPV6_ROOT{1};
+    std::vector<Node> mNodes;
+    int mSize{0};
+};
+
+/// @brief Determines if I can parse the given IP address.  This accepts
+///        exactly what \c parseIPPrefix() and the trie accept.
 [[maybe_unused]]
 [[nodiscard]]
 bool isOkayIP(const std::string &ip)
 {
-    // String is empty - no
     if (isEmpty(ip)){return false;}
-    if (ip.size() == 0){return false;} // Double check on empty
-    if (ip == "*.*.*.*"){return true;} // Total wild card is okay
-    if (ip[0] == '*'){return false;} // First character wildcard is bad
-    // Can only handle one wildcard
-    if (std::count(ip.begin(), ip.end(), '*') > 1){return false;}
-    return true;
+    IPPrefix prefix;
+    return parseIPPrefix(ip, &prefix);
 }
 }
 #endif
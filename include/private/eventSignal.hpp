@@ -0,0 +1,82 @@
+#ifndef UMPS_PRIVATE_EVENT_SIGNAL_HPP
+#define UMPS_PRIVATE_EVENT_SIGNAL_HPP
+#ifdef UMPS_SRC
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+namespace
+{
+/// @brief A wake up signal between threads that is backed by an eventfd.
+/// @details Any thread may call \c signal().  The waiting thread either
+///          blocks in \c wait() or adds \c getFileDescriptor() to a poll
+///          set, e.g., as the file descriptor of a zmq::pollitem_t, and
+///          calls \c clear() once the descriptor is readable.  Signals
+///          that arrive before the waiter waits are not lost.
+class EventSignal
+{
+public:
+    /// @brief Constructor.
+    /// @throws std::runtime_error if the eventfd could not be created.
+    EventSignal()
+    {
+        mFileDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (mFileDescriptor < 0)
+        {
+            throw std::runtime_error("Failed to create eventfd: "
+                                   + std::string {std::strerror(errno)});
+        }
+    }
+    /// @brief Wakes the waiting thread.
+    void signal() noexcept
+    {
+        uint64_t one{1};
+        [[maybe_unused]] auto nWritten
+            = ::write(mFileDescriptor, &one, sizeof(one));
+    }
+    /// @brief Resets the signal.
+    void clear() noexcept
+    {
+        uint64_t count;
+        [[maybe_unused]] auto nRead
+            = ::read(mFileDescriptor, &count, sizeof(count));
+    }
+    /// @brief Waits for the signal then resets it.
+    /// @param[in] waitFor  The maximum amount of time to wait.
+    /// @result True indicates the signal was received.
+    bool wait(const std::chrono::milliseconds &waitFor) noexcept
+    {
+        pollfd item{mFileDescriptor, POLLIN, 0};
+        auto timeOut = static_cast<int> (std::max<int64_t> (0, waitFor.count()));
+        if (::poll(&item, 1, timeOut) > 0)
+        {
+            clear();
+            return true;
+        }
+        return false;
+    }
+    /// @result The file descriptor that is readable while signaled.
+    [[nodiscard]] int getFileDescriptor() const noexcept
+    {
+        return mFileDescriptor;
+    }
+    /// @brief Destructor.
+    ~EventSignal()
+    {
+        if (mFileDescriptor >= 0){::close(mFileDescriptor);}
+    }
+
+    EventSignal(const EventSignal &) = delete;
+    EventSignal& operator=(const EventSignal &) = delete;
+private:
+    int mFileDescriptor{-1};
+};
+}
+#endif
+#endif
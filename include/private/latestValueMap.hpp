@@ -0,0 +1,106 @@
+#ifndef UMPS_PRIVATE_LATEST_VALUE_MAP_HPP
+#define UMPS_PRIVATE_LATEST_VALUE_MAP_HPP
+#ifdef UMPS_SRC
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include "private/eventSignal.hpp"
+namespace
+{
+/// @brief Holds only the most recent value for each key until the consumer
+///        takes it.  This is useful when the consumer only cares about the
+///        latest state, e.g., a module's status, and producers may outpace
+///        it.  Setting a value that has not yet been taken replaces it so
+///        the memory is bounded by the number of distinct keys.
+/// @details There may be many producers but only one consumer.  The
+///          consumer can block in \c wait_until_and_take() or add
+///          \c getFileDescriptor() to a poll set.
+/// @tparam Key  The key type, e.g., the module name.
+/// @tparam T    The value type.
+template<typename Key, typename T>
+class LatestValueMap
+{
+public:
+    /// @brief Sets the latest value for the key.
+    /// @param[in] key    The key.
+    /// @param[in,out] value  The value.  On exit, value's behavior is
+    ///                       undefined.
+    /// @result True indicates this replaced a value that was never taken.
+    bool set(const Key &key, T &&value)
+    {
+        bool replaced{false};
+        {
+            std::scoped_lock lock(mMutex);
+            auto [idx, inserted]
+                = mValues.insert_or_assign(key, std::move(value));
+            replaced = !inserted;
+        }
+        if (!replaced){mSignal.signal();}
+        return replaced;
+    }
+    /// @brief Moves the latest values to the given vector and empties the map.
+    /// @param[out] values  The latest values.  Any existing values are
+    ///                     cleared.
+    /// @result True indicates at least one value was taken.
+    bool take(std::vector<T> *values)
+    {
+        values->clear();
+        std::scoped_lock lock(mMutex);
+        values->reserve(mValues.size());
+        for (auto &value : mValues)
+        {
+            values->push_back(std::move(value.second));
+        }
+        mValues.clear();
+        return !values->empty();
+    }
+    /// @brief Takes the latest values.  If there are none then this waits
+    ///        for a value to be set or \c notify() to be called.
+    /// @param[out] values  The latest values.
+    /// @param[in] waitFor  The maximum amount of time to wait.
+    /// @result True indicates at least one value was taken.
+    bool wait_until_and_take(std::vector<T> *values,
+                             const std::chrono::milliseconds &waitFor)
+    {
+        if (take(values)){return true;}
+        mSignal.wait(waitFor);
+        return take(values);
+    }
+    /// @brief Wakes the consumer without setting a value, e.g., so that
+    ///        it notices the program is stopping.
+    void notify() noexcept
+    {
+        mSignal.signal();
+    }
+    /// @result The file descriptor that becomes readable when a value is
+    ///         set.  The consumer should call \c clearSignal() before
+    ///         taking the values.
+    [[nodiscard]] int getFileDescriptor() const noexcept
+    {
+        return mSignal.getFileDescriptor();
+    }
+    /// @brief Resets the signal.
+    void clearSignal() noexcept
+    {
+        mSignal.clear();
+    }
+    /// @result The number of values waiting to be taken.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        return mValues.size();
+    }
+    /// @result True indicates there are no values waiting to be taken.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+private:
+    mutable std::mutex mMutex;
+    std::map<Key, T> mValues;
+    EventSignal mSignal;
+};
+}
+#endif
+#endif
@@ -0,0 +1,373 @@
+#ifndef PRIVATE_MESSAGEFORMATS_CBOR_HPP
+#define PRIVATE_MESSAGEFORMATS_CBOR_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <limits>
+#include <cstdint>
+namespace
+{
+/// @brief A streaming CBOR (RFC 8949) writer for fixed-schema messages.
+/// @details Fields are appended directly to the output buffer without
+///          building an intermediate JSON tree.  Every header is written
+///          with the smallest possible width which is what
+///          nlohmann::json::to_cbor does.  Hence, provided the caller writes
+///          the map keys in lexicographic order (the iteration order of
+///          nlohmann::json objects), the resulting bytes are identical to
+///          those produced by nlohmann::json::to_cbor.
+class CBORWriter
+{
+public:
+    /// @brief Constructor.
+    /// @param[in,out] buffer  The buffer to which the CBOR is appended.
+    explicit CBORWriter(std::string *buffer) :
+        mBuffer(buffer)
+    {
+        if (mBuffer == nullptr)
+        {
+            throw std::invalid_argument("Buffer is NULL");
+        }
+    }
+    /// @brief Writes the header for a map with the given number of
+    ///        key/value pairs.
+    void writeMapHeader(const uint64_t nPairs)
+    {
+        writeHeader(MAP, nPairs);
+    }
+    /// @brief Writes a UTF-8 text string.
+    void writeString(const std::string_view string)
+    {
+        writeHeader(TEXT_STRING, string.size());
+        mBuffer->append(string.data(), string.size());
+    }
+    /// @brief Writes a signed integer.
+    void writeInteger(const int64_t value)
+    {
+        if (value >= 0)
+        {
+            writeHeader(POSITIVE_INTEGER, static_cast<uint64_t> (value));
+        }
+        else
+        {
+            // CBOR encodes a negative integer n as -1 - n
+            writeHeader(NEGATIVE_INTEGER,
+                        static_cast<uint64_t> (-(value + 1)));
+        }
+    }
+    /// @brief Convenience function to write a key and a string value.
+    void write(const std::string_view key, const std::string_view value)
+    {
+        writeString(key);
+        writeString(value);
+    }
+    /// @brief Convenience function to write a key and an integer value.
+    void write(const std::string_view key, const int64_t value)
+    {
+        writeString(key);
+        writeInteger(value);
+    }
+    /// @brief Convenience function to write a key and an integer value.
+    void write(const std::string_view key, const int value)
+    {
+        write(key, static_cast<int64_t> (value));
+    }
+private:
+    void writeHeader(const uint8_t majorType, const uint64_t value)
+    {
+        const auto type = static_cast<uint8_t> (majorType << 5);
+        if (value <= 23)
+        {
+            mBuffer->push_back(static_cast<char> (type | value));
+        }
+        else if (value <= std::numeric_limits<uint8_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (type | 24));
+            writeBigEndian(value, 1);
+        }
+        else if (value <= std::numeric_limits<uint16_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (type | 25));
+            writeBigEndian(value, 2);
+        }
+        else if (value <= std::numeric_limits<uint32_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (type | 26));
+            writeBigEndian(value, 4);
+        }
+        else
+        {
+            mBuffer->push_back(static_cast<char> (type | 27));
+            writeBigEndian(value, 8);
+        }
+    }
+    void writeBigEndian(const uint64_t value, const int nBytes)
+    {
+        for (int i = nBytes - 1; i >= 0; --i)
+        {
+            mBuffer->push_back(static_cast<char> ((value >> (8*i)) & 0xFF));
+        }
+    }
+    static constexpr uint8_t POSITIVE_INTEGER{0};
+    static constexpr uint8_t NEGATIVE_INTEGER{1};
+    static constexpr uint8_t TEXT_STRING{3};
+    static constexpr uint8_t MAP{5};
+    std::string *mBuffer{nullptr};
+};
+
+/// @brief A streaming CBOR reader for fixed-schema messages.
+/// @details This parses fields directly from the buffer without building an
+///          intermediate JSON tree.  Only definite-length items are
+///          supported which is sufficient for anything created by
+///          nlohmann::json::to_cbor or the CBORWriter.  Strings are returned
+///          as views into the input buffer so the buffer must outlive them.
+class CBORReader
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] data    The CBOR message.  This is an array whose
+    ///                    dimension is [length].
+    /// @param[in] length  The length of the message in bytes.
+    CBORReader(const uint8_t *data, const size_t length) :
+        mData(data),
+        mLength(length)
+    {
+        if (mData == nullptr && mLength > 0)
+        {
+            throw std::invalid_argument("Data is NULL");
+        }
+    }
+    /// @result The number of key/value pairs in the map that follows.
+    /// @throws std::invalid_argument if the next item is not a map.
+    [[nodiscard]] uint64_t readMapHeader()
+    {
+        return readHeader(MAP, "map");
+    }
+    /// @result A view of the next text string.
+    /// @throws std::invalid_argument if the next item is not a text string.
+    [[nodiscard]] std::string_view readString()
+    {
+        auto length = readHeader(TEXT_STRING, "text string");
+        require(length);
+        std::string_view result{reinterpret_cast<const char *>
+                                (mData + mOffset), length};
+        mOffset = mOffset + length;
+        return result;
+    }
+    /// @result The next signed integer.
+    /// @throws std::invalid_argument if the next item is not an integer
+    ///         or it cannot be represented as an int64_t.
+    [[nodiscard]] int64_t readInteger()
+    {
+        require(1);
+        const auto majorType = static_cast<uint8_t> (mData[mOffset] >> 5);
+        if (majorType == POSITIVE_INTEGER)
+        {
+            auto value = readHeader(POSITIVE_INTEGER, "integer");
+            if (value > static_cast<uint64_t>
+                        (std::numeric_limits<int64_t>::max()))
+            {
+                throw std::invalid_argument("Integer overflows int64_t");
+            }
+            return static_cast<int64_t> (value);
+        }
+        if (majorType == NEGATIVE_INTEGER)
+        {
+            auto value = readHeader(NEGATIVE_INTEGER, "integer");
+            if (value > static_cast<uint64_t>
+                        (std::numeric_limits<int64_t>::max()))
+            {
+                throw std::invalid_argument("Integer overflows int64_t");
+            }
+            return -1 - static_cast<int64_t> (value);
+        }
+        throw std::invalid_argument("CBOR item is not an integer");
+    }
+    /// @brief Consumes the next item if it is null.
+    /// @result True indicates the next item was null.
+    [[nodiscard]] bool readNull()
+    {
+        require(1);
+        if (mData[mOffset] != NULL_VALUE){return false;}
+        mOffset = mOffset + 1;
+        return true;
+    }
+    /// @brief Skips the next item.  This is useful for ignoring unknown
+    ///        keys.
+    /// @param[in] depth  The current nesting depth.  Deeply nested items
+    ///                   are rejected so a malicious message cannot
+    ///                   exhaust the stack.
+    void skip(const int depth = 0)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            throw std::invalid_argument("CBOR item is too deeply nested");
+        }
+        require(1);
+        const auto majorType = static_cast<uint8_t> (mData[mOffset] >> 5);
+        const auto additional = static_cast<uint8_t> (mData[mOffset] & 0x1F);
+        if (majorType == SIMPLE_OR_FLOAT)
+        {
+            mOffset = mOffset + 1;
+            if (additional == 24){require(1); mOffset = mOffset + 1;}
+            else if (additional == 25){require(2); mOffset = mOffset + 2;}
+            else if (additional == 26){require(4); mOffset = mOffset + 4;}
+            else if (additional == 27){require(8); mOffset = mOffset + 8;}
+            else if (additional > 27)
+            {
+                throw std::invalid_argument("Unsupported CBOR simple value");
+            }
+            return;
+        }
+        auto value = readHeader(majorType, "item");
+        if (majorType == BYTE_STRING || majorType == TEXT_STRING)
+        {
+            require(value);
+            mOffset = mOffset + value;
+        }
+        else if (majorType == ARRAY)
+        {
+            for (uint64_t i = 0; i < value; ++i){skip(depth + 1);}
+        }
+        else if (majorType == MAP)
+        {
+            for (uint64_t i = 0; i < 2*value; ++i){skip(depth + 1);}
+        }
+        else if (majorType == TAG)
+        {
+            skip(depth + 1);
+        }
+    }
+    /// @result True indicates the entire buffer has been consumed.
+    [[nodiscard]] bool atEnd() const noexcept
+    {
+        return mOffset >= mLength;
+    }
+private:
+    uint64_t readHeader(const uint8_t expectedType, const char *name)
+    {
+        require(1);
+        const auto majorType = static_cast<uint8_t> (mData[mOffset] >> 5);
+        const auto additional = static_cast<uint8_t> (mData[mOffset] & 0x1F);
+        if (majorType != expectedType)
+        {
+            throw std::invalid_argument(std::string {"CBOR item is not a "}
+                                      + name);
+        }
+        mOffset = mOffset + 1;
+        if (additional <= 23){return additional;}
+        int nBytes{0};
+        if (additional == 24)
+        {
+            nBytes = 1;
+        }
+        else if (additional == 25)
+        {
+            nBytes = 2;
+        }
+        else if (additional == 26)
+        {
+            nBytes = 4;
+        }
+        else if (additional == 27)
+        {
+            nBytes = 8;
+        }
+        else
+        {
+            throw std::invalid_argument(
+                "Indefinite length CBOR items are not supported");
+        }
+        require(nBytes);
+        uint64_t value{0};
+        for (int i = 0; i < nBytes; ++i)
+        {
+            value = (value << 8) | mData[mOffset + i];
+        }
+        mOffset = mOffset + nBytes;
+        return value;
+    }
+    void require(const uint64_t nBytes) const
+    {
+        if (nBytes > mLength - mOffset)
+        {
+            throw std::invalid_argument("Unexpected end of CBOR message");
+        }
+    }
+    static constexpr uint8_t POSITIVE_INTEGER{0};
+    static constexpr uint8_t NEGATIVE_INTEGER{1};
+    static constexpr uint8_t BYTE_STRING{2};
+    static constexpr uint8_t TEXT_STRING{3};
+    static constexpr uint8_t ARRAY{4};
+    static constexpr uint8_t MAP{5};
+    static constexpr uint8_t TAG{6};
+    static constexpr uint8_t SIMPLE_OR_FLOAT{7};
+    static constexpr uint8_t NULL_VALUE{0xF6};
+    static constexpr int MAX_DEPTH{64};
+    const uint8_t *mData{nullptr};
+    size_t mLength{0};
+    size_t mOffset{0};
+};
+
+/// @brief Reads the map of a fixed-schema message.  This checks the
+///        message type, skips unknown keys, and rejects trailing bytes so
+///        that each message only has to read its own fields.
+/// @param[in] data         The CBOR message.  This is an array whose
+///                         dimension is [length].
+/// @param[in] length       The length of the message in bytes.
+/// @param[in] messageType  The expected value of the MessageType key.
+/// @param[in] readField    Called as readField(key, reader) for every key
+///                         other than MessageType with the reader
+///                         positioned at the key's value.  This returns
+///                         false when it does not read the value in which
+///                         case the value is skipped.
+/// @throws std::invalid_argument if the message is malformed, the message
+///         type differs from messageType, or the message type is not set.
+template<typename ReadField>
+void readCBORMessage(const uint8_t *data, const size_t length,
+                     const std::string_view messageType,
+                     ReadField &&readField)
+{
+    CBORReader reader(data, length);
+    bool haveMessageType{false};
+    auto nPairs = reader.readMapHeader();
+    for (uint64_t i = 0; i < nPairs; ++i)
+    {
+        auto key = reader.readString();
+        if (key == "MessageType")
+        {
+            if (reader.readString() != messageType)
+            {
+                throw std::invalid_argument("Message has invalid message type");
+            }
+            haveMessageType = true;
+        }
+        else if (!readField(key, reader))
+        {
+            reader.skip();
+        }
+    }
+    if (!reader.atEnd())
+    {
+        throw std::invalid_argument("Trailing bytes in message");
+    }
+    if (!haveMessageType){throw std::invalid_argument("Message type not set");}
+}
+
+/// @brief Reads the map of a message that has no fields other than its
+///        message type.
+/// @throws std::invalid_argument if the message is malformed or the message
+///         type is not messageType.
+[[maybe_unused]]
+void readCBORMessage(const uint8_t *data, const size_t length,
+                     const std::string_view messageType)
+{
+    readCBORMessage(data, length, messageType,
+                    [](const std::string_view, CBORReader &)
+                    {
+                        return false;
+                    });
+}
+}
+#endif
+#endif
@@ -0,0 +1,207 @@
+#ifndef PRIVATE_MESSAGEFORMATS_MESSAGE_TYPE_REGISTRY_HPP
+#define PRIVATE_MESSAGEFORMATS_MESSAGE_TYPE_REGISTRY_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <typeinfo>
+#include <stdexcept>
+#include "umps/messageFormats/messages.hpp"
+#include "umps/messageFormats/message.hpp"
+namespace
+{
+/// @brief An immutable, hash-indexed lookup table of message types.
+/// @details This is built once from a Messages container when a socket is
+///          initialized.  Each message type is assigned an integer
+///          identifier in [0, size()).  A received topic is resolved to its
+///          identifier by hashing the topic bytes directly and probing an
+///          open-addressing table so that, unlike Messages, no strings are
+///          created or compared lexicographically on the receive path.
+class MessageTypeRegistry
+{
+public:
+    /// @brief Constructs an empty registry.
+    MessageTypeRegistry() = default;
+    /// @brief Builds the registry from the given message formats.
+    explicit MessageTypeRegistry(
+        const UMPS::MessageFormats::Messages &messageFormats)
+    {
+        auto messages = messageFormats.get();
+        mEntries.reserve(messages.size());
+        for (auto &message : messages)
+        {
+            Entry entry;
+            entry.messageType = message.first;
+            entry.hash = hash(message.first);
+            const auto &prototype = *message.second;
+            entry.typeInfo = &typeid(prototype);
+            entry.prototype = std::move(message.second);
+            mEntries.push_back(std::move(entry));
+        }
+        // Keep the load factor at or below 1/2 so probe sequences are short
+        size_t nSlots = 1;
+        while (nSlots < 2*mEntries.size()){nSlots = 2*nSlots;}
+        mSlots.assign(nSlots, -1);
+        mMask = nSlots - 1;
+        for (auto &entry : mEntries)
+        {
+            for (const auto &other : mEntries)
+            {
+                if (&entry != &other && *entry.typeInfo == *other.typeInfo)
+                {
+                    entry.uniqueTypeInfo = false;
+                }
+            }
+        }
+        for (int id = 0; id < static_cast<int> (mEntries.size()); ++id)
+        {
+            auto slot = mEntries[id].hash & mMask;
+            while (mSlots[slot] != -1){slot = (slot + 1) & mMask;}
+            mSlots[slot] = id;
+        }
+    }
+    /// @result The identifier of the message type or -1 if the message
+    ///         type is not in the registry.
+    [[nodiscard]] int find(const std::string_view messageType) const noexcept
+    {
+        if (mEntries.empty()){return -1;}
+        const auto messageHash = hash(messageType);
+        auto slot = messageHash & mMask;
+        while (mSlots[slot] != -1)
+        {
+            const auto &entry = mEntries[mSlots[slot]];
+            if (entry.hash == messageHash && entry.messageType == messageType)
+            {
+                return mSlots[slot];
+            }
+            slot = (slot + 1) & mMask;
+        }
+        return -1;
+    }
+    /// @result The identifier of the message's type or -1 if the message
+    ///         type is not in the registry.
+    /// @note This matches on the message's dynamic type so the message type
+    ///       string is only created when several registered message types
+    ///       share a class.
+    [[nodiscard]] int find(const UMPS::MessageFormats::IMessage &message)
+        const noexcept
+    {
+        const auto &typeInfo = typeid(message);
+        for (int id = 0; id < static_cast<int> (mEntries.size()); ++id)
+        {
+            if (*mEntries[id].typeInfo == typeInfo)
+            {
+                if (mEntries[id].uniqueTypeInfo){return id;}
+                return find(message.getMessageType());
+            }
+        }
+        return -1;
+    }
+    /// @result True indicates the message type is in the registry.
+    [[nodiscard]] bool contains(const std::string_view messageType)
+        const noexcept
+    {
+        return find(messageType) >= 0;
+    }
+    /// @result The message type corresponding to the identifier.
+    [[nodiscard]] const std::string &getMessageType(const int id) const
+    {
+        return mEntries.at(id).messageType;
+    }
+    /// @result A new instance of the message type with the given identifier.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createInstance(const int id) const
+    {
+        return mEntries.at(id).prototype->createInstance();
+    }
+    /// @result The number of message types in the registry.
+    [[nodiscard]] int size() const noexcept
+    {
+        return static_cast<int> (mEntries.size());
+    }
+    /// @result True indicates the registry is empty.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mEntries.empty();
+    }
+private:
+    /// FNV-1a
+    [[nodiscard]] static uint64_t hash(const std::string_view bytes) noexcept
+    {
+        uint64_t result{14695981039346656037ULL};
+        for (const auto c : bytes)
+        {
+            result = result^static_cast<uint8_t> (c);
+            result = result*1099511628211ULL;
+        }
+        return result;
+    }
+    struct Entry
+    {
+        std::string messageType;
+        uint64_t hash{0};
+        const std::type_info *typeInfo{nullptr};
+        bool uniqueTypeInfo{true};
+        std::unique_ptr<UMPS::MessageFormats::IMessage> prototype{nullptr};
+    };
+    std::vector<Entry> mEntries;
+    std::vector<int> mSlots;
+    uint64_t mMask{0};
+};
+
+/// @brief A pool of reusable message instances indexed by the identifiers
+///        of a MessageTypeRegistry.
+/// @details Messages handed back with release() are reused by the next
+///          acquire() of the same type instead of allocating a new
+///          instance.  The pool is not thread safe.  It is intended to be
+///          owned by a socket and, since a ZeroMQ socket may only be used
+///          by one thread at a time, this makes it a per-thread pool.
+class MessagePool
+{
+public:
+    /// @brief Clears the pool and sizes it for the given registry.
+    void reset(const MessageTypeRegistry &registry)
+    {
+        mRegistry = &registry;
+        mInstances.clear();
+        mInstances.resize(registry.size());
+    }
+    /// @result A pooled instance of the message type or, if the pool is
+    ///         exhausted, a new instance.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        acquire(const int id)
+    {
+        if (mRegistry == nullptr)
+        {
+            throw std::runtime_error("Message pool not initialized");
+        }
+        auto &instances = mInstances.at(id);
+        if (instances.empty()){return mRegistry->createInstance(id);}
+        auto result = std::move(instances.back());
+        instances.pop_back();
+        return result;
+    }
+    /// @brief Returns a message to the pool so that it can be reused.
+    ///        Messages whose type is not in the registry and messages in
+    ///        excess of the pool's capacity are simply released.
+    void release(std::unique_ptr<UMPS::MessageFormats::IMessage> message)
+    {
+        if (message == nullptr || mRegistry == nullptr){return;}
+        auto id = mRegistry->find(*message);
+        if (id < 0){return;}
+        auto &instances = mInstances[id];
+        if (instances.size() < MAX_INSTANCES_PER_TYPE)
+        {
+            instances.push_back(std::move(message));
+        }
+    }
+private:
+    static constexpr size_t MAX_INSTANCES_PER_TYPE{16};
+    const MessageTypeRegistry *mRegistry{nullptr};
+    std::vector<std::vector<std::unique_ptr<UMPS::MessageFormats::IMessage>>>
+        mInstances;
+};
+}
+#endif
+#endif
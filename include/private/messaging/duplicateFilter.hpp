@@ -0,0 +1,101 @@
+#ifndef PRIVATE_MESSAGING_DUPLICATE_FILTER_HPP
+#define PRIVATE_MESSAGING_DUPLICATE_FILTER_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <bitset>
+#include <cstdint>
+#include "private/messaging/sequenceStamp.hpp"
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Drops messages that a proxy has already forwarded.  In a network
+///        of proxies a message can arrive more than once when there are
+///        multiple paths from its origin or a loop.
+/// @details For each origin and topic this remembers the highest sequence
+///          number and which of the WINDOW_SIZE preceding sequence numbers
+///          were seen.  This is the anti-replay window of IPsec.  A message
+///          older than the window is dropped since it can't be distinguished
+///          from a repeat.
+class DuplicateFilter
+{
+public:
+    static constexpr uint64_t WINDOW_SIZE{1024};
+    /// Streams beyond this many evict the stream heard from least recently
+    /// so a misbehaving network can't grow the table without bound.
+    static constexpr size_t MAX_STREAMS{4096};
+    /// @param[in] topic  The message's topic.
+    /// @param[in] stamp  The message's stamp.
+    /// @result True indicates the message is new and should be forwarded.
+    [[nodiscard]] bool accept(const std::string_view topic,
+                              const SequenceStamp &stamp)
+    {
+        mClock = mClock + 1;
+        ::makeStreamKey(topic, stamp.origin, &mKey);
+        auto idx = mWindows.find(std::string_view {mKey});
+        if (idx == mWindows.end())
+        {
+            if (mWindows.size() >= MAX_STREAMS){evictOldestStream();}
+            Window window;
+            window.highest = stamp.sequence;
+            window.seen.set(0);
+            window.lastUsed = mClock;
+            mWindows.emplace(mKey, window);
+            return true;
+        }
+        auto &window = idx->second;
+        window.lastUsed = mClock;
+        if (stamp.sequence > window.highest)
+        {
+            auto shift = stamp.sequence - window.highest;
+            if (shift >= WINDOW_SIZE)
+            {
+                window.seen.reset();
+            }
+            else
+            {
+                window.seen <<= static_cast<size_t> (shift);
+            }
+            window.seen.set(0);
+            window.highest = stamp.sequence;
+            return true;
+        }
+        auto age = window.highest - stamp.sequence;
+        if (age >= WINDOW_SIZE){return false;}
+        if (window.seen.test(static_cast<size_t> (age))){return false;}
+        window.seen.set(static_cast<size_t> (age));
+        return true;
+    }
+    /// @result The number of origin and topic pairs being tracked.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mWindows.size();
+    }
+private:
+    struct Window
+    {
+        // Bit i indicates highest - i was seen
+        std::bitset<WINDOW_SIZE> seen;
+        uint64_t highest{0};
+        uint64_t lastUsed{0};
+    };
+    /// New streams are rare so a linear search is fine
+    void evictOldestStream()
+    {
+        auto oldest = mWindows.begin();
+        for (auto idx = mWindows.begin(); idx != mWindows.end(); ++idx)
+        {
+            if (idx->second.lastUsed < oldest->second.lastUsed){oldest = idx;}
+        }
+        if (oldest != mWindows.end()){mWindows.erase(oldest);}
+    }
+    std::unordered_map<std::string, Window,
+                       TransparentStringHash, std::equal_to<>> mWindows;
+    std::string mKey;
+    uint64_t mClock{0};
+};
+}
+#endif
+#endif
@@ -0,0 +1,123 @@
+#ifndef PRIVATE_MESSAGING_GAP_DETECTOR_HPP
+#define PRIVATE_MESSAGING_GAP_DETECTOR_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include "private/messaging/sequenceStamp.hpp"
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Counts the messages a subscriber missed, e.g., because a
+///        high water mark was hit, from the sequence stamps of the messages
+///        it did receive.
+/// @details Each publisher numbers the messages on each topic so a gap in
+///          the numbers of a publisher's topic is the number of messages
+///          that were dropped.  Only the receiving thread updates this.
+///          The totals may be read from any thread.
+class GapDetector
+{
+public:
+    using Callback = std::function<void (uint64_t, std::string_view,
+                                         uint64_t)>;
+    /// Streams beyond this many evict the stream heard from least recently
+    /// so restarted publishers can't grow the table without bound.
+    static constexpr size_t MAX_STREAMS{4096};
+    /// @brief Sets a function that is called with the publisher, the topic,
+    ///        and the number of missed messages when a gap is detected.
+    void setCallback(Callback callback)
+    {
+        mCallback = std::move(callback);
+    }
+    /// @brief Checks a received message for a gap.
+    /// @param[in] topic  The message's topic.
+    /// @param[in] stamp  The message's stamp.
+    /// @result The number of messages on this topic from this publisher that
+    ///         were missed immediately before this message.
+    uint64_t update(const std::string_view topic, const SequenceStamp &stamp)
+    {
+        mClock = mClock + 1;
+        mSequencedMessages.fetch_add(1, std::memory_order_relaxed);
+        ::makeStreamKey(topic, stamp.origin, &mKey);
+        auto idx = mStreams.find(std::string_view {mKey});
+        if (idx == mStreams.end())
+        {
+            // Whatever was sent before we subscribed isn't a gap
+            if (mStreams.size() >= MAX_STREAMS){evictOldestStream();}
+            mStreams.emplace(mKey, Stream {stamp.sequence, mClock});
+            return 0;
+        }
+        auto &stream = idx->second;
+        stream.lastUsed = mClock;
+        // A late or repeated message doesn't fill a gap that was reported
+        if (stamp.sequence <= stream.highest){return 0;}
+        auto nMissed = stamp.sequence - stream.highest - 1;
+        stream.highest = stamp.sequence;
+        if (nMissed > 0)
+        {
+            mGaps.fetch_add(1, std::memory_order_relaxed);
+            mMissedMessages.fetch_add(nMissed, std::memory_order_relaxed);
+            if (mCallback){mCallback(stamp.origin, topic, nMissed);}
+        }
+        return nMissed;
+    }
+    /// @result The number of received messages that had a stamp.
+    [[nodiscard]] uint64_t getNumberOfSequencedMessages() const noexcept
+    {
+        return mSequencedMessages.load(std::memory_order_relaxed);
+    }
+    /// @result The number of messages that were missed.
+    [[nodiscard]] uint64_t getNumberOfMissedMessages() const noexcept
+    {
+        return mMissedMessages.load(std::memory_order_relaxed);
+    }
+    /// @result The number of gaps.  A gap may span many messages.
+    [[nodiscard]] uint64_t getNumberOfGaps() const noexcept
+    {
+        return mGaps.load(std::memory_order_relaxed);
+    }
+    /// @result The number of publisher and topic pairs being tracked.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mStreams.size();
+    }
+    /// @brief Forgets the streams and resets the counters.  The callback
+    ///        is retained.
+    void clear() noexcept
+    {
+        mStreams.clear();
+        mSequencedMessages.store(0, std::memory_order_relaxed);
+        mMissedMessages.store(0, std::memory_order_relaxed);
+        mGaps.store(0, std::memory_order_relaxed);
+    }
+private:
+    struct Stream
+    {
+        uint64_t highest{0};
+        uint64_t lastUsed{0};
+    };
+    /// New streams are rare so a linear search is fine
+    void evictOldestStream()
+    {
+        auto oldest = mStreams.begin();
+        for (auto idx = mStreams.begin(); idx != mStreams.end(); ++idx)
+        {
+            if (idx->second.lastUsed < oldest->second.lastUsed){oldest = idx;}
+        }
+        if (oldest != mStreams.end()){mStreams.erase(oldest);}
+    }
+    std::unordered_map<std::string, Stream,
+                       TransparentStringHash, std::equal_to<>> mStreams;
+    Callback mCallback{nullptr};
+    std::string mKey;
+    std::atomic<uint64_t> mSequencedMessages{0};
+    std::atomic<uint64_t> mMissedMessages{0};
+    std::atomic<uint64_t> mGaps{0};
+    uint64_t mClock{0};
+};
+}
+#endif
+#endif
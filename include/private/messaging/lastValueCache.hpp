@@ -0,0 +1,172 @@
+#ifndef PRIVATE_MESSAGING_LAST_VALUE_CACHE_HPP
+#define PRIVATE_MESSAGING_LAST_VALUE_CACHE_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <list>
+#include <stdexcept>
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Keeps the most recent message on each topic that passed through
+///        an xPub/xSub proxy so it can be replayed to late subscribers.
+/// @details A message is cached under its topic, i.e., the first frame, and
+///          optionally a key extracted from the message.  For example,
+///          heartbeats share a topic so they are keyed on the module name.
+///          The cache is bounded by the number of values and their total
+///          size.  When either bound is exceeded the value that was updated
+///          least recently is evicted.  The cache is owned by the proxy's
+///          forwarding thread so nothing is locked.
+class LastValueCache
+{
+public:
+    /// @brief Extracts a key from a message's topic and second frame.
+    using KeyExtractor = std::function<std::string (std::string_view,
+                                                    std::string_view)>;
+    /// @brief Constructor.
+    /// @param[in] capacity      The maximum number of values to keep.
+    /// @param[in] maximumBytes  The maximum size of all the values' frames.
+    /// @param[in] keyExtractor  If set then messages on a topic are cached
+    ///                          per key.  Otherwise, only the most recent
+    ///                          message on each topic is kept.
+    /// @throws std::invalid_argument if the capacity or maximum bytes is 0.
+    LastValueCache(const size_t capacity,
+                   const size_t maximumBytes,
+                   KeyExtractor keyExtractor = nullptr) :
+        mKeyExtractor(std::move(keyExtractor)),
+        mCapacity(capacity),
+        mMaximumBytes(maximumBytes)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("Capacity must be positive");
+        }
+        if (maximumBytes == 0)
+        {
+            throw std::invalid_argument("Maximum bytes must be positive");
+        }
+    }
+    /// @brief Caches a message.
+    /// @param[in] frames  The message's frames.  The first frame is the
+    ///                    topic.
+    /// @note A message larger than the maximum bytes is not cached and
+    ///       evicts the value it would have replaced since that is no
+    ///       longer the last value.
+    void update(const std::vector<std::string_view> &frames)
+    {
+        if (frames.empty()){return;}
+        makeKey(frames);
+        size_t nBytes{0};
+        for (const auto &frame : frames){nBytes = nBytes + frame.size();}
+        auto idx = mIndex.find(std::string_view {mKey});
+        if (nBytes > mMaximumBytes)
+        {
+            if (idx != mIndex.end()){erase(idx);}
+            return;
+        }
+        if (idx == mIndex.end())
+        {
+            mValues.emplace_back();
+            idx = mIndex.emplace(mKey, std::prev(mValues.end())).first;
+            idx->second->key = &idx->first;
+        }
+        else
+        {
+            // Most recently updated values live at the back
+            mValues.splice(mValues.end(), mValues, idx->second);
+            mBytes = mBytes - idx->second->bytes;
+        }
+        // Reuse the strings' storage since a topic's size rarely changes
+        auto &value = *idx->second;
+        value.frames.resize(frames.size());
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            value.frames[i].assign(frames[i]);
+        }
+        value.bytes = nBytes;
+        mBytes = mBytes + nBytes;
+        while (mValues.size() > mCapacity || mBytes > mMaximumBytes)
+        {
+            erase(mIndex.find(std::string_view {*mValues.front().key}));
+        }
+    }
+    /// @brief Visits the cached values whose topics start with the given
+    ///        subscription from least to most recently updated.
+    /// @param[in] subscription  The subscription.  An empty subscription
+    ///                          matches every topic.
+    /// @param[in] visit         Called with each matching value's frames.
+    void forEach(const std::string_view subscription,
+                 const std::function<void (const std::vector<std::string> &)>
+                     &visit) const
+    {
+        for (const auto &value : mValues)
+        {
+            if (value.frames.front().starts_with(subscription))
+            {
+                visit(value.frames);
+            }
+        }
+    }
+    /// @result The number of cached values.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mValues.size();
+    }
+    /// @result The total size of the cached values' frames.
+    [[nodiscard]] size_t getNumberOfBytes() const noexcept
+    {
+        return mBytes;
+    }
+private:
+    struct Value
+    {
+        std::vector<std::string> frames;
+        const std::string *key{nullptr};
+        size_t bytes{0};
+    };
+    using Index = std::unordered_map<std::string,
+                                     std::list<Value>::iterator,
+                                     TransparentStringHash, std::equal_to<>>;
+    /// @brief Builds the cache key in mKey.  The topic's length is prefixed
+    ///        so no topic and key pair can collide with another.
+    void makeKey(const std::vector<std::string_view> &frames)
+    {
+        auto topic = frames.front();
+        mKey.assign(std::to_string(topic.size()));
+        mKey.push_back(':');
+        mKey.append(topic);
+        if (mKeyExtractor)
+        {
+            auto payload = frames.size() > 1 ?
+                           frames[1] : std::string_view {};
+            // A message the extractor can't handle is cached by topic
+            try
+            {
+                mKey.append(mKeyExtractor(topic, payload));
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+    }
+    void erase(Index::iterator idx)
+    {
+        mBytes = mBytes - idx->second->bytes;
+        mValues.erase(idx->second);
+        mIndex.erase(idx);
+    }
+    KeyExtractor mKeyExtractor{nullptr};
+    // Ordered from least to most recently updated
+    std::list<Value> mValues;
+    Index mIndex;
+    std::string mKey;
+    size_t mCapacity{0};
+    size_t mMaximumBytes{0};
+    size_t mBytes{0};
+};
+}
+#endif
+#endif
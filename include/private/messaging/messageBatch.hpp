@@ -0,0 +1,114 @@
+#ifndef PRIVATE_MESSAGING_MESSAGE_BATCH_HPP
+#define PRIVATE_MESSAGING_MESSAGE_BATCH_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <vector>
+#include <typeinfo>
+#include <zmq.hpp>
+#include "umps/messageFormats/message.hpp"
+#include "private/messaging/sequenceStamp.hpp"
+namespace
+{
+/// @brief Sends a message as its type and payload frames optionally
+///        followed by a sequence stamp frame.
+/// @param[in] socket       The socket on which to send the message.
+/// @param[in] messageType  The message type.
+/// @param[in] payload      The serialized message.
+/// @param[in] stamper      If not NULL then this stamps the message.
+[[maybe_unused]]
+void sendMessage(zmq::socket_t &socket,
+                 const std::string_view messageType,
+                 const std::string_view payload,
+                 SequenceStamper *stamper = nullptr)
+{
+    zmq::const_buffer header{messageType.data(), messageType.size()};
+    socket.send(header, zmq::send_flags::sndmore);
+    zmq::const_buffer buffer{payload.data(), payload.size()};
+    if (stamper == nullptr)
+    {
+        socket.send(buffer, zmq::send_flags::none);
+        return;
+    }
+    socket.send(buffer, zmq::send_flags::sndmore);
+    auto stamp = ::packSequenceStamp(stamper->next(messageType));
+    zmq::const_buffer stampBuffer{stamp.data(), stamp.size()};
+    socket.send(stampBuffer, zmq::send_flags::none);
+}
+
+/// @brief Serializes a batch of messages into a single reusable buffer so
+///        that a burst of messages can be put on a socket with minimal
+///        per-message overhead.
+/// @note The buffers grow to the high-water mark of the batches and are
+///       retained between batches.
+class MessageBatch
+{
+public:
+    /// @brief Clears the batch but retains the allocated memory.
+    void clear() noexcept
+    {
+        mPayloads.clear();
+        mEntries.clear();
+    }
+    /// @brief Serializes the message and appends it to the batch.
+    /// @throws std::invalid_argument if the message cannot be serialized.
+    void add(const UMPS::MessageFormats::IMessage &message)
+    {
+        Entry entry;
+        entry.typeIndex = getMessageTypeIndex(message);
+        entry.payloadOffset = mPayloads.size();
+        message.serializeInto(&mPayloads);
+        entry.payloadLength = mPayloads.size() - entry.payloadOffset;
+        mEntries.push_back(entry);
+    }
+    /// @result The number of messages in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mEntries.size();
+    }
+    /// @result True indicates the batch is empty.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mEntries.empty();
+    }
+    /// @brief Sends each message in the batch as a two-part message
+    ///        comprised of the message type and payload.
+    /// @param[in] socket   The socket on which to send the messages.
+    /// @param[in] stamper  If not NULL then a sequence stamp frame is
+    ///                     appended to each message.
+    void send(zmq::socket_t &socket, SequenceStamper *stamper = nullptr) const
+    {
+        for (const auto &entry : mEntries)
+        {
+            const auto &messageType = mMessageTypes[entry.typeIndex].second;
+            std::string_view payload{mPayloads.data() + entry.payloadOffset,
+                                     entry.payloadLength};
+            ::sendMessage(socket, messageType, payload, stamper);
+        }
+    }
+private:
+    /// The message type is looked up by the message's dynamic type so that
+    /// the string is only created the first time a type is seen.
+    size_t getMessageTypeIndex(const UMPS::MessageFormats::IMessage &message)
+    {
+        const auto &typeInfo = typeid(message);
+        for (size_t i = 0; i < mMessageTypes.size(); ++i)
+        {
+            if (*mMessageTypes[i].first == typeInfo){return i;}
+        }
+        mMessageTypes.emplace_back(&typeInfo, message.getMessageType());
+        return mMessageTypes.size() - 1;
+    }
+    struct Entry
+    {
+        size_t typeIndex{0};
+        size_t payloadOffset{0};
+        size_t payloadLength{0};
+    };
+    std::string mPayloads;
+    std::vector<Entry> mEntries;
+    std::vector<std::pair<const std::type_info *, std::string>> mMessageTypes;
+};
+}
+#endif
+#endif
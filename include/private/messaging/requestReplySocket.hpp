@@ -26,6 +26,7 @@
 #include "umps/messaging/context.hpp"
 #include "umps/logging/standardOut.hpp"
 #include "private/messaging/ipcDirectory.hpp"
+#include "private/messageFormats/messageTypeRegistry.hpp"
 namespace
 {
 /// @brief This is a base implementation for a request/reply socket.
@@ -112,7 +113,7 @@ public:
         {
             throw std::invalid_argument("No message formats defined");
         }
-        mMessageFormats = messageFormats;
+        mMessageFormats = ::MessageTypeRegistry(messageFormats);
     }
     /// @brief Sets the socket options.
     void setSocketOptions(const UMPS::Messaging::SocketOptions &options)
@@ -323,7 +324,6 @@ public:
                                        (messagesReceived.at(1).data());
                 auto messageSize = messagesReceived.at(1).size();
                 std::string responseMessageType;
-                std::string responseMessage;
                 try
                 {
                     auto response = mCallback(messageType,
@@ -334,8 +334,9 @@ public:
                         try
                         {
                             responseMessageType = response->getMessageType();
-                            responseMessage = response->toMessage();
-                            send(responseMessageType, responseMessage);
+                            mSendBuffer.clear();
+                            response->serializeInto(&mSendBuffer);
+                            send(responseMessageType, mSendBuffer);
                         }
                         catch (const std::exception &e)
                         {
@@ -390,21 +391,24 @@ public:
         }
 #endif
         // Unpack the response
-        std::string messageType = msg.at(0).to_string();
-        if (!mMessageFormats.contains(messageType))
+        auto messageType = msg.at(0).to_string_view();
+        auto id = mMessageFormats.find(messageType);
+        if (id < 0)
         {
-            throw std::runtime_error("Unhandled response type: " + messageType);
+            throw std::runtime_error("Unhandled response type: "
+                                   + std::string {messageType});
         }
         const auto payload = static_cast<char *> (msg.at(1).data());
         auto responseLength = msg.at(1).size();
-        auto response = mMessageFormats.get(messageType);
+        auto response = mMessageFormats.createInstance(id);
         try
         {
             response->fromMessage(payload, responseLength);
         }
         catch (const std::exception &e)
         {
-            auto errorMsg = "Failed to unpack message of type: " + messageType;
+            auto errorMsg = "Failed to unpack message of type: "
+                          + std::string {messageType};
             mLogger->error(errorMsg);
             throw;
         }
@@ -435,13 +439,14 @@ public:
         {
             mLogger->warn("Message type is empty");
         }
-        auto messageContents = message.toMessage();
-        if (messageContents.empty())
+        mSendBuffer.clear();
+        message.serializeInto(&mSendBuffer);
+        if (mSendBuffer.empty())
         {
             mLogger->warn("Message is empty");
         }
         // Send the message
-        send(messageType, messageContents);
+        send(messageType, mSendBuffer);
     }
     /// @brief Maeks a request.
     [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
@@ -480,7 +485,7 @@ public:
           (const std::string &messageType, const void *contents,
            const size_t length)
     > mCallback;
-    UMPS::MessageFormats::Messages mMessageFormats;
+    ::MessageTypeRegistry mMessageFormats;
     UMPS::Messaging::SocketOptions mOptions;
     UMPS::Messaging::RouterDealer::RequestOptions mRequestOptions;
     UMPS::Messaging::RouterDealer::ReplyOptions mReplyOptions;
@@ -492,6 +497,7 @@ public:
         mRequestSocketDetails;
     std::thread mPollThread;
     std::string mAddress;
+    std::string mSendBuffer;
     zmq::socket_type mSocketType;
     std::chrono::milliseconds mPollingTimeOut{10};
     bool mConnected{false};
@@ -0,0 +1,138 @@
+#ifndef PRIVATE_MESSAGING_SEQUENCE_STAMP_HPP
+#define PRIVATE_MESSAGING_SEQUENCE_STAMP_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <array>
+#include <random>
+#include <cstdint>
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Identifies where a message entered a network of proxies and its
+///        position in the stream of messages on its topic from that origin.
+///        This is sent as an optional frame after the message's payload.
+/// @note Sequence numbers are counted per topic so a subscriber to some of
+///       an origin's topics can still tell when it missed a message.
+struct SequenceStamp
+{
+    uint64_t origin{0};
+    uint64_t sequence{0};
+};
+
+/// The stamp is a marker byte, a version byte, then the origin and the
+/// sequence number as 64 bit little endian integers.
+constexpr size_t SEQUENCE_STAMP_SIZE{18};
+constexpr uint8_t SEQUENCE_STAMP_MARKER{0xFE};
+constexpr uint8_t SEQUENCE_STAMP_VERSION{1};
+
+/// @brief Packs the stamp into a frame.
+[[maybe_unused]] [[nodiscard]]
+std::array<char, SEQUENCE_STAMP_SIZE>
+    packSequenceStamp(const SequenceStamp &stamp) noexcept
+{
+    std::array<char, SEQUENCE_STAMP_SIZE> frame{};
+    frame[0] = static_cast<char> (SEQUENCE_STAMP_MARKER);
+    frame[1] = static_cast<char> (SEQUENCE_STAMP_VERSION);
+    for (int i = 0; i < 8; ++i)
+    {
+        frame[2 + i] = static_cast<char> ((stamp.origin >> (8*i)) & 0xFF);
+        frame[10 + i] = static_cast<char> ((stamp.sequence >> (8*i)) & 0xFF);
+    }
+    return frame;
+}
+
+/// @brief Unpacks a stamp from a frame.
+/// @param[in] frame   The frame.
+/// @param[out] stamp  The stamp.  This is only set on success.
+/// @result True indicates the frame is a stamp.
+[[maybe_unused]] [[nodiscard]]
+bool unpackSequenceStamp(const std::string_view frame,
+                         SequenceStamp *stamp) noexcept
+{
+    if (frame.size() != SEQUENCE_STAMP_SIZE){return false;}
+    auto bytes = reinterpret_cast<const uint8_t *> (frame.data());
+    if (bytes[0] != SEQUENCE_STAMP_MARKER ||
+        bytes[1] != SEQUENCE_STAMP_VERSION)
+    {
+        return false;
+    }
+    uint64_t origin{0};
+    uint64_t sequence{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        origin = origin | (static_cast<uint64_t> (bytes[2 + i]) << (8*i));
+        sequence = sequence | (static_cast<uint64_t> (bytes[10 + i]) << (8*i));
+    }
+    stamp->origin = origin;
+    stamp->sequence = sequence;
+    return true;
+}
+
+/// @brief Builds the key of an origin's stream of messages on a topic in
+///        key.  This is the origin's 8 bytes followed by the topic.
+[[maybe_unused]]
+void makeStreamKey(const std::string_view topic, const uint64_t origin,
+                   std::string *key)
+{
+    key->resize(8);
+    for (int i = 0; i < 8; ++i)
+    {
+        (*key)[i] = static_cast<char> ((origin >> (8*i)) & 0xFF);
+    }
+    key->append(topic);
+}
+
+/// @brief Numbers the messages on each topic from one origin.  The first
+///        message on a topic is 1.
+/// @note There is one counter per message type so this is not bounded.
+class SequenceCounter
+{
+public:
+    /// @result The sequence number of the next message on this topic.
+    [[nodiscard]] uint64_t next(const std::string_view topic)
+    {
+        auto idx = mSequences.find(topic);
+        if (idx == mSequences.end())
+        {
+            idx = mSequences.emplace(std::string {topic}, 0).first;
+        }
+        idx->second = idx->second + 1;
+        return idx->second;
+    }
+private:
+    std::unordered_map<std::string, uint64_t,
+                       TransparentStringHash, std::equal_to<>> mSequences;
+};
+/// @brief Stamps the messages from one origin.  The origin is drawn at
+///        random so a restarted publisher or proxy can't be mistaken for
+///        its previous incarnation.
+class SequenceStamper
+{
+public:
+    SequenceStamper()
+    {
+        std::random_device device;
+        std::mt19937_64 generator(
+            (static_cast<uint64_t> (device()) << 32) | device());
+        mOrigin = generator();
+    }
+    /// @result The stamp of the next message on this topic.
+    [[nodiscard]] SequenceStamp next(const std::string_view topic)
+    {
+        return SequenceStamp {mOrigin, mSequences.next(topic)};
+    }
+    /// @result The origin.
+    [[nodiscard]] uint64_t getOrigin() const noexcept
+    {
+        return mOrigin;
+    }
+private:
+    SequenceCounter mSequences;
+    uint64_t mOrigin{0};
+};
+}
+#endif
+#endif
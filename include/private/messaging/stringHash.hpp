@@ -0,0 +1,23 @@
+#ifndef PRIVATE_MESSAGING_STRING_HASH_HPP
+#define PRIVATE_MESSAGING_STRING_HASH_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <functional>
+namespace
+{
+/// @brief Hashes strings and string views alike so that an unordered
+///        container keyed by std::string can be searched with a topic frame
+///        without first copying it into a std::string.  Use this with
+///        std::equal_to<>.
+struct TransparentStringHash
+{
+    using is_transparent = void;
+    size_t operator()(const std::string_view string) const noexcept
+    {
+        return std::hash<std::string_view> {}(string);
+    }
+};
+}
+#endif
+#endif
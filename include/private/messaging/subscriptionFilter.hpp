@@ -0,0 +1,106 @@
+#ifndef PRIVATE_MESSAGING_SUBSCRIPTION_FILTER_HPP
+#define PRIVATE_MESSAGING_SUBSCRIPTION_FILTER_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <map>
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Tracks the topics that the subscribers of an xPub/xSub proxy want
+///        so that the proxy only subscribes upstream to those topics and can
+///        discard everything else before it is fanned out.
+/// @details Subscriptions are reference counted.  Only the first subscription
+///          and the last unsubscription to a topic need to be forwarded to
+///          the publishers.  As with ZeroMQ, a subscription is a prefix so
+///          a topic is wanted if any subscription is a prefix of it.  UMPS
+///          subscribers subscribe to complete message types so in practice
+///          there are only a handful of distinct prefix lengths and a topic
+///          is matched with one hash lookup per length.
+class SubscriptionFilter
+{
+public:
+    /// @brief Updates the subscriptions from an xPub subscription message.
+    ///        The first byte is 1 to subscribe or 0 to unsubscribe and the
+    ///        remaining bytes are the topic.
+    /// @param[in] message  The subscription message.
+    /// @result True indicates the message should be forwarded to the
+    ///         publishers.  This is the case for the first subscription to
+    ///         a topic, the last unsubscription from a topic, and anything
+    ///         that is not a subscription message.
+    bool update(const std::string_view message)
+    {
+        if (message.empty()){return true;}
+        if (message[0] != 0 && message[0] != 1){return true;}
+        auto topic = message.substr(1);
+        auto idx = mSubscriptions.find(topic);
+        if (message[0] == 1)
+        {
+            if (idx != mSubscriptions.end())
+            {
+                idx->second = idx->second + 1;
+                return false;
+            }
+            mSubscriptions.emplace(std::string {topic}, 1);
+            mPrefixLengths[topic.size()] = mPrefixLengths[topic.size()] + 1;
+            mHaveLastTopic = false;
+            return true;
+        }
+        // Nobody subscribed to this so there's nothing to undo upstream
+        if (idx == mSubscriptions.end()){return false;}
+        idx->second = idx->second - 1;
+        if (idx->second > 0){return false;}
+        mSubscriptions.erase(idx);
+        auto length = mPrefixLengths.find(topic.size());
+        length->second = length->second - 1;
+        if (length->second == 0){mPrefixLengths.erase(length);}
+        mHaveLastTopic = false;
+        return true;
+    }
+    /// @result True indicates at least one subscriber wants this topic.
+    /// @note Consecutive messages usually share a topic so the last answer
+    ///       is remembered until the subscriptions change.
+    [[nodiscard]] bool wants(const std::string_view topic)
+    {
+        if (mHaveLastTopic && topic == mLastTopic){return mLastTopicWanted;}
+        bool wanted{false};
+        for (const auto &length : mPrefixLengths)
+        {
+            if (length.first > topic.size()){break;}
+            if (mSubscriptions.contains(topic.substr(0, length.first)))
+            {
+                wanted = true;
+                break;
+            }
+        }
+        mLastTopic.assign(topic);
+        mLastTopicWanted = wanted;
+        mHaveLastTopic = true;
+        return wanted;
+    }
+    /// @result The number of subscribers to exactly this topic.
+    [[nodiscard]] int getNumberOfSubscribers(
+        const std::string_view topic) const
+    {
+        auto idx = mSubscriptions.find(topic);
+        return idx != mSubscriptions.end() ? idx->second : 0;
+    }
+    /// @result The number of distinct subscriptions.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mSubscriptions.size();
+    }
+private:
+    std::unordered_map<std::string, int,
+                       TransparentStringHash, std::equal_to<>> mSubscriptions;
+    // Number of subscriptions with each length sorted by length
+    std::map<size_t, int> mPrefixLengths;
+    std::string mLastTopic;
+    bool mLastTopicWanted{false};
+    bool mHaveLastTopic{false};
+};
+}
+#endif
+#endif
@@ -0,0 +1,138 @@
+#ifndef PRIVATE_MESSAGING_TOPIC_STATISTICS_HPP
+#define PRIVATE_MESSAGING_TOPIC_STATISTICS_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <map>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "private/messaging/stringHash.hpp"
+namespace
+{
+/// @brief Counts the traffic on each topic forwarded by an xPub/xSub proxy.
+///        The topic is the first frame of a message, i.e., the message type.
+/// @details The counters are owned by the proxy's forwarding thread.  Other
+///          threads ask that thread for them through the control socket so
+///          nothing is locked or atomically updated.
+class TopicStatistics
+{
+public:
+    /// @brief Counts a forwarded message.
+    /// @param[in] topic   The message's topic.
+    /// @param[in] nBytes  The size of all the message's frames.
+    void addMessage(const std::string_view topic, const size_t nBytes)
+    {
+        auto counters = find(topic);
+        counters->messages = counters->messages + 1;
+        counters->bytes = counters->bytes + nBytes;
+    }
+    /// @brief Counts a message that was dropped because the backend was at
+    ///        its high water mark.
+    /// @param[in] topic  The message's topic.
+    void addDrop(const std::string_view topic)
+    {
+        auto counters = find(topic);
+        counters->drops = counters->drops + 1;
+    }
+    /// @brief Counts a subscription message from the xPub socket.  The first
+    ///        byte is 1 to subscribe or 0 to unsubscribe and the remaining
+    ///        bytes are the topic.
+    /// @param[in] message  The subscription message.
+    /// @result True indicates this was a subscription message.
+    bool addSubscription(const std::string_view message)
+    {
+        if (message.empty()){return false;}
+        if (message[0] != 0 && message[0] != 1){return false;}
+        auto counters = find(message.substr(1));
+        if (message[0] == 1)
+        {
+            counters->subscribers = counters->subscribers + 1;
+        }
+        else if (counters->subscribers > 0)
+        {
+            counters->subscribers = counters->subscribers - 1;
+        }
+        return true;
+    }
+    /// @result The number of distinct topics.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mCounters.size();
+    }
+    /// @brief Resets the counters.
+    void clear() noexcept
+    {
+        mCounters.clear();
+        mLastCounters = nullptr;
+        mLastTopic.clear();
+    }
+    /// @result The counters as a JSON object sorted by topic.
+    [[nodiscard]] nlohmann::json toJSONObject() const
+    {
+        std::map<std::string_view, const Counters *> sorted;
+        for (const auto &counters : mCounters)
+        {
+            sorted.insert(std::pair{std::string_view {counters.first},
+                                    &counters.second});
+        }
+        nlohmann::json topics = nlohmann::json::array();
+        for (const auto &counters : sorted)
+        {
+            nlohmann::json topic;
+            topic["Topic"] = std::string {counters.first};
+            topic["Messages"] = counters.second->messages;
+            topic["Bytes"] = counters.second->bytes;
+            topic["Drops"] = counters.second->drops;
+            topic["Subscribers"] = counters.second->subscribers;
+            topics.push_back(std::move(topic));
+        }
+        nlohmann::json obj;
+        obj["Topics"] = std::move(topics);
+        return obj;
+    }
+    /// Topics beyond this many are counted under OTHER_TOPICS so a
+    /// misbehaving publisher can't grow the table without bound.
+    static constexpr size_t MAX_TOPICS{4096};
+    static constexpr std::string_view OTHER_TOPICS{"*OtherTopics*"};
+private:
+    struct Counters
+    {
+        uint64_t messages{0};
+        uint64_t bytes{0};
+        uint64_t drops{0};
+        uint64_t subscribers{0};
+    };
+    /// @result The counters for the topic.  Consecutive messages usually
+    ///         share a topic so the last lookup is remembered.  This is
+    ///         safe because unordered_map never moves its elements.
+    Counters *find(const std::string_view topic)
+    {
+        if (mLastCounters != nullptr && topic == mLastTopic)
+        {
+            return mLastCounters;
+        }
+        auto idx = mCounters.find(topic);
+        if (idx == mCounters.end())
+        {
+            auto key = mCounters.size() < MAX_TOPICS ?
+                       topic : OTHER_TOPICS;
+            idx = mCounters.find(key);
+            if (idx == mCounters.end())
+            {
+                idx = mCounters.emplace(std::string {key}, Counters {}).first;
+            }
+        }
+        mLastTopic.assign(topic);
+        mLastCounters = &idx->second;
+        return mLastCounters;
+    }
+    std::unordered_map<std::string, Counters,
+                       TransparentStringHash, std::equal_to<>> mCounters;
+    std::string mLastTopic;
+    Counters *mLastCounters{nullptr};
+};
+}
+#endif
+#endif
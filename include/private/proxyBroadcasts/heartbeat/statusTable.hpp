@@ -0,0 +1,199 @@
+#ifndef PRIVATE_PROXY_BROADCASTS_HEARTBEAT_STATUS_TABLE_HPP
+#define PRIVATE_PROXY_BROADCASTS_HEARTBEAT_STATUS_TABLE_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "umps/proxyBroadcasts/heartbeat/status.hpp"
+namespace
+{
+
+/// @brief Tracks the latest heartbeat status of every module and which
+///        modules have stopped sending heartbeats.
+/// @details The statuses are kept contiguously in a vector that is indexed
+///          by the module name so an update is a hash lookup and a copy.
+///          Each live module has at most one deadline in a min-heap so
+///          finding the stale modules only touches modules whose deadline
+///          has passed.
+class StatusTable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    /// @brief The published view of the table.
+    struct Snapshot
+    {
+        std::vector<UMPS::ProxyBroadcasts::Heartbeat::Status> statuses;
+        std::vector<std::string> staleModules;
+    };
+    /// @brief Constructor.
+    /// @param[in] timeOut  A module that is alive is stale if it does not
+    ///                     send a heartbeat within this time.
+    /// @throws std::invalid_argument if the time out is not positive.
+    explicit StatusTable(const std::chrono::milliseconds &timeOut) :
+        mTimeOut(timeOut)
+    {
+        if (timeOut.count() <= 0)
+        {
+            throw std::invalid_argument("Time out must be positive");
+        }
+    }
+    /// @brief Records the module's latest status.  A status that is not
+    ///        newer than the module's current status is ignored.
+    /// @param[in] status  The status.
+    /// @param[in] now     The time the status was received.
+    void update(const UMPS::ProxyBroadcasts::Heartbeat::Status &status,
+                const Clock::time_point now = Clock::now())
+    {
+        auto module = status.getModule();
+        std::scoped_lock lock(mMutex);
+        auto idx = mIndex.find(module);
+        if (idx == mIndex.end())
+        {
+            idx = mIndex.insert(std::pair{module, mEntries.size()}).first;
+            mEntries.push_back(Entry{status, now + mTimeOut, false, false});
+        }
+        else
+        {
+            // A status that isn't newer is a repeat, e.g., from a snapshot
+            // of a proxy's last-value cache, and says nothing about liveness
+            if (!(status > mEntries[idx->second].status)){return;}
+            mEntries[idx->second].status = status;
+        }
+        auto index = idx->second;
+        auto &entry = mEntries[index];
+        entry.deadline = now + mTimeOut;
+        entry.stale = false;
+        // Modules that disconnected or died aren't expected to check in
+        if (expectsHeartbeats(entry.status) && !entry.scheduled)
+        {
+            mDeadlines.push(Deadline{entry.deadline, index});
+            entry.scheduled = true;
+        }
+        mSnapshot.store(nullptr, std::memory_order_release);
+    }
+    /// @brief Marks the modules whose deadlines have passed as stale.
+    /// @param[in] now  The current time.
+    /// @result The modules that became stale.
+    std::vector<std::string> processDeadlines(
+        const Clock::time_point now = Clock::now())
+    {
+        std::vector<std::string> newlyStale;
+        std::scoped_lock lock(mMutex);
+        while (!mDeadlines.empty() && mDeadlines.top().time <= now)
+        {
+            auto deadline = mDeadlines.top();
+            mDeadlines.pop();
+            auto &entry = mEntries[deadline.index];
+            if (!expectsHeartbeats(entry.status))
+            {
+                entry.scheduled = false;
+                continue;
+            }
+            // Heard from it since this was scheduled so check back later
+            if (entry.deadline > now)
+            {
+                mDeadlines.push(Deadline{entry.deadline, deadline.index});
+                continue;
+            }
+            entry.scheduled = false;
+            entry.stale = true;
+            newlyStale.push_back(entry.status.getModule());
+        }
+        if (!newlyStale.empty())
+        {
+            mSnapshot.store(nullptr, std::memory_order_release);
+        }
+        return newlyStale;
+    }
+    /// @result The time until the next deadline.  If there are no deadlines
+    ///         then this is the time out.
+    [[nodiscard]] std::chrono::milliseconds getTimeToNextDeadline(
+        const Clock::time_point now = Clock::now()) const
+    {
+        std::scoped_lock lock(mMutex);
+        if (mDeadlines.empty()){return mTimeOut;}
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>
+                    (mDeadlines.top().time - now);
+        return std::max(wait, std::chrono::milliseconds {0});
+    }
+    /// @result The current snapshot of the table.  This does not lock
+    ///         unless the table changed since the last snapshot.
+    [[nodiscard]] std::shared_ptr<const Snapshot> getSnapshot() const
+    {
+        auto snapshot = mSnapshot.load(std::memory_order_acquire);
+        if (snapshot){return snapshot;}
+        std::scoped_lock lock(mMutex);
+        snapshot = mSnapshot.load(std::memory_order_acquire);
+        if (snapshot){return snapshot;}
+        auto newSnapshot = std::make_shared<Snapshot> ();
+        newSnapshot->statuses.reserve(mEntries.size());
+        for (const auto &entry : mEntries)
+        {
+            newSnapshot->statuses.push_back(entry.status);
+            if (entry.stale)
+            {
+                newSnapshot->staleModules.push_back(entry.status.getModule());
+            }
+        }
+        snapshot = std::move(newSnapshot);
+        // Published under the lock so a concurrent change can't be lost
+        mSnapshot.store(snapshot, std::memory_order_release);
+        return snapshot;
+    }
+    /// @result The number of modules in the table.
+    [[nodiscard]] size_t size() const
+    {
+        std::scoped_lock lock(mMutex);
+        return mEntries.size();
+    }
+    /// @result The number of pending deadlines.  This is at most the
+    ///         number of modules.
+    [[nodiscard]] size_t getNumberOfDeadlines() const
+    {
+        std::scoped_lock lock(mMutex);
+        return mDeadlines.size();
+    }
+private:
+    struct Entry
+    {
+        UMPS::ProxyBroadcasts::Heartbeat::Status status;
+        Clock::time_point deadline;
+        bool scheduled{false};
+        bool stale{false};
+    };
+    struct Deadline
+    {
+        Clock::time_point time;
+        size_t index{0};
+        bool operator>(const Deadline &rhs) const noexcept
+        {
+            return time > rhs.time;
+        }
+    };
+    [[nodiscard]] static bool expectsHeartbeats(
+        const UMPS::ProxyBroadcasts::Heartbeat::Status &status) noexcept
+    {
+        auto moduleStatus = status.getModuleStatus();
+        return moduleStatus != UMPS::ProxyBroadcasts::Heartbeat::ModuleStatus::Disconnected &&
+               moduleStatus != UMPS::ProxyBroadcasts::Heartbeat::ModuleStatus::Died;
+    }
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, size_t> mIndex;
+    std::vector<Entry> mEntries;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>
+        mDeadlines;
+    mutable std::atomic<std::shared_ptr<const Snapshot>> mSnapshot{nullptr};
+    std::chrono::milliseconds mTimeOut;
+};
+
+}
+#endif
+#endif
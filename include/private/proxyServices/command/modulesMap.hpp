@@ -0,0 +1,446 @@
+#ifndef PRIVATE_PROXY_SERVICES_COMMAND_MODULES_MAP_HPP
+#define PRIVATE_PROXY_SERVICES_COMMAND_MODULES_MAP_HPP
+#ifdef UMPS_SRC
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "umps/proxyServices/command/moduleDetails.hpp"
+namespace
+{
+
+class Module
+{
+public:
+    Module() = default;
+    /// @brief Creates a module that is timed out after the last ping
+    ///        interval.
+    Module(const UMPS::ProxyServices::Command::ModuleDetails &details,
+           const std::vector<std::chrono::milliseconds> &pingIntervals) :
+        Module(details, pingIntervals,
+               pingIntervals.empty() ?
+               std::chrono::milliseconds {0} : pingIntervals.back())
+    {
+    }
+    /// @brief Creates a module that is pinged at the given intervals
+    ///        after its last response and is timed out after the given
+    ///        time out.
+    Module(const UMPS::ProxyServices::Command::ModuleDetails &details,
+           const std::vector<std::chrono::milliseconds> &pingIntervals,
+           const std::chrono::milliseconds &timeOut) :
+        mPingIntervals(pingIntervals),
+        mTimeOut(timeOut)
+    {
+        if (!details.haveName())
+        {
+            throw std::invalid_argument("Module name not set");
+        }
+        mDetails = details;
+        // Just registered so there's a semblance of life
+        updateLastResponseToNow();
+    }
+    /// @brief Updates the timing.
+    void updateLastResponseToNow()
+    {
+        auto now = std::chrono::high_resolution_clock::now();
+        mLastResponse
+            = std::chrono::duration_cast<std::chrono::milliseconds> (
+                 now.time_since_epoch());
+        mNumberOfPings = 0;
+    }
+    /// @result The time at which the module is next due to be pinged or,
+    ///         if all pings were sent, timed out.
+    [[nodiscard]] std::chrono::milliseconds getNextDeadline() const noexcept
+    {
+        auto deadline = mLastResponse + mTimeOut;
+        if (mNumberOfPings < mPingIntervals.size())
+        {
+            deadline = std::min(deadline,
+                                mLastResponse + mPingIntervals[mNumberOfPings]);
+        }
+        return deadline;
+    }
+    // Module details.
+    UMPS::ProxyServices::Command::ModuleDetails mDetails;
+    // Last time module responded.
+    std::chrono::milliseconds mLastResponse{0};
+    // The ping intervals
+    std::vector<std::chrono::milliseconds> mPingIntervals;
+    // If the module does not respond within this interval it is timed out
+    std::chrono::milliseconds mTimeOut{0};
+    // The number of pings sent since the last response
+    size_t mNumberOfPings{0};
+    // Identifies the module's current entry in the deadline queue
+    uint64_t mGeneration{0};
+};
+
+/// @brief Thread-safe map between addresses and modules.
+///        Technically, both the worker address and module are unique but
+///        it proves to be slightly simpler to make the worker address the
+///        key in the map.
+/// @details A secondary hash index from the module's name and instance to
+///          the worker address is maintained alongside the map so that
+///          routing a request to a module does not require scanning every
+///          registered module.
+///
+///          Additionally, each module's next ping or time out is kept in a
+///          min-heap of deadlines.  When a module responds a new deadline
+///          is pushed and the old one is left in the heap; entries whose
+///          generation does not match the module's are skipped when they
+///          are popped.  Hence, only modules that are due are visited.
+///
+///          The list of modules is served from an immutable snapshot.
+///          Registering or removing a module drops the snapshot and the
+///          next request rebuilds it.  Holders of an older snapshot are
+///          unaffected.
+///
+///          Every registration and removal increments the map's version and
+///          is recorded in a bounded log so that clients can ask for only
+///          the changes since a version they have seen.  The version starts
+///          at the time the map was created, in microseconds, so versions
+///          handed out by a previous run of the proxy predate the log.
+class ModulesMap
+{
+public:
+    /// @brief The module name and instance.
+    using ModuleKey = std::pair<std::string, uint16_t>;
+    struct ModuleKeyHash
+    {
+        size_t operator()(const ModuleKey &key) const noexcept
+        {
+            auto result = std::hash<std::string> {}(key.first);
+            // Boost's hash_combine
+            return result
+                 ^ (std::hash<uint16_t> {}(key.second)
+                    + 0x9e3779b9 + (result << 6) + (result >> 2));
+        }
+    };
+    /// @brief An immutable copy of the registered modules.
+    struct Snapshot
+    {
+        std::unordered_map<ModuleKey, std::string, ModuleKeyHash>
+            addressByModule;
+        std::vector<UMPS::ProxyServices::Command::ModuleDetails> modules;
+        uint64_t version{0};
+    };
+    /// @brief Constructor.
+    ModulesMap()
+    {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>
+                   (std::chrono::system_clock::now().time_since_epoch());
+        mVersion = static_cast<uint64_t> (now.count());
+        mOldestVersion = mVersion;
+    }
+    /// @brief Inserts the worker address and module.
+    /// @throws std::invalid_argument if the module name is not set or the
+    ///         worker or module already exists.
+    void insert(std::pair<std::string, ::Module> &&item)
+    {
+        auto key = makeKey(item.second.mDetails);
+        std::scoped_lock lock(mMutex);
+        checkAndThrow(item.first, key);
+        mAddressByModule.insert(std::pair{std::move(key), item.first});
+        auto [idx, inserted] = mModules.insert(std::move(item));
+        schedule(idx->first, &idx->second);
+        recordChange(idx->second.mDetails, true);
+    }
+    void insert(const std::pair<std::string, ::Module> &item)
+    {
+        auto itemCopy = item;
+        insert(std::move(itemCopy));
+    }
+    [[nodiscard]] bool empty() const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        return mModules.empty();
+    }
+    /// @result The number of registered modules.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        return mModules.size();
+    }
+    /// @result The backend's address corresponding to this module.
+    /// @note If the address is empty then it was not found.
+    [[nodiscard]]
+    std::string getAddress(const std::string &moduleName,
+                           const uint16_t instance) const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        auto idx = mAddressByModule.find(ModuleKey{moduleName, instance});
+        if (idx != mAddressByModule.end()){return idx->second;}
+        return "";
+    }
+    /// @result The current snapshot of the registered modules.  This is only
+    ///         rebuilt when the modules changed since the last snapshot.
+    [[nodiscard]] std::shared_ptr<const Snapshot> getSnapshot() const
+    {
+        std::scoped_lock lock(mMutex);
+        if (mSnapshot){return mSnapshot;}
+        auto snapshot = std::make_shared<Snapshot> ();
+        snapshot->addressByModule = mAddressByModule;
+        snapshot->version = mVersion;
+        snapshot->modules.reserve(mModules.size());
+        for (const auto &m : mModules)
+        {
+            snapshot->modules.push_back(m.second.mDetails);
+        }
+        mSnapshot = std::move(snapshot);
+        return mSnapshot;
+    }
+    /// @result True indicates the module is in the map.
+    [[nodiscard]] bool contains(const ::Module &module) const noexcept
+    {
+         return contains(module.mDetails);
+    }
+    /// @result True indicates the module is in the map.
+    [[nodiscard]] bool contains(
+        const UMPS::ProxyServices::Command::ModuleDetails &details)
+        const noexcept
+    {
+        // Modules without names can't be inserted
+        if (!details.haveName()){return false;}
+        auto key = makeKey(details);
+        std::scoped_lock lock(mMutex);
+        return mAddressByModule.contains(key);
+    }
+    /// @brief Updates the last ping time for the module at this address.
+    void updateLastResponseToNow(const std::string &address)
+    {
+        std::scoped_lock lock(mMutex);
+        auto idx = mModules.find(address);
+        if (idx != mModules.end())
+        {
+            idx->second.updateLastResponseToNow();
+            schedule(idx->first, &idx->second);
+        }
+    }
+    /// @brief Visits the modules whose deadlines have passed.
+    /// @param[in] now          The current time.
+    /// @param[out] pings       The worker addresses of the modules that
+    ///                         should be pinged.
+    /// @param[out] expired     The worker addresses and details of the
+    ///                         modules that timed out.  These modules are
+    ///                         removed from the map.
+    void processDeadlines(
+        const std::chrono::milliseconds &now,
+        std::vector<std::string> *pings,
+        std::vector<std::pair<std::string,
+                    UMPS::ProxyServices::Command::ModuleDetails>> *expired)
+    {
+        std::scoped_lock lock(mMutex);
+        while (!mDeadlines.empty() && mDeadlines.top().time <= now)
+        {
+            auto deadline = mDeadlines.top();
+            mDeadlines.pop();
+            auto idx = mModules.find(deadline.workerAddress);
+            // Module was removed or rescheduled since this was pushed
+            if (idx == mModules.end() ||
+                idx->second.mGeneration != deadline.generation)
+            {
+                continue;
+            }
+            auto &module = idx->second;
+            auto dt = now - module.mLastResponse;
+            if (dt >= module.mTimeOut)
+            {
+                expired->push_back(std::pair{idx->first, module.mDetails});
+                mAddressByModule.erase(makeKey(module.mDetails));
+                recordChange(module.mDetails, false);
+                mModules.erase(idx);
+                continue;
+            }
+            // One ping covers all the intervals that have elapsed
+            while (module.mNumberOfPings < module.mPingIntervals.size() &&
+                   dt >= module.mPingIntervals[module.mNumberOfPings])
+            {
+                module.mNumberOfPings = module.mNumberOfPings + 1;
+            }
+            pings->push_back(idx->first);
+            schedule(idx->first, &module);
+        }
+    }
+    /// @result The current version of the map.
+    [[nodiscard]] uint64_t getVersion() const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        return mVersion;
+    }
+    /// @brief Gets the net changes to the map after the given version.
+    /// @param[in] version          The version after which to get changes.
+    /// @param[out] added           The modules that were added.  This
+    ///                             includes modules that were removed then
+    ///                             added again.
+    /// @param[out] removed         The modules that were removed.  These
+    ///                             should be applied before the additions.
+    /// @param[out] currentVersion  The version of the map these changes
+    ///                             bring the caller up to.
+    /// @result False indicates the changes since this version are no longer
+    ///         known, e.g., the version is too old or from another run of
+    ///         the proxy, and the caller needs every module.
+    [[nodiscard]] bool getChangesSince(
+        const uint64_t version,
+        std::vector<UMPS::ProxyServices::Command::ModuleDetails> *added,
+        std::vector<UMPS::ProxyServices::Command::ModuleDetails> *removed,
+        uint64_t *currentVersion) const
+    {
+        added->clear();
+        removed->clear();
+        std::scoped_lock lock(mMutex);
+        if (version < mOldestVersion || version > mVersion){return false;}
+        *currentVersion = mVersion;
+        // The first change to a module tells whether it existed at the
+        // requested version and the last whether it exists now
+        std::unordered_map<ModuleKey, std::pair<const Change *, const Change *>,
+                           ModuleKeyHash> netChanges;
+        auto first = std::upper_bound(mChanges.begin(), mChanges.end(),
+                                      version,
+                                      [](const uint64_t v, const Change &c)
+                                      {
+                                          return v < c.version;
+                                      });
+        for (auto c = first; c != mChanges.end(); ++c)
+        {
+            auto [idx, inserted]
+                = netChanges.try_emplace(makeKey(c->details), &*c, &*c);
+            if (!inserted){idx->second.second = &*c;}
+        }
+        for (const auto &netChange : netChanges)
+        {
+            if (!netChange.second.first->added)
+            {
+                removed->push_back(netChange.second.first->details);
+            }
+            if (netChange.second.second->added)
+            {
+                added->push_back(netChange.second.second->details);
+            }
+        }
+        return true;
+    }
+    /// @result True indicates the worker address is in the map.
+    [[nodiscard]] bool contains(const std::string &workerAddress) const noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        return mModules.contains(workerAddress);
+    }
+    /// @brief Removes a module corresponding to the ZMQ address.
+    void erase(const std::string &workerAddress)
+    {
+        if (workerAddress.empty())
+        {
+            throw std::invalid_argument("Worker address is empty");
+        }
+        std::scoped_lock lock(mMutex);
+        auto idx = mModules.find(workerAddress);
+        if (idx == mModules.end()){return;} // Nothing to do, doesn't exist
+        mAddressByModule.erase(makeKey(idx->second.mDetails));
+        recordChange(idx->second.mDetails, false);
+        mModules.erase(idx);
+    }
+    /// @result The worker addresses of the modules.
+    [[nodiscard]] std::vector<std::string> getWorkerAddresses() const noexcept
+    {
+        std::vector<std::string> result;
+        std::scoped_lock lock(mMutex);
+        result.reserve(mModules.size());
+        for (const auto &m : mModules){result.push_back(m.first);}
+        return result;
+    }
+    /// @result A list of modules.
+    [[nodiscard]]
+    std::vector<UMPS::ProxyServices::Command::ModuleDetails> toVector()
+        const noexcept
+    {
+        return getSnapshot()->modules;
+    }
+    mutable std::mutex mMutex;
+    std::map<std::string, ::Module> mModules;
+private:
+    struct Change
+    {
+        uint64_t version{0};
+        UMPS::ProxyServices::Command::ModuleDetails details;
+        bool added{false};
+    };
+    struct Deadline
+    {
+        std::chrono::milliseconds time{0};
+        std::string workerAddress;
+        uint64_t generation{0};
+        bool operator>(const Deadline &rhs) const noexcept
+        {
+            return time > rhs.time;
+        }
+    };
+    /// @brief Pushes the module's next deadline.  The caller must hold the
+    ///        mutex.
+    void schedule(const std::string &workerAddress, ::Module *module)
+    {
+        mGeneration = mGeneration + 1;
+        module->mGeneration = mGeneration;
+        mDeadlines.push(Deadline{module->getNextDeadline(),
+                                 workerAddress,
+                                 mGeneration});
+    }
+    /// @brief Bumps the version, logs the change, and drops the published
+    ///        snapshot.  The caller must hold the mutex.
+    void recordChange(
+        const UMPS::ProxyServices::Command::ModuleDetails &details,
+        const bool added)
+    {
+        mVersion = mVersion + 1;
+        mChanges.push_back(Change{mVersion, details, added});
+        if (mChanges.size() > MAX_CHANGES)
+        {
+            mOldestVersion = mChanges.front().version;
+            mChanges.pop_front();
+        }
+        mSnapshot = nullptr;
+    }
+    [[nodiscard]] static ModuleKey makeKey(
+        const UMPS::ProxyServices::Command::ModuleDetails &details)
+    {
+        if (!details.haveName())
+        {
+            throw std::invalid_argument("Module name not set");
+        }
+        return ModuleKey{details.getName(), details.getInstance()};
+    }
+    /// @brief Utility to verify that input worker address and module
+    ///        are not yet in the map.  The caller must hold the mutex.
+    void checkAndThrow(const std::string &workerAddress,
+                       const ModuleKey &key) const
+    {
+        if (mModules.contains(workerAddress))
+        {
+            throw std::invalid_argument("Worker already exists");
+        }
+        if (mAddressByModule.contains(key))
+        {
+            throw std::invalid_argument("Module already exists");
+        }
+    }
+    std::unordered_map<ModuleKey, std::string, ModuleKeyHash> mAddressByModule;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>
+        mDeadlines;
+    mutable std::shared_ptr<const Snapshot> mSnapshot{nullptr};
+    static constexpr size_t MAX_CHANGES{4096};
+    std::deque<Change> mChanges;
+    uint64_t mVersion{0};
+    // Changes after this version are in the log
+    uint64_t mOldestVersion{0};
+    uint64_t mGeneration{0};
+};
+
+}
+#endif
+#endif
@@ -0,0 +1,244 @@
+#ifndef UMPS_PRIVATE_RING_BUFFER_HPP
+#define UMPS_PRIVATE_RING_BUFFER_HPP
+#ifdef UMPS_SRC
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include "private/eventSignal.hpp"
+namespace
+{
+/// @brief A bounded, lock-free ring buffer for passing messages between
+///        threads.  This is based on Dmitry Vyukov's bounded queue.  Each
+///        slot carries a sequence number that tells the producers and the
+///        consumer whether the slot is free or full so that neither side
+///        takes a lock.
+/// @details There may only be one consumer.  If MultipleProducers is false
+///          then there may only be one producer as well and pushing does
+///          not require a compare-and-swap.
+///
+///          Optionally, the buffer can signal an eventfd when a value is
+///          pushed.  The consumer can then block in \c wait_until_and_pop()
+///          or poll \c getFileDescriptor(), e.g., in a zmq::poll, instead
+///          of spinning on \c try_pop().
+/// @tparam T                  The value type.  This need only be movable.
+/// @tparam MultipleProducers  True indicates several threads may push.
+template<typename T, bool MultipleProducers>
+class RingBuffer
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] capacity    The maximum number of values the buffer can
+    ///                        hold.  This is rounded up to the next power
+    ///                        of 2.
+    /// @param[in] enableWakeUp  If true then the buffer signals a file
+    ///                          descriptor on every push.
+    /// @throws std::invalid_argument if the capacity is not positive.
+    /// @throws std::runtime_error if the eventfd could not be created.
+    explicit RingBuffer(const size_t capacity = 1024,
+                        const bool enableWakeUp = false)
+    {
+        if (capacity < 1)
+        {
+            throw std::invalid_argument("Capacity must be positive");
+        }
+        size_t nSlots = 1;
+        while (nSlots < capacity){nSlots = 2*nSlots;}
+        mSlots = std::make_unique<Slot[]> (nSlots);
+        for (size_t i = 0; i < nSlots; ++i)
+        {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mMask = nSlots - 1;
+        if (enableWakeUp){mWakeUp = std::make_unique<EventSignal> ();}
+    }
+    /// @brief Attempts to move a value to the back of the buffer.
+    /// @param[in,out] value  The value to add.  On successful exit, value's
+    ///                       behavior is undefined.
+    /// @result True indicates the value was added.  False indicates the
+    ///         buffer is full.
+    [[nodiscard]] bool try_push(T &&value)
+    {
+        auto position = mEnqueuePosition.value.load(std::memory_order_relaxed);
+        Slot *slot{nullptr};
+        while (true)
+        {
+            slot = &mSlots[position & mMask];
+            auto sequence = slot->sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t> (sequence)
+                            - static_cast<intptr_t> (position);
+            if (difference == 0)
+            {
+                if constexpr (MultipleProducers)
+                {
+                    if (mEnqueuePosition.value.compare_exchange_weak(
+                            position, position + 1,
+                            std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    mEnqueuePosition.value.store(position + 1,
+                                                 std::memory_order_relaxed);
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // Full
+            }
+            else
+            {
+                position
+                    = mEnqueuePosition.value.load(std::memory_order_relaxed);
+            }
+        }
+        new (slot->storage) T(std::move(value));
+        slot->sequence.store(position + 1, std::memory_order_release);
+        if (mWakeUp){mWakeUp->signal();}
+        return true;
+    }
+    /// @brief Attempts to move the value at the front of the buffer.
+    /// @param[out] value  The value at the front of the buffer.
+    /// @result True indicates a value was popped.  False indicates the
+    ///         buffer was empty.
+    /// @note This may only be called by the consumer thread.
+    [[nodiscard]] bool try_pop(T *value)
+    {
+        auto position = mDequeuePosition.value.load(std::memory_order_relaxed);
+        auto &slot = mSlots[position & mMask];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1){return false;} // Empty
+        auto item = std::launder(reinterpret_cast<T *> (slot.storage));
+        *value = std::move(*item);
+        item->~T();
+        slot.sequence.store(position + mMask + 1, std::memory_order_release);
+        mDequeuePosition.value.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+    /// @result The value at the front of the buffer or nothing if the
+    ///         buffer was empty.
+    /// @note This may only be called by the consumer thread.
+    [[nodiscard]] std::optional<T> try_pop()
+    {
+        auto position = mDequeuePosition.value.load(std::memory_order_relaxed);
+        auto &slot = mSlots[position & mMask];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1){return std::nullopt;}
+        auto item = std::launder(reinterpret_cast<T *> (slot.storage));
+        std::optional<T> result{std::move(*item)};
+        item->~T();
+        slot.sequence.store(position + mMask + 1, std::memory_order_release);
+        mDequeuePosition.value.store(position + 1, std::memory_order_relaxed);
+        return result;
+    }
+    /// @brief Pops the value at the front of the buffer.  If the buffer is
+    ///        empty then this waits for a value to be pushed.
+    /// @param[out] value  The value from the front of the buffer.
+    /// @param[in] waitFor  The maximum amount of time to wait.
+    /// @result True indicates that the value was set whereas false indicates
+    ///         the wait timed out.
+    /// @note If the wake up is not enabled then this polls the buffer.
+    [[nodiscard]]
+    bool wait_until_and_pop(T *value,
+                            const std::chrono::milliseconds &waitFor
+                               = static_cast<std::chrono::milliseconds> (10))
+    {
+        if (try_pop(value)){return true;}
+        auto deadline = std::chrono::steady_clock::now() + waitFor;
+        while (true)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline){return try_pop(value);}
+            auto remaining
+                = std::chrono::duration_cast<std::chrono::milliseconds>
+                  (deadline - now);
+            if (mWakeUp)
+            {
+                mWakeUp->wait(std::max(remaining,
+                                       std::chrono::milliseconds {1}));
+            }
+            else
+            {
+                constexpr std::chrono::milliseconds pollInterval{1};
+                std::this_thread::sleep_for(std::min(remaining, pollInterval));
+            }
+            if (try_pop(value)){return true;}
+        }
+    }
+    /// @brief Resets the wake up signal.  The consumer should call this
+    ///        after the file descriptor polls readable and before draining
+    ///        the buffer.
+    void clearSignal() noexcept
+    {
+        if (mWakeUp){mWakeUp->clear();}
+    }
+    /// @result The file descriptor that becomes readable when a value is
+    ///         pushed or -1 if the wake up is not enabled.
+    [[nodiscard]] int getFileDescriptor() const noexcept
+    {
+        return mWakeUp ? mWakeUp->getFileDescriptor() : -1;
+    }
+    /// @result True indicates the buffer is empty.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+    /// @result The approximate number of values in the buffer.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        auto dequeuePosition
+            = mDequeuePosition.value.load(std::memory_order_relaxed);
+        auto enqueuePosition
+            = mEnqueuePosition.value.load(std::memory_order_relaxed);
+        if (enqueuePosition < dequeuePosition){return 0;}
+        return enqueuePosition - dequeuePosition;
+    }
+    /// @result The maximum number of values the buffer can hold.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return mMask + 1;
+    }
+    /// @brief Destructor.
+    ~RingBuffer()
+    {
+        while (try_pop().has_value()){}
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer& operator=(const RingBuffer &) = delete;
+private:
+    static constexpr size_t CACHE_LINE_SIZE{64};
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    // Keep the producer's and consumer's positions on separate cache lines
+    struct alignas(CACHE_LINE_SIZE) Position
+    {
+        std::atomic<size_t> value{0};
+    };
+    Position mEnqueuePosition;
+    Position mDequeuePosition;
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<Slot[]> mSlots;
+    size_t mMask{0};
+    std::unique_ptr<EventSignal> mWakeUp{nullptr};
+};
+
+/// @brief A ring buffer with a single producer and a single consumer.
+template<typename T>
+using SPSCRingBuffer = RingBuffer<T, false>;
+/// @brief A ring buffer with multiple producers and a single consumer.
+template<typename T>
+using MPSCRingBuffer = RingBuffer<T, true>;
+}
+#endif
+#endif
@@ -10,14 +10,24 @@ class PingRequest : public UMPS::MessageFormats::IMessage
 {
 public:
     /// Convert class to a message
-    [[nodiscard]] std::string toMessage() const final 
+    [[nodiscard]] std::string toMessage() const final
+    {
+        std::string message;
+        serializeInto(&message);
+        return message;
+    }
+    /// Convert class to a message and append it to the buffer
+    void serializeInto(std::string *message) const final
     {
+        if (message == nullptr)
+        {
+            throw std::invalid_argument("Message is NULL");
+        }
         nlohmann::json obj;
         obj["MessageType"] = getMessageType();
         obj["MessageVersion"] = getMessageVersion();
         obj["Time"] = static_cast<int64_t> (getTime().count());
-        auto v = nlohmann::json::to_cbor(obj);
-        return std::string{v.begin(), v.end()};
+        nlohmann::json::to_cbor(obj, *message);
     }
     /// Convert class from a mesage
     void fromMessage(const std::string &message) final
@@ -89,12 +99,22 @@ public:
     /// Convert class to a message
     [[nodiscard]] std::string toMessage() const final
     {
+        std::string message;
+        serializeInto(&message);
+        return message;
+    }
+    /// Convert class to a message and append it to the buffer
+    void serializeInto(std::string *message) const final
+    {
+        if (message == nullptr)
+        {
+            throw std::invalid_argument("Message is NULL");
+        }
         nlohmann::json obj;
         obj["MessageType"] = getMessageType();
         obj["MessageVersion"] = getMessageVersion();
         obj["Time"] = static_cast<int64_t> (getTime().count());
-        auto v = nlohmann::json::to_cbor(obj);
-        return std::string{v.begin(), v.end()};
+        nlohmann::json::to_cbor(obj, *message);
     }
     /// Convert class from a mesage
     void fromMessage(const std::string &message) final
@@ -9,13 +9,23 @@ class TerminateRequest : public UMPS::MessageFormats::IMessage
 {
 public:
     /// Convert class to a message
-    [[nodiscard]] std::string toMessage() const final 
+    [[nodiscard]] std::string toMessage() const final
+    {
+        std::string message;
+        serializeInto(&message);
+        return message;
+    }
+    /// Convert class to a message and append it to the buffer
+    void serializeInto(std::string *message) const final
     {
+        if (message == nullptr)
+        {
+            throw std::invalid_argument("Message is NULL");
+        }
         nlohmann::json obj;
         obj["MessageType"] = getMessageType();
         obj["MessageVersion"] = getMessageVersion();
-        auto v = nlohmann::json::to_cbor(obj);
-        return std::string{v.begin(), v.end()};
+        nlohmann::json::to_cbor(obj, *message);
     }
     /// Convert class from a mesage
     void fromMessage(const std::string &message) final
@@ -67,11 +77,21 @@ public:
     /// Convert class to a message
     [[nodiscard]] std::string toMessage() const final
     {
+        std::string message;
+        serializeInto(&message);
+        return message;
+    }
+    /// Convert class to a message and append it to the buffer
+    void serializeInto(std::string *message) const final
+    {
+        if (message == nullptr)
+        {
+            throw std::invalid_argument("Message is NULL");
+        }
         nlohmann::json obj;
         obj["MessageType"] = getMessageType();
         obj["MessageVersion"] = getMessageVersion();
-        auto v = nlohmann::json::to_cbor(obj);
-        return std::string{v.begin(), v.end()};
+        nlohmann::json::to_cbor(obj, *message);
     }
     /// Convert class from a mesage
     void fromMessage(const std::string &message) final
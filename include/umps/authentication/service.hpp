@@ -71,6 +71,24 @@ public:
     /// @}
 
 
+    /// @name Workers
+    /// @{
+
+    /// @brief Sets the number of threads that will process ZAP requests.
+    /// @param[in] nWorkers  The number of worker threads.  When this is 1
+    ///                      the requests are processed one at a time on the
+    ///                      thread that calls \c start().  Otherwise, the
+    ///                      requests are dealt to a pool of workers so that,
+    ///                      e.g., the password hashes of many PLAIN
+    ///                      handshakes can be verified concurrently.
+    /// @throws std::invalid_argument if nWorkers is not positive.
+    /// @throws std::runtime_error if \c isRunning() is true.
+    /// @note The authenticator must be thread safe when nWorkers exceeds 1.
+    void setNumberOfWorkers(int nWorkers);
+    /// @result The number of worker threads.  By default this is 1.
+    [[nodiscard]] int getNumberOfWorkers() const noexcept;
+    /// @}
+
     /// @name Service State
     /// @{
 
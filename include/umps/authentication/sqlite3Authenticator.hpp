@@ -20,6 +20,11 @@ namespace UMPS::Authentication
 {
 /// @class SQLite3Authenticator "sqlite3Authenticator.hpp" "umps/authentication/sqlite3Authenticator.hpp"
 /// @brief Performs user authentication against a SQLite3 database.
+/// @details The user table is indexed in memory when it is opened and
+///          re-indexed whenever it is modified, either by this class or by
+///          another process.  Verified user name and password pairs are
+///          cached so that the expensive password hash check is only
+///          performed the first time a client connects.
 /// @copyright Ben Baker (University of Utah) distributed under the MIT license.
 /// @ingroup Authentication_Authenticator
 class SQLite3Authenticator : public IAuthenticator
@@ -114,8 +119,11 @@ public:
     /// @{
 
     /// @brief Denies access to a certain IP address.
-    /// @param[in] address  The address to add to the blacklist.
-    /// @throws std::invalid_argument if the address is whitelisted or empty.
+    /// @param[in] address  The address to add to the blacklist.  This can
+    ///                     be an IPv4 or IPv6 address, a CIDR block, e.g.,
+    ///                     10.0.0.0/8, or an IPv4 wildcard, e.g., 10.*.
+    /// @throws std::invalid_argument if the address is whitelisted, empty,
+    ///         or cannot be parsed.
     void addToBlacklist(const std::string &address);
     /// @brief Removes an IP address from the blacklist.
     /// @param[in] address  The address to remove from the blacklist.
@@ -124,8 +132,11 @@ public:
     [[nodiscard]] std::pair<std::string, std::string> isBlacklisted(const std::string &address) const noexcept final;
 
     /// @brief Grants access to a certain IP address.
-    /// @param[in] address  The address to add to the whitelist.
-    /// @throws std::invalid_argument if the address is blacklisted or empty.
+    /// @param[in] address  The address to add to the whitelist.  This can
+    ///                     be an IPv4 or IPv6 address, a CIDR block, or an
+    ///                     IPv4 wildcard.
+    /// @throws std::invalid_argument if the address is blacklisted, empty,
+    ///         or cannot be parsed.
     void addToWhitelist(const std::string &address);
     /// @brief Removes an IP address from the whitelist.
     /// @param[in] address  The address to remove from the whitelist.
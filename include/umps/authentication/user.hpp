@@ -161,6 +161,11 @@ public:
     [[nodiscard]] std::unique_ptr<IMessage> createInstance() const noexcept final;
     /// @brief Serializes this class into a message.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Converts this message from a string to a class.
     void fromMessage(const std::string &message) final;
     /// @brief Converts this message from a string representation to a class.
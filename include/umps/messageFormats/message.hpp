@@ -1,6 +1,7 @@
 #ifndef UMPS_MESSAGE_FORMATS_MESSAGE_HPP
 #define UMPS_MESSAGE_FORMATS_MESSAGE_HPP
 #include <memory>
+#include <string>
 namespace UMPS::MessageFormats
 {
 /// @class IMessage "message.hpp" "umps/messageFormats/message.hpp"
@@ -23,6 +24,15 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] virtual std::string toMessage() const = 0;
+    /// @brief Converts this class to a string representation and appends
+    ///        it to the given buffer.  Since the buffer's memory is retained
+    ///        a sender can reuse one buffer for every message it sends.
+    /// @param[in,out] message  On exit, the class expressed in string format
+    ///                         has been appended to message.
+    /// @throws std::invalid_argument if message is NULL.
+    /// @note The default implementation appends the result of
+    ///       \c toMessage().
+    virtual void serializeInto(std::string *message) const;
     /// @brief Converts this message from a string representation to a class.
     virtual void fromMessage(const std::string &message) = 0;
     /// @brief Converts this message from a string representation to a class.
@@ -58,6 +58,11 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Creates the class from a message.
     /// @param[in] message  The contents of the message.
     /// @throws std::runtime_error if the message is invalid.
@@ -0,0 +1,62 @@
+#ifndef UMPS_MESSAGING_MESSAGE_VIEW_HPP
+#define UMPS_MESSAGING_MESSAGE_VIEW_HPP
+#include <string_view>
+#include <span>
+namespace UMPS::Messaging
+{
+/// @class MessageView "messageView.hpp" "umps/messaging/messageView.hpp"
+/// @brief A non-owning view of a received message's type and payload.
+/// @details The view references frames owned by the receiving socket.  It
+///          is therefore only valid until the next receive on that socket.
+///          The payload can be unpacked into a caller-owned message with
+///          \c message.fromMessage(view.data(), view.size()).
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class MessageView
+{
+public:
+    /// @brief Constructs an empty view.
+    MessageView() = default;
+    /// @brief Constructs a view of a received message.
+    /// @param[in] messageType  The message type (the topic frame).
+    /// @param[in] payload      The message payload.
+    MessageView(const std::string_view messageType,
+                const std::span<const char> payload) noexcept :
+        mMessageType(messageType),
+        mPayload(payload),
+        mHaveMessage(true)
+    {
+    }
+    /// @result The received message type.
+    [[nodiscard]] std::string_view getMessageType() const noexcept
+    {
+        return mMessageType;
+    }
+    /// @result The received message payload.
+    [[nodiscard]] std::span<const char> getPayload() const noexcept
+    {
+        return mPayload;
+    }
+    /// @result A pointer to the payload.  This is an array whose dimension
+    ///         is [size()].
+    [[nodiscard]] const char *data() const noexcept
+    {
+        return mPayload.data();
+    }
+    /// @result The length of the payload in bytes.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mPayload.size();
+    }
+    /// @result True indicates that no message was received, e.g., the
+    ///         receive timed out.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return !mHaveMessage;
+    }
+private:
+    std::string_view mMessageType;
+    std::span<const char> mPayload;
+    bool mHaveMessage{false};
+};
+}
+#endif
@@ -1,6 +1,7 @@
 #ifndef UMPS_MESSAGING_PUBLISHER_SUBSCRIBER_PUBLISHER_HPP
 #define UMPS_MESSAGING_PUBLISHER_SUBSCRIBER_PUBLISHER_HPP
 #include <memory>
+#include <span>
 // Forward declarations
 namespace UMPS
 {
@@ -89,6 +90,15 @@ public:
     /// @throws std::runtime_error if the class is not initialized.
     /// @throws std::invalid_argument if the message cannot be serialized.
     void send(const MessageFormats::IMessage &message);
+    /// @brief Sends a batch of messages.  The messages are serialized into
+    ///        a single buffer that is reused between batches and then put
+    ///        on the wire one after the other.  This is more efficient than
+    ///        calling \c send() for each message in a burst.
+    /// @param[in] messages  The messages to send.
+    /// @throws std::runtime_error if the class is not initialized.
+    /// @throws std::invalid_argument if any message is NULL or cannot be
+    ///         serialized.  In this case, no messages are sent.
+    void sendBatch(std::span<const MessageFormats::IMessage * const> messages);
 
     /// @name Destructors
     /// @{
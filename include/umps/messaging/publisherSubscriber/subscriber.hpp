@@ -1,7 +1,9 @@
 #ifndef UMPS_MESSAGING_PUBLISHER_SUBSCRIBER_SUBSCRIBER_HPP
 #define UMPS_MESSAGING_PUBLISHER_SUBSCRIBER_SUBSCRIBER_HPP
 #include <memory>
+#include <cstdint>
 #include "umps/authentication/enums.hpp"
+#include "umps/messaging/messageView.hpp"
 // Forward declarations
 namespace UMPS
 {
@@ -81,8 +83,53 @@ public:
     [[nodiscard]] Services::ConnectionInformation::SocketDetails::Subscriber getSocketDetails() const;
 
     /// @brief Receives a message.
+    /// @result The received message.  If the receive timed out then this
+    ///         will be NULL.
     /// @throws std::invalid_argument if the message cannot be serialized.
+    /// @note The message may be an instance previously handed back with
+    ///       \c recycle().
     [[nodiscard]] std::unique_ptr<MessageFormats::IMessage> receive() const;
+    /// @brief Hands a message obtained from \c receive() back to the
+    ///        subscriber so that its memory can be reused by a later
+    ///        \c receive().
+    /// @param[in,out] message  The message to recycle.  On exit, this is
+    ///                         NULL.
+    void recycle(std::unique_ptr<MessageFormats::IMessage> &&message) const;
+    /// @brief Receives a message and unpacks it into a caller-owned message.
+    ///        Since the message and the socket's frames are reused this
+    ///        does not allocate a new message on each receive.
+    /// @param[in,out] message  On input, an instance of a subscribed-to
+    ///                         message type.  On exit, if the result is true,
+    ///                         this contains the received message.
+    /// @result True indicates a message was received and unpacked.  False
+    ///         indicates the receive timed out.
+    /// @throws std::invalid_argument if message is NULL or its type is not
+    ///         a subscribed-to message type.
+    /// @throws std::runtime_error if the received message type differs from
+    ///         message's type.  For subscribers to multiple message types
+    ///         use \c receiveView().
+    [[nodiscard]] bool receive(MessageFormats::IMessage *message) const;
+    /// @brief Receives a message without copying or unpacking it.
+    /// @result A view of the received message type and payload.  If the
+    ///         receive timed out then the view will be empty.
+    /// @note The view refers to memory owned by this class and is only
+    ///       valid until the next receive.
+    [[nodiscard]] MessageView receiveView() const;
+
+    /// @name Gap Detection
+    /// @brief When publishers send sequence numbers the subscriber can tell
+    ///        how many messages it missed, e.g., because a high water mark
+    ///        was hit.  These are reset by \c initialize().
+    /// @{
+
+    /// @result The number of received messages that had a sequence number.
+    [[nodiscard]] uint64_t getNumberOfSequencedMessages() const noexcept;
+    /// @result The number of messages that were missed.
+    [[nodiscard]] uint64_t getNumberOfMissedMessages() const noexcept;
+    /// @result The number of gaps in the received sequence numbers.  A gap
+    ///         may span many messages.
+    [[nodiscard]] uint64_t getNumberOfGaps() const noexcept;
+    /// @}
 
     /// @brief Disconnects the subscriber.
     /// @note The class will have to be reinitialized to connect.
@@ -3,6 +3,9 @@
 #include <memory>
 #include <string>
 #include <chrono>
+#include <string_view>
+#include <functional>
+#include <cstdint>
 namespace UMPS::MessageFormats
 {
  class IMessage;
@@ -96,6 +99,24 @@ public:
     [[nodiscard]] std::chrono::milliseconds getReceiveTimeOut() const noexcept;
     /// @}
 
+    /// @name Gap Detection
+    /// @{
+
+    /// @brief Sets a function that is called when the subscriber detects
+    ///        that it missed messages, e.g., because a high water mark was
+    ///        hit.  This requires publishers that send sequence numbers.
+    /// @param[in] callback  Called on the receiving thread with the
+    ///                      publisher's identifier, the message type, and
+    ///                      the number of missed messages.
+    void setGapCallback(
+        const std::function<void (uint64_t publisher,
+                                  std::string_view messageType,
+                                  uint64_t nMissed)> &callback);
+    /// @result The gap callback.  By default this is empty.
+    [[nodiscard]] std::function<void (uint64_t, std::string_view, uint64_t)>
+        getGapCallback() const;
+    /// @}
+
     /// @name ZeroMQ Authentication Protocol Options
     /// @{
 
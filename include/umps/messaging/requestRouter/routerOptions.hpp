@@ -158,6 +158,26 @@ public:
     [[nodiscard]] std::chrono::milliseconds getPollTimeOut() const noexcept;
     /// @}
 
+    /// @name Workers
+    /// @{
+
+    /// @brief Sets the number of worker threads that run the callback.
+    /// @details By default the router's polling thread runs the callback.
+    ///          Consequently, a slow callback stalls every client.  When
+    ///          the number of workers exceeds one, the router instead hands
+    ///          requests over an inproc ROUTER/DEALER pair to this many
+    ///          worker threads.  The reply envelope is preserved so each
+    ///          reply is routed to the client that made the request.
+    /// @param[in] nWorkers  The number of worker threads.
+    /// @throws std::invalid_argument if nWorkers is not positive.
+    /// @note When using more than one worker the callback must be
+    ///       thread safe.
+    void setNumberOfWorkers(int nWorkers);
+    /// @result The number of worker threads.  The default is 1 which
+    ///         indicates the callback is run on the polling thread.
+    [[nodiscard]] int getNumberOfWorkers() const noexcept;
+    /// @}
+
     /// @name Destructors
     /// @{
 
@@ -0,0 +1,165 @@
+#ifndef UMPS_MESSAGING_ROUTER_DEALER_ASYNCHRONOUS_REQUEST_HPP
+#define UMPS_MESSAGING_ROUTER_DEALER_ASYNCHRONOUS_REQUEST_HPP
+#include <memory>
+#include <future>
+#include <functional>
+#include "umps/authentication/enums.hpp"
+// Forward declarations
+namespace UMPS
+{
+ namespace Logging
+ {
+  class ILog;
+ }
+ namespace MessageFormats
+ {
+  class IMessage;
+ }
+ namespace Messaging
+ {
+  class Context;
+  namespace RouterDealer
+  {
+   class RequestOptions;
+  }
+ }
+ namespace Services::ConnectionInformation::SocketDetails
+ {
+  class Dealer;
+ }
+}
+namespace UMPS::Messaging::RouterDealer
+{
+/// @class AsynchronousRequest "asynchronousRequest.hpp" "umps/messaging/routerDealer/asynchronousRequest.hpp"
+/// @brief A pipelined requestor for use in the router-dealer combination.
+/// @details Unlike the \c Request, which must wait for the reply to a request
+///          before making the next request, this class allows for many
+///          requests to be in flight at once.  This is useful when the
+///          round-trip time to the servers is large compared to the time
+///          it takes the servers to process a request.
+///
+///          Under the hood this is a DEALER socket that prefixes each
+///          request with a correlation identifier.  Since a REP socket
+///          returns all frames that precede the empty delimiter frame to
+///          the sender, the servers need not be modified and the
+///          correlation identifier is used to match each reply to its
+///          request.  The sending and receiving is performed on a
+///          background thread owned by this class.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+/// @ingroup MessagingPatterns_ReqRep_RouterDealer
+class AsynchronousRequest
+{
+public:
+    /// @brief The function that is called when a request completes.
+    ///        The response will be NULL if the request timed out, the
+    ///        response could not be unpacked, or the requestor was
+    ///        disconnected before the response arrived.
+    using Callback
+        = std::function<void (std::unique_ptr<UMPS::MessageFormats::IMessage> &&)>;
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    AsynchronousRequest();
+    /// @brief Constructs a requestor with the given logger.
+    /// @param[in] logger  A pointer to the application's logger.
+    explicit AsynchronousRequest(std::shared_ptr<UMPS::Logging::ILog> &logger);
+    /// @brief Constructs a requestor with a given ZeroMQ context.
+    /// @param[in] context  The context from which to initialize.
+    explicit AsynchronousRequest(
+        std::shared_ptr<UMPS::Messaging::Context> &context);
+    /// @brief Constructs a requestor with the given context and logger.
+    AsynchronousRequest(std::shared_ptr<UMPS::Messaging::Context> &context,
+                        std::shared_ptr<UMPS::Logging::ILog> &logger);
+    /// @brief Move constructor.
+    /// @param[in,out] request  The requestor class from which to initialize
+    ///                         this class.  On exit, request's behavior is
+    ///                         undefined.
+    AsynchronousRequest(AsynchronousRequest &&request) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Move assignment operator.
+    /// @param[in,out] request  The request class whose memory will be moved
+    ///                         to this.  On exit, request's behavior is
+    ///                         undefined.
+    /// @result The memory from request moved to this.
+    AsynchronousRequest& operator=(AsynchronousRequest &&request) noexcept;
+    /// @}
+
+    /// @name Step 1: Initialization
+    /// @{
+
+    /// @brief Initializes the requestor and starts the background thread
+    ///        that sends requests and receives responses.
+    /// @param[in] options   The request options.  The receive time out
+    ///                      is applied to each request individually and
+    ///                      the maximum number of outstanding requests
+    ///                      defines the window.
+    /// @throws std::invalid_argument if the address or message formats
+    ///         are not set.
+    void initialize(const RequestOptions &options);
+    /// @result True indicates the class is initialized.
+    [[nodiscard]] bool isInitialized() const noexcept;
+    /// @result The details for connecting to this socket.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] Services::ConnectionInformation::SocketDetails::Dealer getSocketDetails() const;
+    /// @}
+
+    /// @name Step 2: Request
+    /// @{
+
+    /// @brief Submits a request to the router.
+    /// @param[in] request  The request to make to the server via the router.
+    /// @result A future that will hold the response to the request.  The
+    ///         response will be NULL if the request timed out or the
+    ///         requestor was disconnected.  If the response could not be
+    ///         unpacked then the future will hold the exception.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    /// @note If the window is full then this will block until a response
+    ///       arrives or an outstanding request times out.
+    [[nodiscard]]
+    std::future<std::unique_ptr<UMPS::MessageFormats::IMessage>> request(
+        const MessageFormats::IMessage &request);
+    /// @brief Submits a request to the router.
+    /// @param[in] request   The request to make to the server via the router.
+    /// @param[in] callback  The function to call with the response.  This
+    ///                      is called from the requestor's background thread
+    ///                      so it should be quick.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    /// @throws std::invalid_argument if the callback is not set.
+    /// @note If the window is full then this will block until a response
+    ///       arrives or an outstanding request times out.
+    void request(const MessageFormats::IMessage &request,
+                 const Callback &callback);
+    /// @result The number of requests that are awaiting a response.
+    [[nodiscard]] int getNumberOfOutstandingRequests() const noexcept;
+    /// @}
+
+    /// @name Step 3: Disconnecting
+    /// @{
+
+    /// @brief Disconnects the requestor from the router-dealer.  Any
+    ///        outstanding requests will complete with a NULL response.
+    /// @note This step is optional as it will be done by the destructor.
+    void disconnect();
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Destructor.
+    ~AsynchronousRequest();
+    /// @}
+
+    AsynchronousRequest(const AsynchronousRequest &request) = delete;
+    AsynchronousRequest& operator=(const AsynchronousRequest &request) = delete;
+private:
+    class AsynchronousRequestImpl;
+    std::unique_ptr<AsynchronousRequestImpl> pImpl;
+};
+}
+#endif
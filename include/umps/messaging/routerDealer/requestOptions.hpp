@@ -134,9 +134,21 @@ public:
     [[nodiscard]] std::chrono::milliseconds getReceiveTimeOut() const noexcept;
     /// @}
 
-    /// @name Time Out
+    /// @name Outstanding Requests
     /// @{
 
+    /// @brief Sets the maximum number of requests that an asynchronous
+    ///        requestor can have in flight at any time.
+    /// @param[in] nRequests  The window size.  When this many requests are
+    ///                       awaiting responses then subsequent requests
+    ///                       will block until a response arrives or an
+    ///                       outstanding request times out.
+    /// @throws std::invalid_argument if nRequests is not positive.
+    /// @note This is ignored by the blocking \c Request.
+    void setMaximumNumberOfOutstandingRequests(int nRequests);
+    /// @result The maximum number of outstanding requests.  The default
+    ///         is 32.
+    [[nodiscard]] int getMaximumNumberOfOutstandingRequests() const noexcept;
     /// @}
 
     /// @name Destructors
@@ -98,6 +98,14 @@ public:
     /// @brief Stops the proxy.
     /// @note You will have to reinitialize after calling this.
     void stop();
+    /// @result The number of messages, bytes, high water mark drops, and
+    ///         subscribers for each topic as a JSON object, e.g.,
+    ///         {"Topics":[{"Topic":"...","Messages":10,"Bytes":2048,
+    ///                     "Drops":0,"Subscribers":2}]}.
+    /// @throws std::runtime_error if \c isRunning() is false, the topic
+    ///         statistics were not enabled in the options, or the proxy
+    ///         does not respond.
+    [[nodiscard]] std::string getStatistics() const;
 
     /// @}
 
@@ -2,6 +2,10 @@
 #define UMPS_XPUBLISHER_XSUBSCRIBER_PROXY_OPTIONS_HPP
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstdint>
 namespace UMPS::Authentication
 {
  class ZAPOptions;
@@ -97,8 +101,149 @@ public:
     /// @result The high water mark.  The default is 0 (infinite).
     [[nodiscard]] int getBackendHighWaterMark() const noexcept;
 
+    /// @brief By default the backend silently drops a message for any
+    ///        subscriber at its high water mark and delivers it to the
+    ///        others.  This instead refuses a message unless every
+    ///        subscriber has room for it.  With topic statistics enabled the
+    ///        refused messages are counted as drops.
+    /// @note This requires the proxy's forwarding loop so it enables
+    ///       the loop even when no other instrumentation is enabled.
+    void enableBackendNoDrop() noexcept;
+    /// @brief Uses ZeroMQ's default high water mark behavior.  This is the
+    ///        default.
+    void disableBackendNoDrop() noexcept;
+    /// @result True indicates the backend refuses messages that some
+    ///         subscriber has no room for.
+    [[nodiscard]] bool backendNoDrop() const noexcept;
+
     /// @}
  
+    /// @name Instrumentation
+    /// @{
+
+    /// @brief Forwards messages with a loop that counts the messages, bytes,
+    ///        high water mark drops, and subscribers for each topic.  The
+    ///        counters are available from \c Proxy::getStatistics().
+    /// @note This does not change how messages are delivered.  High water
+    ///       mark drops are only observable, and hence counted, when
+    ///       \c enableBackendNoDrop() is also set.
+    void enableTopicStatistics() noexcept;
+    /// @brief Forwards messages with ZeroMQ's proxy.  This is the default.
+    void disableTopicStatistics() noexcept;
+    /// @result True indicates the proxy collects statistics for each topic.
+    [[nodiscard]] bool collectTopicStatistics() const noexcept;
+
+    /// @brief Forwards messages with a loop that tracks which topics the
+    ///        subscribers want.  The proxy subscribes to each topic once on
+    ///        behalf of all its subscribers and discards messages on any
+    ///        other topic before they are fanned out to the subscribers.
+    /// @note This cannot be combined with the last-value cache.
+    void enableTopicFiltering() noexcept;
+    /// @brief Disables the topic filtering.  This is the default.
+    void disableTopicFiltering() noexcept;
+    /// @result True indicates the proxy filters topics.
+    [[nodiscard]] bool filterTopics() const noexcept;
+
+    /// @}
+
+    /// @name Last-Value Cache
+    /// @{
+
+    /// @brief Keeps the most recent message on each topic.  A late joining
+    ///        subscriber can request the cached messages that match its
+    ///        subscriptions from the snapshot address so it sees the current
+    ///        state without waiting for the next publication.
+    /// @param[in] capacity  The maximum number of messages to cache.  When
+    ///                      the cache is full the message that was updated
+    ///                      least recently is evicted.  0 disables the cache.
+    /// @throws std::invalid_argument if the capacity is negative.
+    /// @note To see every topic the proxy subscribes to all messages from
+    ///       the publishers.  Hence, the cache cannot be combined with
+    ///       \c enableTopicFiltering() and requires a snapshot address.
+    /// @sa setSnapshotAddress()
+    void setLastValueCacheCapacity(int capacity);
+    /// @result The maximum number of messages in the last-value cache.
+    ///         By default this is 0 (disabled).
+    [[nodiscard]] int getLastValueCacheCapacity() const noexcept;
+    /// @result True indicates the proxy has a last-value cache.
+    [[nodiscard]] bool haveLastValueCache() const noexcept;
+
+    /// @brief Sets the maximum size of the cached messages.
+    /// @param[in] maximumBytes  The maximum number of bytes in all the cached
+    ///                          messages' frames.  A larger message is not
+    ///                          cached.
+    /// @throws std::invalid_argument if this is not positive.
+    void setLastValueCacheMaximumBytes(int64_t maximumBytes);
+    /// @result The maximum size of the cached messages.  By default this
+    ///         is 16 MB.
+    [[nodiscard]] int64_t getLastValueCacheMaximumBytes() const noexcept;
+
+    /// @brief Caches the most recent message for each key on a topic
+    ///        instead of for each topic.
+    /// @param[in] keyExtractor  Given the topic and the frame after the
+    ///                          topic this returns the key.  For example,
+    ///                          this may unpack the module name from a
+    ///                          heartbeat.  If this throws then the message
+    ///                          is cached by its topic.
+    /// @note The extractor is called for every forwarded message so it
+    ///       should be inexpensive.
+    void setLastValueCacheKeyExtractor(
+        const std::function<std::string (std::string_view topic,
+                                         std::string_view message)> &keyExtractor);
+    /// @result The key extractor.  By default this is empty and messages
+    ///         are cached by topic.
+    [[nodiscard]] std::function<std::string (std::string_view, std::string_view)>
+        getLastValueCacheKeyExtractor() const;
+
+    /// @brief Sets the address to which subscribers connect to request the
+    ///        cached messages.  Only the requesting subscriber receives the
+    ///        snapshot so the other subscribers never see repeats.
+    /// @param[in] address  The address to which subscribers will connect.
+    /// @throws std::invalid_argument if the address is empty.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::Subscriber::requestSnapshot()
+    void setSnapshotAddress(const std::string &address);
+    /// @result The snapshot address.
+    /// @throws std::invalid_argument if \c haveSnapshotAddress() is false.
+    [[nodiscard]] std::string getSnapshotAddress() const;
+    /// @result True indicates the snapshot address was set.
+    [[nodiscard]] bool haveSnapshotAddress() const noexcept;
+
+    /// @}
+
+    /// @name Federation
+    /// @{
+
+    /// @brief Lets proxies be chained so that broadcasts can be fanned out
+    ///        across machines.  A message that a publisher sends directly to
+    ///        this proxy is stamped with this proxy's origin identifier and a
+    ///        sequence number in a frame after the payload.  Messages that
+    ///        were already stamped are forwarded once and repeats, e.g., from
+    ///        a loop or from two paths to the same origin, are dropped.
+    /// @note A federated proxy subscribes to everything its upstream proxies
+    ///       publish and only forwards its own subscribers' subscriptions to
+    ///       its publishers.  Subscriptions therefore never travel between
+    ///       proxies and an unsubscription is not held up by a loop.  The
+    ///       cost is that a proxy with downstream proxies receives
+    ///       everything from its publishers.  Every proxy in the network
+    ///       must be federated.
+    void enableFederation() noexcept;
+    /// @brief Disables federation.  This is the default.
+    void disableFederation() noexcept;
+    /// @result True indicates the proxy is federated.
+    [[nodiscard]] bool isFederated() const noexcept;
+
+    /// @brief Adds an upstream proxy.  The proxy connects to the upstream
+    ///        proxy's backend and forwards everything it publishes.
+    /// @param[in] address  The address of the upstream proxy's backend.
+    /// @throws std::invalid_argument if the address is empty.
+    /// @note The connection uses the frontend's ZAP options.  This proxy
+    ///       and the upstream proxy must be federated.
+    void addUpstreamProxy(const std::string &address);
+    /// @result The addresses of the upstream proxies' backends.
+    [[nodiscard]] std::vector<std::string> getUpstreamProxies() const;
+
+    /// @}
+
     /// @name ZeroMQ Authentication Protocol Options
     /// @{
 
@@ -1,6 +1,7 @@
 #ifndef UMPS_MESSAGING_XPUBLISHER_XSUBSCRIBER_PUBLISHER_HPP
 #define UMPS_MESSAGING_XPUBLISHER_XSUBSCRIBER_PUBLISHER_HPP
 #include <memory>
+#include <span>
 #include "umps/authentication/enums.hpp"
 // Forward declarations
 namespace UMPS
@@ -99,6 +100,15 @@ public:
     /// @throws std::runtime_error if \c isInitialized() is false.
     /// @note This will serialize the message prior to sending it.
     void send(const MessageFormats::IMessage &message);
+    /// @brief Sends a batch of messages.  The messages are serialized into
+    ///        a single buffer that is reused between batches and then put
+    ///        on the wire one after the other.  This is more efficient than
+    ///        calling \c send() for each message in a burst.
+    /// @param[in] messages  The messages to send.
+    /// @throws std::runtime_error if the class is not initialized.
+    /// @throws std::invalid_argument if any message is NULL or cannot be
+    ///         serialized.  In this case, no messages are sent.
+    void sendBatch(std::span<const MessageFormats::IMessage * const> messages);
 
     /// @brief Closes the connection.
     /// @note The class will need to be initialized again to restore the
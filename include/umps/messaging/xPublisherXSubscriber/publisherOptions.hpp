@@ -80,6 +80,18 @@ public:
     void setTimeOut(const std::chrono::milliseconds &timeOut) noexcept;
     /// @result The time out duration in milliseconds.
     [[nodiscard]] std::chrono::milliseconds getTimeOut() const noexcept;
+
+    /// @brief Appends a frame with this publisher's identifier and a
+    ///        sequence number to each message.  The numbers are counted per
+    ///        message type so a subscriber can tell how many messages it
+    ///        missed, e.g., because a high water mark was hit.
+    /// @note Subscribers built before this frame was introduced reject
+    ///       these messages.
+    void enableSequenceNumbers() noexcept;
+    /// @brief Sends messages without sequence numbers.  This is the default.
+    void disableSequenceNumbers() noexcept;
+    /// @result True indicates messages are sent with sequence numbers.
+    [[nodiscard]] bool sendSequenceNumbers() const noexcept;
     /// @}
 
     /// @name ZeroMQ Authentication Protocol Options
@@ -1,6 +1,8 @@
 #ifndef UMPS_MESSAGING_XPUBLISHER_XSUBSCRIBER_SUBSCRIBER_HPP
 #define UMPS_MESSAGING_XPUBLISHER_XSUBSCRIBER_SUBSCRIBER_HPP
 #include <memory>
+#include <vector>
+#include <cstdint>
 // Forward declarations
 namespace UMPS
 {
@@ -82,6 +84,38 @@ public:
     /// @brief Receives a message.
     /// @throws std::invalid_argument if the message cannot be serialized.
     [[nodiscard]] std::unique_ptr<MessageFormats::IMessage> receive() const;
+    /// @brief Hands a message obtained from \c receive() back to the
+    ///        subscriber so that its memory can be reused by a later
+    ///        \c receive().
+    /// @param[in,out] message  The message to recycle.  On exit, this is
+    ///                         NULL.
+    void recycle(std::unique_ptr<MessageFormats::IMessage> &&message) const;
+    /// @brief Requests the latest messages of the subscribed types from the
+    ///        proxy's last-value cache.  Only this subscriber receives them.
+    /// @result The cached messages.  This may be empty.
+    /// @throws std::runtime_error if the class is not initialized, the
+    ///         snapshot address was not set on the options, or the proxy
+    ///         does not reply within the receive time out.
+    /// @note Request the snapshot after initializing so that nothing
+    ///       published in between is missed.  Consequently, a message may
+    ///       be in both the snapshot and the live stream.
+    [[nodiscard]] std::vector<std::unique_ptr<MessageFormats::IMessage>>
+        requestSnapshot() const;
+
+    /// @name Gap Detection
+    /// @brief When publishers send sequence numbers the subscriber can tell
+    ///        how many messages it missed, e.g., because a high water mark
+    ///        was hit.  These are reset by \c initialize().
+    /// @{
+
+    /// @result The number of received messages that had a sequence number.
+    [[nodiscard]] uint64_t getNumberOfSequencedMessages() const noexcept;
+    /// @result The number of messages that were missed.
+    [[nodiscard]] uint64_t getNumberOfMissedMessages() const noexcept;
+    /// @result The number of gaps in the received sequence numbers.  A gap
+    ///         may span many messages.
+    [[nodiscard]] uint64_t getNumberOfGaps() const noexcept;
+    /// @}
 
     /// @brief Disconnects the subscriber.
     /// @note The class will have to be reinitialized to connect.
@@ -3,6 +3,9 @@
 #include <memory>
 #include <string>
 #include <chrono>
+#include <string_view>
+#include <functional>
+#include <cstdint>
 namespace UMPS::MessageFormats
 {
  class IMessage;
@@ -96,6 +99,36 @@ public:
     void setReceiveTimeOut(const std::chrono::milliseconds &timeOut) noexcept;
     /// @result The time out duration in milliseconds.
     [[nodiscard]] std::chrono::milliseconds getReceiveTimeOut() const noexcept;
+
+    /// @brief Sets the proxy's snapshot address from which the subscriber
+    ///        can request the proxy's last-value cache.
+    /// @param[in] address  The address of the proxy's snapshot socket.
+    /// @throws std::invalid_argument if the address is empty.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::setSnapshotAddress()
+    void setSnapshotAddress(const std::string &address);
+    /// @result The snapshot address.
+    /// @throws std::invalid_argument if \c haveSnapshotAddress() is false.
+    [[nodiscard]] std::string getSnapshotAddress() const;
+    /// @result True indicates the snapshot address was set.
+    [[nodiscard]] bool haveSnapshotAddress() const noexcept;
+    /// @}
+
+    /// @name Gap Detection
+    /// @{
+
+    /// @brief Sets a function that is called when the subscriber detects
+    ///        that it missed messages, e.g., because a high water mark was
+    ///        hit.  This requires publishers that send sequence numbers.
+    /// @param[in] callback  Called on the receiving thread with the
+    ///                      publisher's identifier, the message type, and
+    ///                      the number of missed messages.
+    void setGapCallback(
+        const std::function<void (uint64_t publisher,
+                                  std::string_view messageType,
+                                  uint64_t nMissed)> &callback);
+    /// @result The gap callback.  By default this is empty.
+    [[nodiscard]] std::function<void (uint64_t, std::string_view, uint64_t)>
+        getGapCallback() const;
     /// @}
 
     /// @name ZeroMQ Authentication Protocol Options
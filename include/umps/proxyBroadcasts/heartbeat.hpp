@@ -1,5 +1,6 @@
 #ifndef UMPS_PROXY_BROADCASTS_HEARTBEAT_HPP
 #define UMPS_PROXY_BROADCASTS_HEARTBEAT_HPP
+#include <umps/proxyBroadcasts/heartbeat/aggregator.hpp>
 #include <umps/proxyBroadcasts/heartbeat/publisher.hpp>
 #include <umps/proxyBroadcasts/heartbeat/publisherOptions.hpp>
 #include <umps/proxyBroadcasts/heartbeat/publisherProcess.hpp>
@@ -0,0 +1,110 @@
+#ifndef UMPS_PROXY_BROADCASTS_HEARTBEAT_AGGREGATOR_HPP
+#define UMPS_PROXY_BROADCASTS_HEARTBEAT_AGGREGATOR_HPP
+#include <memory>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "umps/modules/process.hpp"
+namespace UMPS
+{
+ namespace Logging
+ {
+  class ILog;
+ }
+ namespace ProxyBroadcasts::Heartbeat
+ {
+  class Status;
+  class Subscriber;
+ }
+}
+namespace UMPS::ProxyBroadcasts::Heartbeat
+{
+/// @class Aggregator "aggregator.hpp" "umps/proxyBroadcasts/heartbeat/aggregator.hpp"
+/// @brief Subscribes to the heartbeat broadcast and tracks the latest status
+///        of every module.  A module that is alive but does not send a
+///        heartbeat within the time out is flagged as stale.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+/// @ingroup UMPS_ProxyBroadcasts_Heartbeat
+class Aggregator : public UMPS::Modules::IProcess
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    Aggregator();
+    /// @brief Constructor with a given logger.
+    explicit Aggregator(std::shared_ptr<UMPS::Logging::ILog> &logger);
+    /// @}
+
+    /// @name Step 1: Initialization
+    /// @{
+
+    /// @brief Initializes the aggregator.
+    /// @param[in] subscriberConnection  The connection to the heartbeat
+    ///                                  broadcast.
+    /// @param[in] timeOut  A module that is alive is considered stale if
+    ///                     no heartbeat is received in this amount of time.
+    ///                     This should be a few heartbeat intervals.
+    /// @throws std::invalid_argument if \c connection->isInitialized() is
+    ///         false or the time out is not positive.
+    void initialize(std::unique_ptr<Subscriber> &&subscriberConnection,
+                    const std::chrono::milliseconds &timeOut = std::chrono::milliseconds {90000});
+    /// @result True indicates the aggregator is initialized.
+    [[nodiscard]] bool isInitialized() const noexcept;
+    /// @result The name of the process.
+    [[nodiscard]] std::string getName() const noexcept override;
+    /// @}
+
+    /// @name Step 2: Start the Process
+    /// @{
+
+    /// @brief Starts receiving heartbeats.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    void start() override;
+    /// @result True indicates the process is running.
+    [[nodiscard]] bool isRunning() const noexcept override;
+    /// @}
+
+    /// @name Module Statuses
+    /// @{
+
+    /// @brief Records a status that was received elsewhere.
+    /// @param[in] status  The module's status.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    void update(const Status &status);
+    /// @result The latest status of every module that has sent a heartbeat.
+    /// @note This is shared and only rebuilt after the statuses change so
+    ///       it is inexpensive to call frequently.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::shared_ptr<const std::vector<Status>> getStatuses() const;
+    /// @result The modules that are alive but have not sent a heartbeat
+    ///         within the time out.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::vector<std::string> getStaleModules() const;
+    /// @}
+
+    /// @name Step 3: Stop the Process
+    /// @{
+
+    /// @brief Stops receiving heartbeats.
+    void stop() override;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Destructor.
+    ~Aggregator() override;
+    /// @}
+
+    Aggregator(const Aggregator &) = delete;
+    Aggregator(Aggregator &&) noexcept = delete;
+    Aggregator& operator=(const Aggregator &) = delete;
+    Aggregator& operator=(Aggregator &&) noexcept = delete;
+private:
+    class AggregatorImpl;
+    std::unique_ptr<AggregatorImpl> pImpl;
+};
+}
+#endif
@@ -89,6 +89,14 @@ public:
     void setTimeOut(const std::chrono::milliseconds timeOut) noexcept;
     /// @result The time out duration in milliseconds.
     [[nodiscard]] std::chrono::milliseconds getTimeOut() const noexcept;
+
+    /// @brief Sends statuses in the compact binary format instead of CBOR.
+    /// @param[in] binaryFormat  True sends the binary format.
+    /// @note All subscribers must understand the binary format.
+    void setBinaryFormat(bool binaryFormat) noexcept;
+    /// @result True indicates statuses are sent in the binary format.
+    ///         By default this is false and statuses are sent as CBOR.
+    [[nodiscard]] bool useBinaryFormat() const noexcept;
     /// @}
 
     /// @name ZeroMQ Authentication Protocol Options
@@ -1,6 +1,7 @@
 #ifndef UMPS_PROXY_BROADCASTS_HEARTBEAT_STATUS_HPP
 #define UMPS_PROXY_BROADCASTS_HEARTBEAT_STATUS_HPP
 #include <memory>
+#include <chrono>
 #include <ostream>
 #include "umps/messageFormats/message.hpp"
 namespace UMPS::ProxyBroadcasts::Heartbeat
@@ -84,21 +85,33 @@ public:
     /// @throws std::invalid_argument if the time stamp is incorrectly
     ///         formatted.
     void setTimeStamp(const std::string &timeStamp);
+    /// @brief Sets the time stamp.
+    /// @param[in] timeStamp  The UTC time in microseconds since the epoch.
+    void setTimeStamp(const std::chrono::microseconds &timeStamp) noexcept;
     /// @brief Sets the time stamp to now.
     void setTimeStampToNow() noexcept;
-    /// @result The time stamp.
+    /// @result The time stamp with the format YYYY-MM-DDTHH:MM:SS.sss.
     [[nodiscard]] std::string getTimeStamp() const noexcept;
+    /// @result The UTC time stamp in microseconds since the epoch.
+    [[nodiscard]] std::chrono::microseconds getTimeStampInMicroSeconds() const noexcept;
  
     /// @name Message Abstract Base Class Properties
     /// @{
     /// @brief Converts the heartbeat class to a string message.
-    /// @result The class expressed as a string message.
+    /// @result The class expressed as a string message.  This is the
+    ///         CBOR format created by \c toCBOR().
     /// @throws std::runtime_error if the required information is not set. 
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Creates the class from a message.
-    /// @param[in] message   The status message.
+    /// @param[in] message   The status message.  This may be CBOR or, for
+    ///                      publishers that opted in, the binary format.
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argmument if message.empty() is true.
     void fromMessage(const std::string &message) final;
@@ -146,6 +159,34 @@ public:
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argument if data is NULL or length is 0.
     void fromCBOR(const uint8_t *data, size_t length);
+    /// @brief Converts the status class to the compact binary format.
+    /// @details The binary format is a fixed layout with an integer time
+    ///          stamp so subscribers can unpack it without any parsing.
+    ///          Publishers only send it when
+    ///          \c PublisherOptions::setBinaryFormat() is enabled.
+    /// @result The class expressed in the binary format.
+    /// @throws std::runtime_error if the module or host name exceeds
+    ///         65535 characters.
+    [[nodiscard]] std::string toBinary() const;
+    /// @brief Appends the binary format to the message.  This lets the
+    ///        caller reuse its buffer.
+    /// @param[in,out] message  On exit, the binary format is appended to
+    ///                         the message.
+    /// @throws std::invalid_argument if message is NULL.
+    /// @throws std::runtime_error if the module or host name exceeds
+    ///         65535 characters.
+    void serializeBinaryInto(std::string *message) const;
+    /// @brief Creates the class from a binary message.
+    /// @param[in] data  The binary message.
+    /// @throws std::invalid_argument if the message is invalid.
+    void fromBinary(const std::string &data);
+    /// @brief Creates the class from a binary message.
+    /// @param[in] data    The contents of the binary message.  This is an
+    ///                    array whose dimension is [length].
+    /// @param[in] length  The length of data.
+    /// @throws std::invalid_argument if the message is invalid or data is
+    ///         NULL or length is 0.
+    void fromBinary(const uint8_t *data, size_t length);
     /// @}
 
     /// @name Destructors
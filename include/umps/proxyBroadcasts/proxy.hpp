@@ -80,6 +80,11 @@ public:
     [[nodiscard]] bool isRunning() const noexcept;
     /// @brief Stops the proxy.
     void stop();
+    /// @result The traffic statistics for each message type as JSON.
+    /// @throws std::runtime_error if \c isRunning() is false or the topic
+    ///         statistics were not enabled in the options.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::Proxy::getStatistics()
+    [[nodiscard]] std::string getStatistics() const;
     /// @}
 
     /// @result An uninitialized instance of this class.
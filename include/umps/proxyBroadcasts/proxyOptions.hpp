@@ -1,6 +1,10 @@
 #ifndef UMPS_PROXY_BROADCASTS_PROXY_OPTIONS_HPP
 #define UMPS_PROXY_BROADCASTS_PROXY_OPTIONS_HPP
 #include <memory>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstdint>
 namespace UMPS
 {
  namespace Authentication
@@ -105,6 +109,76 @@ public:
     void setBackendHighWaterMark(int highWaterMark);
     /// @}
 
+    /// @name Instrumentation
+    /// @{
+
+    /// @brief Counts the messages, bytes, high water mark drops, and
+    ///        subscribers for each message type.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::enableTopicStatistics()
+    void enableTopicStatistics() noexcept;
+    /// @brief Disables the topic statistics.  This is the default.
+    void disableTopicStatistics() noexcept;
+    /// @brief Refuses a message unless every subscriber has room for it so
+    ///        that high water mark drops can be counted.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::enableBackendNoDrop()
+    void enableBackendNoDrop() noexcept;
+    /// @brief Uses ZeroMQ's default high water mark behavior.  This is the
+    ///        default.
+    void disableBackendNoDrop() noexcept;
+    /// @brief Only subscribes upstream to, and forwards, the message types
+    ///        that subscribers want.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::enableTopicFiltering()
+    void enableTopicFiltering() noexcept;
+    /// @brief Disables the topic filtering.  This is the default.
+    void disableTopicFiltering() noexcept;
+    /// @}
+
+    /// @name Last-Value Cache
+    /// @{
+
+    /// @brief Keeps the most recent message of each type so subscribers can
+    ///        request it from the snapshot address when they subscribe.
+    /// @param[in] capacity  The maximum number of messages to cache.
+    ///                      0 disables the cache.  This is the default.
+    /// @throws std::invalid_argument if the capacity is negative.
+    /// @note This requires a snapshot address and cannot be combined with
+    ///       topic filtering.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::setLastValueCacheCapacity()
+    void setLastValueCacheCapacity(int capacity);
+    /// @brief Sets the maximum number of bytes in the cached messages.
+    /// @throws std::invalid_argument if this is not positive.
+    void setLastValueCacheMaximumBytes(int64_t maximumBytes);
+    /// @brief Caches the most recent message for each key within a message
+    ///        type, e.g., each module's heartbeat.
+    /// @param[in] keyExtractor  Given the message type and message this
+    ///                          returns the key.
+    void setLastValueCacheKeyExtractor(
+        const std::function<std::string (std::string_view messageType,
+                                         std::string_view message)> &keyExtractor);
+    /// @brief Sets the address from which subscribers request the cached
+    ///        messages.
+    /// @throws std::invalid_argument if the address is empty.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::setSnapshotAddress()
+    void setSnapshotAddress(const std::string &address);
+    /// @}
+
+    /// @name Federation
+    /// @{
+
+    /// @brief Lets this proxy be chained with other proxies so a broadcast
+    ///        can be fanned out across machines.  Messages are stamped with
+    ///        their origin and a sequence number and repeats are dropped.
+    /// @sa UMPS::Messaging::XPublisherXSubscriber::ProxyOptions::enableFederation()
+    void enableFederation() noexcept;
+    /// @brief Disables federation.  This is the default.
+    void disableFederation() noexcept;
+    /// @brief Adds an upstream proxy whose broadcast this proxy forwards.
+    /// @param[in] address  The address of the upstream proxy's backend.
+    /// @throws std::invalid_argument if the address is empty.
+    /// @note Both proxies must be federated.
+    void addUpstreamProxy(const std::string &address);
+    /// @}
+
     /// @name ZAP Options
     /// @{
 
@@ -37,6 +37,21 @@ public:
     void setIdentifier(int64_t identifier) noexcept;
     /// @result The request identifier.
     [[nodiscard]] int64_t getIdentifier() const noexcept;
+
+    /// @brief Requests only the modules that were added or removed after
+    ///        the given version of the module registry.  This is useful for
+    ///        clients that poll frequently.
+    /// @param[in] version  The registry version from a previous
+    ///                     \c AvailableModulesResponse.
+    /// @note If the proxy can no longer determine the changes since this
+    ///       version then the full list of modules is returned.
+    void setSinceVersion(uint64_t version) noexcept;
+    /// @result The registry version after which changes are requested.
+    /// @throws std::runtime_error if \c haveSinceVersion() is false.
+    [[nodiscard]] uint64_t getSinceVersion() const;
+    /// @result True indicates only the changes since a version are
+    ///         requested.
+    [[nodiscard]] bool haveSinceVersion() const noexcept;
     /// @}
 
     /// @name Operators
@@ -63,6 +78,11 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Creates the class from a message.
     /// @param[in] message  The message from which to create this class.
     /// @throws std::runtime_error if the message is invalid.
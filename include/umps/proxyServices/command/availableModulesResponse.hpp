@@ -56,6 +56,39 @@ public:
     /// @result The request identifier.
     [[nodiscard]] int64_t getIdentifier() const noexcept;
 
+    /// @name Versioning
+    /// @{
+
+    /// @brief Sets the version of the module registry that this response
+    ///        describes.  A client can pass this to
+    ///        \c AvailableModulesRequest::setSinceVersion() to only receive
+    ///        subsequent changes.
+    /// @param[in] version  The registry version.
+    void setVersion(uint64_t version) noexcept;
+    /// @result The registry version.  This is 0 if the proxy does not
+    ///         version its registry.
+    [[nodiscard]] uint64_t getVersion() const noexcept;
+    /// @brief Indicates this response only contains the changes since the
+    ///        requested version.  In this case the modules are those that
+    ///        were added and \c getRemovedModules() are those that were
+    ///        removed.  A client should apply the removals then the
+    ///        additions.
+    /// @param[in] incremental  True indicates this is a list of changes.
+    void setIncremental(bool incremental) noexcept;
+    /// @result True indicates this response is a list of changes.  False
+    ///         indicates \c getModules() is every available module.
+    [[nodiscard]] bool isIncremental() const noexcept;
+    /// @brief Sets the modules that were removed since the requested
+    ///        version.
+    /// @param[in] modules  The removed modules.
+    /// @throws std::invalid_argument if the module name of any module is
+    ///         not set.
+    void setRemovedModules(const std::vector<ModuleDetails> &modules);
+    /// @result The removed modules.  This is only meaningful for
+    ///         incremental responses.
+    [[nodiscard]] std::vector<ModuleDetails> getRemovedModules() const;
+    /// @}
+
     /// @name Operators
     /// @{
 
@@ -91,6 +124,11 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Creates the class from a message.
     /// @param[in] message  The message from which to create this class.
     /// @throws std::runtime_error if the message is invalid.
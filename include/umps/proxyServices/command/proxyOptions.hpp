@@ -119,6 +119,30 @@ public:
     void setPingIntervals(const std::vector<std::chrono::milliseconds> &pingIntervals);
     /// @result The ping intervals.
     [[nodiscard]] std::vector<std::chrono::milliseconds> getPingIntervals() const noexcept;
+    /// @brief The proxy only visits the modules whose next ping or time out
+    ///        is due.  This defines how often the proxy checks for due
+    ///        modules.  Pings and time outs can be late by up to this amount.
+    /// @param[in] resolution  The timer resolution.
+    /// @throws std::invalid_argument if the resolution is not positive.
+    void setTimerResolution(const std::chrono::milliseconds &resolution);
+    /// @result The timer resolution.  The default is 100 milliseconds.
+    [[nodiscard]] std::chrono::milliseconds getTimerResolution() const noexcept;
+    /// @}
+
+    /// @name Threading
+    /// @{
+
+    /// @brief Sets the number of ZeroMQ I/O threads over which the
+    ///        connections to the frontend and backend are spread.  These
+    ///        threads do the network, framing, and encryption work for each
+    ///        client and module.  Routing is done by a single thread so
+    ///        requests for a module are delivered in order.
+    /// @param[in] nThreads  The number of I/O threads.
+    /// @throws std::invalid_argument if nThreads is not positive.
+    /// @note This only applies when the proxy makes its own contexts.
+    void setNumberOfInputOutputThreads(int nThreads);
+    /// @result The number of I/O threads.  The default is 1.
+    [[nodiscard]] int getNumberOfInputOutputThreads() const noexcept;
     /// @}
 
     /// @brief Loads proxy options from an initialization file.
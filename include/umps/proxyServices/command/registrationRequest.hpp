@@ -85,6 +85,11 @@ public:
     /// @result The class expressed as a string message.
     /// @throws std::runtime_error if the required information is not set. 
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Converts the class to a message and appends it to the
+    ///        given buffer.
+    /// @param[in,out] message  On exit, the message has been appended.
+    /// @throws std::invalid_argument if message is NULL.
+    void serializeInto(std::string *message) const final;
     /// @brief Creates the class from a message.
     /// @param[in] message  The message.
     /// @throws std::runtime_error if the message is invalid.
@@ -151,6 +151,32 @@ public:
     [[nodiscard]] std::chrono::milliseconds getPollingTimeOut() const noexcept;
     /// @}
 
+    /// @name Workers
+    /// @{
+
+    /// @brief By default, the callback is run on the polling thread.  A
+    ///        long-running command then delays the replies to the proxy's
+    ///        pings and the proxy may evict the module.  With workers, pings
+    ///        and terminate requests are still answered by the polling
+    ///        thread while other requests are handed to a pool of threads.
+    /// @param[in] nWorkers  The number of worker threads.  0 runs the
+    ///                      callback on the polling thread.
+    /// @throws std::invalid_argument if nWorkers is negative.
+    /// @note With workers the callback may be called concurrently so it
+    ///       must be thread-safe.
+    void setNumberOfWorkers(int nWorkers);
+    /// @result The number of worker threads.  The default is 0.
+    [[nodiscard]] int getNumberOfWorkers() const noexcept;
+    /// @brief Sets the maximum number of requests that may be waiting on or
+    ///        processed by the workers.  Additional requests are immediately
+    ///        answered with a \c UMPS::MessageFormats::Failure message.
+    /// @param[in] maximumInFlight  The maximum number of requests in flight.
+    /// @throws std::invalid_argument if maximumInFlight is not positive.
+    void setMaximumNumberOfRequestsInFlight(int maximumInFlight);
+    /// @result The maximum number of requests in flight.  The default is 64.
+    [[nodiscard]] int getMaximumNumberOfRequestsInFlight() const noexcept;
+    /// @}
+
     /// @result The reply options.
     /// @throws std::runtime_error if \c haveAddress() or \c haveCallback()
     ///         is false.
@@ -87,6 +87,16 @@ public:
     /// @throws std::runtime_error if \c isInitialized() is false.
     [[nodiscard]]
     std::unique_ptr<AvailableModulesResponse> getAvailableModules() const;
+    /// @brief Gets the modules that were registered or removed after the
+    ///        given version of the registry.
+    /// @param[in] sinceVersion  The version from a previous response.
+    /// @result A message with the changes to the available modules.  If the
+    ///         changes are unknown to the proxy then this is the full list
+    ///         of modules; see \c AvailableModulesResponse::isIncremental().
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]]
+    std::unique_ptr<AvailableModulesResponse>
+        getAvailableModules(uint64_t sinceVersion) const;
     /// @brief Gets the commands for interacting with this program.
     /// @param[in] moduleName  The name of the module from which to get
     ///                        available commands.
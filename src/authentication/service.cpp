@@ -1,5 +1,7 @@
 #include <string>
+#include <sstream>
 #include <array>
+#include <vector>
 #include <set>
 #include <thread>
 #include <mutex>
@@ -82,6 +84,198 @@ public:
         std::scoped_lock lock(mMutex);
         mRunning = false;
     }
+    /// Authenticates a ZAP request and returns the reply.  This is called
+    /// concurrently by the workers so the authenticator must be thread
+    /// safe.
+    [[nodiscard]] zmq::multipart_t
+        processZAPRequest(const zmq::multipart_t &messageReceived) const
+    {
+        // Default failure
+        std::string statusCode = IAuthenticator::serverErrorStatus();
+        std::string statusText = "Unhandled request";
+        if (messageReceived.size() < 6)
+        {
+            mLogger->error("ZAP request has too few frames");
+            statusCode = IAuthenticator::clientErrorStatus();
+            statusText = "Malformed ZAP request";
+            return makeZAPReply(messageReceived, statusCode, statusText);
+        }
+        // Order is defined in:
+        // https://rfc.zeromq.org/spec/27/
+        auto domain    = messageReceived.at(2).to_string(); // e.g., global
+        auto ipAddress = messageReceived.at(3).to_string();
+        auto identity  = messageReceived.at(4).to_string(); // Originating socket ID
+        auto mechanism = messageReceived.at(5).to_string();
+        // Is the IP address blacklisted?
+        std::tie (statusCode, statusText)
+            = mAuthenticator->isBlacklisted(ipAddress);
+        if (statusCode == IAuthenticator::okayStatus())
+        {
+            // Handle different mechanisms.
+            if (mechanism == "NULL") // Check nothing - blacklist enough
+            {
+                statusCode = IAuthenticator::okayStatus();
+                statusText = IAuthenticator::okayMessage();
+            }
+            else if (mechanism == "PLAIN") // Check username/passsword
+            {
+                statusCode = IAuthenticator::serverErrorStatus();
+                statusText = "Unhandled PLAIN logic";
+                //mAuthenticator.verifyPlain( );
+                if (messageReceived.size() < 8)
+                {
+                    statusCode = IAuthenticator::clientErrorStatus();
+                    statusText = "PLAIN request missing credentials";
+                    return makeZAPReply(messageReceived,
+                                        statusCode, statusText);
+                }
+                auto user = messageReceived.at(6).to_string();
+                auto password = messageReceived.at(7).to_string();
+                Certificate::UserNameAndPassword plainText;
+                try
+                {
+                    plainText.setUserName(user);
+                    plainText.setPassword(password);
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("Failed to set username/pwd");
+                }
+                // Check the username and password
+                std::tie(statusCode, statusText) 
+                    = mAuthenticator->isValid(plainText);
+            }
+            else if (mechanism == "CURVE") // Check public key 
+            {
+                statusCode = IAuthenticator::serverErrorStatus();
+                statusText = "Unhandled CURVE logic"; 
+                if (messageReceived.size() < 7 ||
+                    messageReceived.at(6).size() != 32)
+                {
+                    statusCode = IAuthenticator::clientErrorStatus();
+                    statusText = "Key is invalid length";
+                }
+                else
+                {
+                    auto keyPtr = reinterpret_cast<const uint8_t *>
+                                  (messageReceived.at(6).data());
+                    std::array<uint8_t, 32> publicKey{};
+                    std::copy(keyPtr, keyPtr + 32, publicKey.data());
+                    Certificate::Keys key;
+                    try
+                    {
+                        key.setPublicKey(publicKey);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        mLogger->error("Failed to set public key");
+                        statusCode = IAuthenticator::serverErrorStatus();
+                        statusText = "Failed to set public key";
+                    }
+                    if (key.havePublicKey())
+                    {
+                        std::tie(statusCode, statusText)
+                            = mAuthenticator->isValid(key);
+                    }
+                }
+            }
+            else // Check on mechanism
+            {
+                statusCode = IAuthenticator::clientErrorStatus();
+                statusText = "Security mechanism: " + mechanism
+                            + " not supported"; 
+            } // End check on mechanism
+        } // End check on not blacklisted
+        /*
+        if (true)
+        {
+            for (auto &m : messageReceived)
+            {
+                std::cout << m << std::endl;
+            }
+        }
+        */
+        if (statusCode == IAuthenticator::okayStatus())
+        {
+            mLogger->info("Allowing " + mechanism
+                        + " connection from: " + ipAddress);
+        }
+        else
+        {
+            mLogger->debug("Blocking connection from: " + ipAddress);
+        }
+        return makeZAPReply(messageReceived, statusCode, statusText);
+    }
+    /// Formats the ZAP reply.  The order is defined in:
+    /// https://rfc.zeromq.org/spec/27/
+    /// Echoing the sequence number lets libzmq match the reply to the
+    /// handshake that made the request.
+    [[nodiscard]] static zmq::multipart_t
+        makeZAPReply(const zmq::multipart_t &messageReceived,
+                     const std::string &statusCode,
+                     const std::string &statusText)
+    {
+        zmq::multipart_t reply;
+        if (messageReceived.size() >= 2)
+        {
+            reply.addstr(messageReceived.at(0).to_string()); // Version
+            reply.addstr(messageReceived.at(1).to_string()); // Sequence Number
+        }
+        else
+        {
+            reply.addstr("1.0");
+            reply.addstr("");
+        }
+        reply.addstr(statusCode);
+        reply.addstr(statusText);
+        reply.addstr("UAuth");
+        reply.addstr(""); // Always end with this
+        return reply;
+    }
+    /// Worker thread.  The workers are REP sockets behind a DEALER so the
+    /// envelope that identifies the ZAP client is handled by ZeroMQ.
+    void runWorker(const std::string &backendAddress) const
+    {
+        auto contextPtr = reinterpret_cast<zmq::context_t *>
+                          (mContext->getContext());
+        zmq::socket_t worker(*contextPtr, zmq::socket_type::rep);
+        worker.set(zmq::sockopt::linger, 0);
+        worker.connect(backendAddress);
+        zmq::pollitem_t items[] =
+        {
+            {worker.handle(), 0, ZMQ_POLLIN, 0}
+        };
+        while (isRunning())
+        {
+            zmq::poll(&items[0], 1, mWorkerPollTimeOutMS);
+            if (items[0].revents & ZMQ_POLLIN)
+            {
+                zmq::multipart_t messageReceived(worker);
+                zmq::multipart_t reply;
+                try
+                {
+                    reply = processZAPRequest(messageReceived);
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("ZAP worker failed with: "
+                                 + std::string {e.what()});
+                    reply = makeZAPReply(messageReceived,
+                                         IAuthenticator::serverErrorStatus(),
+                                         "Authentication failed");
+                }
+                reply.send(worker);
+            }
+        }
+    }
+    /// Creates a unique inproc address for the workers' backend
+    [[nodiscard]] std::string makeBackendAddress() const
+    {
+        std::ostringstream address;
+        address << "inproc://umps.authentication.workers."
+                << static_cast<const void *> (this);
+        return address.str();
+    }
 //private:
     mutable std::mutex mMutex;
     std::shared_ptr<UMPS::Messaging::Context> mContext{nullptr};
@@ -90,6 +284,8 @@ public:
     std::shared_ptr<IAuthenticator> mAuthenticator{nullptr};
     std::string mEndPoint;
     const std::chrono::milliseconds mPollTimeOutMS{-1};
+    const std::chrono::milliseconds mWorkerPollTimeOutMS{10};
+    int mWorkers{1};
     bool mHavePipe{false};
     bool mRunning{false};
 };
@@ -163,24 +359,49 @@ void Service::start()
                   + std::string(e.what());
         throw std::runtime_error(e.what());
     }
-    // Create a ZAP socket
+    // Create a ZAP socket.  With a pool of workers the requests are
+    // received by a ROUTER and dealt to the workers through the backend.
+    auto nWorkers = getNumberOfWorkers();
     pImpl->mLogger->debug("Binding to ZAP socket...");
     zmq::context_t zapContext(0);
-    zmq::socket_t zap(*contextPtr, zmq::socket_type::rep);
+    zmq::socket_t zap(*contextPtr,
+                      nWorkers > 1 ? zmq::socket_type::router :
+                                     zmq::socket_type::rep);
     zap.bind(ZAP_ENDPOINT);
+    zmq::socket_t backend(*contextPtr, zmq::socket_type::dealer);
+    std::string backendAddress;
+    if (nWorkers > 1)
+    {
+        backend.set(zmq::sockopt::linger, 0);
+        backendAddress = pImpl->makeBackendAddress();
+        backend.bind(backendAddress);
+    }
 
     // Let pipe know I'm ready
     pipe.send(zmq::message_t{}, zmq::send_flags::none);
     pImpl->mLogger->debug("Starting authenticator on endpoint "
                         + pImpl->mEndPoint);
-    const int nPollItems = 2;
+    const int nPollItems = nWorkers > 1 ? 3 : 2;
     pipe.send(zmq::message_t{}, zmq::send_flags::none); // Signal I'm ready
     zmq::pollitem_t items[] =
     {
-        {pipe.handle(), 0, ZMQ_POLLIN, 0},
-        {zap.handle(),  0, ZMQ_POLLIN, 0}
+        {pipe.handle(),    0, ZMQ_POLLIN, 0},
+        {zap.handle(),     0, ZMQ_POLLIN, 0},
+        {backend.handle(), 0, ZMQ_POLLIN, 0}
     };
     pImpl->start();
+    std::vector<std::thread> workers;
+    if (nWorkers > 1)
+    {
+        pImpl->mLogger->debug("Starting " + std::to_string(nWorkers)
+                            + " ZAP workers");
+        workers.reserve(nWorkers);
+        for (int i = 0; i < nWorkers; ++i)
+        {
+            workers.push_back(std::thread(&ServiceImpl::runWorker,
+                                          &*pImpl, backendAddress));
+        }
+    }
     bool keepRunning = true;
     while (keepRunning)
     {
@@ -259,125 +480,53 @@ void Service::start()
         {
             pImpl->mLogger->debug("ZAP request received");
             zmq::multipart_t messageReceived(zap);
-#ifndef NDEBUG
-            assert(messageReceived.size() >= 6);
-#endif
-            // Order is defined in:
-            // https://rfc.zeromq.org/spec/27/
-            auto domain    = messageReceived.at(2).to_string(); // e.g., global
-            auto ipAddress = messageReceived.at(3).to_string();
-            auto identity  = messageReceived.at(4).to_string(); // Originating socket ID
-            auto mechanism = messageReceived.at(5).to_string();
-            // Default failure
-            std::string statusCode = IAuthenticator::serverErrorStatus();
-            std::string statusText = "Unhandled request";
-            // Is the IP address blacklisted?
-            std::tie (statusCode, statusText)
-                = pImpl->mAuthenticator->isBlacklisted(ipAddress);
-            if (statusCode == IAuthenticator::okayStatus())
+            if (nWorkers > 1)
             {
-                // Handle different mechanisms.
-                if (mechanism == "NULL") // Check nothing - blacklist enough
-                {
-                    statusCode = IAuthenticator::okayStatus();
-                    statusText = IAuthenticator::okayMessage();
-                }
-                else if (mechanism == "PLAIN") // Check username/passsword
-                {
-                    statusCode = IAuthenticator::serverErrorStatus();
-                    statusText = "Unhandled PLAIN logic";
-                    //pImpl->mAuthenticator.verifyPlain( );
-                    auto user = messageReceived[5].to_string();
-                    auto password = messageReceived[6].to_string();
-                    Certificate::UserNameAndPassword plainText;
-                    try
-                    {
-                        plainText.setUserName(user);
-                        plainText.setPassword(password);
-                    }
-                    catch (const std::exception &e)
-                    {
-                        pImpl->mLogger->error("Failed to set username/pwd");
-                    }
-                    // Check the username and password
-                    std::tie(statusCode, statusText) 
-                        = pImpl->mAuthenticator->isValid(plainText);
-                }
-                else if (mechanism == "CURVE") // Check public key 
-                {
-                    statusCode = IAuthenticator::serverErrorStatus();
-                    statusText = "Unhandled CURVE logic"; 
-                    if (messageReceived.at(6).size() != 32)
-                    {
-                        statusCode = IAuthenticator::clientErrorStatus();
-                        statusText = "Key is invalid length";
-                    }
-                    else
-                    {
-                        auto keyPtr = reinterpret_cast<const uint8_t *>
-                                      (messageReceived.at(6).data());
-                        std::array<uint8_t, 32> publicKey{};
-                        std::copy(keyPtr, keyPtr + 32, publicKey.data());
-                        Certificate::Keys key;
-                        try
-                        {
-                            key.setPublicKey(publicKey);
-                        }
-                        catch (const std::exception &e)
-                        {
-                            pImpl->mLogger->error("Failed to set public key");
-                            statusCode = IAuthenticator::serverErrorStatus();
-                            statusText = "Failed to set public key";
-                        }
-                        if (key.havePublicKey())
-                        {
-                            std::tie(statusCode, statusText)
-                                = pImpl->mAuthenticator->isValid(key);
-                        }
-                    }
-                }
-                else // Check on mechanism
-                {
-                    statusCode = IAuthenticator::clientErrorStatus();
-                    statusText = "Security mechanism: " + mechanism
-                                + " not supported"; 
-                } // End check on mechanism
-            } // End check on not blacklisted
-            /*
-            if (true)
-            {
-                for (auto &m : messageReceived)
-                {
-                    std::cout << m << std::endl;
-                }
-            }
-            */
-            if (statusCode == IAuthenticator::okayStatus())
-            {
-                pImpl->mLogger->info("Allowing " + mechanism
-                                   + " connection from: " + ipAddress);
+                messageReceived.send(backend);
             }
             else
             {
-                pImpl->mLogger->debug("Blocking connection from: " + ipAddress);
+                auto reply = pImpl->processZAPRequest(messageReceived);
+                reply.send(zap);
             }
-            // Format result.  The order is defined in:
-            // https://rfc.zeromq.org/spec/27/
-            zmq::multipart_t reply;
-            reply.addstr(messageReceived[0].to_string()); // Version
-            reply.addstr(messageReceived[1].to_string()); // Sequence Number 
-            reply.addstr(statusCode);
-            reply.addstr(statusText);
-            reply.addstr("UAuth");
-            reply.addstr(""); // Always end with this
-            reply.send(zap);
  
         }
+        // Replies from the workers go back to the ZAP clients
+        if (nWorkers > 1 && (items[2].revents & ZMQ_POLLIN))
+        {
+            zmq::multipart_t reply(backend);
+            reply.send(zap);
+        }
     } // Loop on running
+    for (auto &worker : workers)
+    {
+        if (worker.joinable()){worker.join();}
+    }
     pImpl->mLogger->debug("Exiting threadAuthenticator polling loop");
     pipe.close();
 }
 
+/// Number of workers
+void Service::setNumberOfWorkers(const int nWorkers)
+{
+    if (nWorkers < 1)
+    {
+        throw std::invalid_argument("Number of workers must be positive");
+    }
+    if (isRunning())
+    {
+        throw std::runtime_error("Cannot change workers while running");
+    }
+    std::scoped_lock lock(pImpl->mMutex);
+    pImpl->mWorkers = nWorkers;
+}
+
+int Service::getNumberOfWorkers() const noexcept
+{
+    std::scoped_lock lock(pImpl->mMutex);
+    return pImpl->mWorkers;
+}
+
 /// Tell thread running service to stop
 void Service::stop()
 {
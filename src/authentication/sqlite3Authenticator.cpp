@@ -2,9 +2,14 @@
 #include <mutex>
 #include <string>
 #include <vector>
+#include <array>
+#include <unordered_map>
 #include <filesystem>
 #include <set>
 #include <sodium/crypto_pwhash.h>
+#include <sodium/crypto_generichash.h>
+#include <sodium/randombytes.h>
+#include <sodium/utils.h>
 #include <sqlite3.h>
 #include <cassert>
 #include "umps/authentication/sqlite3Authenticator.hpp"
@@ -250,61 +255,57 @@ std::pair<int, std::string> createWhitelistTable(sqlite3 *db)
     }
     return std::pair{rc, outputMessage};
 }
-/// Is it whitelisted?
-bool checkWhitelisted(sqlite3 *db, const std::string &ip)
+/// Queries the addresses in the blacklist or whitelist table
+std::vector<std::string> queryFromAddressTable(sqlite3 *db,
+                                               const std::string &table)
 {
-    bool matches = false;
-    // No whitelist -> can't match
-    if (db == nullptr)
-    {
-        return matches;
-    }
-    std::string sql = "SELECT ip FROM whitelist;";
+    std::vector<std::string> addresses;
+    if (db == nullptr){return addresses;}
+    std::string sql = "SELECT ip FROM " + table + ";";
     sqlite3_stmt *result = nullptr;
     auto rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &result, nullptr);
-    if (rc != SQLITE_OK){return matches;}
+    if (rc != SQLITE_OK)
+    {
+        std::cerr << "Failed to prepare query" << std::endl;
+        return addresses;
+    }
     while (true)
     {
         auto step = sqlite3_step(result);
         if (step != SQLITE_ROW){break;}
-        std::string targetIP = reinterpret_cast<const char *>
-                               (sqlite3_column_int(result, 0));
-        if (ipMatches(ip, targetIP))
+        if (sqlite3_column_text(result, 0) != nullptr)
         {
-            matches = true;
-            break;
+            addresses.push_back(reinterpret_cast<const char *>
+                                (sqlite3_column_text(result, 0)));
         }
     }
     sqlite3_finalize(result);
-    return matches;
+    return addresses;
+}
+
+/// Prepares a query of the database's data version.  The data version
+/// changes whenever another connection commits a change to the database.
+sqlite3_stmt *prepareDataVersion(sqlite3 *db)
+{
+    sqlite3_stmt *statement = nullptr;
+    auto rc = sqlite3_prepare_v2(db, "PRAGMA data_version;", -1,
+                                 &statement, nullptr);
+    if (rc != SQLITE_OK){return nullptr;}
+    return statement;
 }
-/// Is it blacklisted?
-bool checkBlacklisted(sqlite3 *db, const std::string &ip)
+
+/// Queries the data version.  This is much cheaper than querying a table.
+int64_t queryDataVersion(sqlite3_stmt *statement)
 {
-    bool matches = false;
-    // No blacklist -> can't match
-    if (db == nullptr) 
+    if (statement == nullptr){return -1;}
+    int64_t dataVersion{-1};
+    sqlite3_reset(statement);
+    if (sqlite3_step(statement) == SQLITE_ROW)
     {
-        return matches;
+        dataVersion = sqlite3_column_int64(statement, 0);
     }
-    std::string sql = "SELECT ip FROM blacklist;";
-    sqlite3_stmt *result = nullptr;
-    auto rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &result, NULL);
-    if (rc != SQLITE_OK){return matches;}
-    while (true)
-    {
-        auto step = sqlite3_step(result);
-        if (step != SQLITE_ROW){break;}
-        std::string targetIP = reinterpret_cast<const char *>
-                               (sqlite3_column_int(result, 0));
-        if (ipMatches(ip, targetIP))
-        {
-            matches = true;
-            break;
-        }
-    }
-    sqlite3_finalize(result);
-    return matches;
+    sqlite3_reset(statement);
+    return dataVersion;
 }
 
 /// Query users from user table
@@ -363,6 +364,75 @@ std::vector<User> queryFromUsersTable(sqlite3 *db, const std::string &userNameOr
     sqlite3_finalize(result);
     return users;
 }
+/// @brief A bounded cache of verified user name and password pairs.
+/// @details Verifying a password with crypto_pwhash_str_verify is
+///          deliberately expensive.  To avoid repeating this on every
+///          connection the pairs that have been verified are remembered.
+///          The pairs are stored as a digest keyed with a random,
+///          per-process key so that the plain text passwords are not
+///          retained.  Each entry also records the hashed password against
+///          which it was verified so that changing a user's password
+///          invalidates the entry.
+class CredentialCache
+{
+public:
+    CredentialCache()
+    {
+        randombytes_buf(mKey.data(), mKey.size());
+    }
+    /// @result The keyed digest of the user name and password.
+    [[nodiscard]] std::string digest(const std::string &userName,
+                                     const std::string &password) const
+    {
+        std::string message;
+        message.reserve(userName.size() + 1 + password.size());
+        message.append(userName);
+        message.push_back('\0');
+        message.append(password);
+        std::array<unsigned char, crypto_generichash_BYTES> hash{};
+        crypto_generichash(hash.data(), hash.size(),
+                           reinterpret_cast<const unsigned char *>
+                           (message.data()), message.size(),
+                           mKey.data(), mKey.size());
+        sodium_memzero(message.data(), message.size());
+        return std::string(reinterpret_cast<const char *> (hash.data()),
+                           hash.size());
+    }
+    /// @result True indicates the credentials with this digest were
+    ///         verified against the given hashed password.
+    [[nodiscard]] bool contains(const std::string &digest,
+                                const std::string &hashedPassword) const
+    {
+        std::scoped_lock lock(mMutex);
+        auto it = mEntries.find(digest);
+        return it != mEntries.end() && it->second == hashedPassword;
+    }
+    /// @brief Remembers that the credentials with this digest were verified
+    ///        against the given hashed password.
+    void insert(const std::string &digest, const std::string &hashedPassword)
+    {
+        std::scoped_lock lock(mMutex);
+        // The digests are effectively random so evicting the first entry
+        // is a random eviction.
+        if (mEntries.size() >= MAX_ENTRIES && !mEntries.contains(digest))
+        {
+            mEntries.erase(mEntries.begin());
+        }
+        mEntries.insert_or_assign(digest, hashedPassword);
+    }
+    /// @brief Forgets all verified credentials.
+    void clear() noexcept
+    {
+        std::scoped_lock lock(mMutex);
+        mEntries.clear();
+    }
+private:
+    static constexpr size_t MAX_ENTRIES{4096};
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, std::string> mEntries;
+    std::array<unsigned char, crypto_generichash_KEYBYTES> mKey{};
+};
+
 /// Add user
 void addUserToDatabase(sqlite3 *db, const User &user)
 {
@@ -444,15 +514,24 @@ public:
         std::scoped_lock lock(mMutex);
         if (!mBlacklist.contains(address))
         {
-            if (mWhitelist.contains(address))
+            if (mWhitelist.contains(address) ||
+                mWhitelistTrie->contains(address))
             {
                 auto errmsg = "Remove " + address
                             + " from whitelist before blacklisting";
                 mLogger->error(errmsg);
                 throw std::invalid_argument(errmsg);
             }
+            ::IPPrefix prefix;
+            if (!::parseIPPrefix(address, &prefix))
+            {
+                auto errmsg = "Could not parse address: " + address;
+                mLogger->error(errmsg);
+                throw std::invalid_argument(errmsg);
+            }
             mLogger->debug("Adding: " + address + " to blacklist");
             mBlacklist.insert(address);
+            rebuildBlacklist();
         }
         else
         {
@@ -463,27 +542,36 @@ public:
     void removeFromBlacklist(const std::string &address) noexcept
     {
         std::scoped_lock lock(mMutex);
-        if (ipExists(address, mBlacklist))
+        if (mBlacklist.contains(address))
         {
             mBlacklist.erase(address);
             mLogger->debug("Removing: " + address + " from blacklist");
+            rebuildBlacklist();
         }
     }
     /// Add to whitelist
     void addToWhitelist(const std::string &address)
     {
         std::scoped_lock lock(mMutex);
-        if (!ipExists(address, mWhitelist))
+        if (!mWhitelist.contains(address))
         {
-            if (ipExists(address, mBlacklist))
+            if (mBlacklistTrie->contains(address))
             {
                 auto errmsg = "Remove " + address
                             + " from blacklist before whitelisting";
                 mLogger->error(errmsg);
                 throw std::invalid_argument(errmsg);
             }
+            ::IPPrefix prefix;
+            if (!::parseIPPrefix(address, &prefix))
+            {
+                auto errmsg = "Could not parse address: " + address;
+                mLogger->error(errmsg);
+                throw std::invalid_argument(errmsg);
+            }
             mLogger->debug("Adding: " + address + " to whitelist");
             mWhitelist.insert(address);
+            rebuildWhitelist();
         }
         else
         {
@@ -495,37 +583,133 @@ public:
     void removeFromWhitelist(const std::string &address) noexcept
     {
         std::scoped_lock lock(mMutex);
-        if (ipExists(address, mWhitelist))
+        if (mWhitelist.contains(address))
         {
             mWhitelist.erase(address);
             mLogger->debug("Removing: " + address + " from whitelist");
+            rebuildWhitelist();
         }
     }
-    /// Blacklisted?
-    bool isBlacklisted(const std::string &address) const noexcept
+    /// Blacklisted?  The lookup is performed on a snapshot of the blacklist
+    /// after releasing the lock.
+    bool isBlacklisted(const std::string &address) noexcept
     {
+        std::shared_ptr<const ::IPAddressTrie> blacklist;
+        {
         std::scoped_lock lock(mMutex);
-        return checkBlacklisted(mBlacklistTable, address);
+        if (::queryDataVersion(mBlacklistDataVersionStatement)
+            != mBlacklistDataVersion)
+        {
+            mLogger->debug("Blacklist table changed; reloading blacklist");
+            rebuildBlacklist();
+        }
+        blacklist = mBlacklistTrie;
+        }
+        return blacklist->contains(address);
     }
     /// Whitelisted?
-    bool isWhitelisted(const std::string &address) const noexcept
+    bool isWhitelisted(const std::string &address) noexcept
     {
+        std::shared_ptr<const ::IPAddressTrie> whitelist;
+        {
         std::scoped_lock lock(mMutex);
-        return checkWhitelisted(mWhitelistTable, address);
+        if (::queryDataVersion(mWhitelistDataVersionStatement)
+            != mWhitelistDataVersion)
+        {
+            mLogger->debug("Whitelist table changed; reloading whitelist");
+            rebuildWhitelist();
+        }
+        whitelist = mWhitelistTrie;
+        }
+        return whitelist->contains(address);
+    }
+    /// Compiles the given addresses and the addresses in the table.
+    /// Addresses that cannot be parsed are skipped.
+    [[nodiscard]] std::shared_ptr<const ::IPAddressTrie>
+        compileAddresses(const std::set<std::string> &addresses,
+                         sqlite3 *db, const std::string &table) const
+    {
+        auto trie = std::make_shared<::IPAddressTrie> ();
+        auto insert = [&](const std::string &address)
+        {
+            try
+            {
+                trie->insert(address);
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->warn("Skipping " + table + " entry: "
+                            + std::string {e.what()});
+            }
+        };
+        for (const auto &address : addresses){insert(address);}
+        for (const auto &address : ::queryFromAddressTable(db, table))
+        {
+            insert(address);
+        }
+        return trie;
+    }
+    /// Compiles then publishes the blacklist.  Since readers take a copy of
+    /// the pointer the new blacklist replaces the old one atomically.
+    /// The caller must hold the mutex.
+    void rebuildBlacklist() noexcept
+    {
+        try
+        {
+            mBlacklistDataVersion
+                = ::queryDataVersion(mBlacklistDataVersionStatement);
+            mBlacklistTrie = compileAddresses(mBlacklist, mBlacklistTable,
+                                              "blacklist");
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to compile blacklist: "
+                         + std::string {e.what()});
+        }
+    }
+    /// Compiles then publishes the whitelist.  The caller must hold the
+    /// mutex.
+    void rebuildWhitelist() noexcept
+    {
+        try
+        {
+            mWhitelistDataVersion
+                = ::queryDataVersion(mWhitelistDataVersionStatement);
+            mWhitelistTrie = compileAddresses(mWhitelist, mWhitelistTable,
+                                              "whitelist");
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to compile whitelist: "
+                         + std::string {e.what()});
+        }
     }
     /// Close user database
     void closeUsersTable()
     {
         std::scoped_lock lock(mMutex);
+        if (mDataVersionStatement)
+        {
+            sqlite3_finalize(mDataVersionStatement);
+        }
         if (mHaveUsersTable && mUsersTable){sqlite3_close(mUsersTable);}
         mHaveUsersTable = false;
         mUsersTableFile.clear();
         mUsersTable = nullptr;
+        mDataVersionStatement = nullptr;
+        mDataVersion = -1;
+        mUsersByName.clear();
+        mUserNameByPublicKey.clear();
+        mCredentialCache.clear();
     }
     /// Close blacklist database
     void closeBlacklistTable()
     {
         std::scoped_lock lock(mMutex);
+        if (mBlacklistDataVersionStatement)
+        {
+            sqlite3_finalize(mBlacklistDataVersionStatement);
+        }
         if (mHaveBlacklistTable && mBlacklistTable)
         {
             sqlite3_close(mBlacklistTable);
@@ -533,11 +717,17 @@ public:
         mHaveBlacklistTable = false;
         mBlacklistTableFile.clear();
         mBlacklistTable = nullptr;
+        mBlacklistDataVersionStatement = nullptr;
+        rebuildBlacklist();
     }
     /// Close white database
     void closeWhitelistTable()
     {
         std::scoped_lock lock(mMutex);
+        if (mWhitelistDataVersionStatement)
+        {
+            sqlite3_finalize(mWhitelistDataVersionStatement);
+        }
         if (mHaveWhitelistTable && mWhitelistTable)
         {
             sqlite3_close(mWhitelistTable);
@@ -545,6 +735,8 @@ public:
         mHaveWhitelistTable = false;
         mWhitelistTableFile.clear();
         mWhitelistTable = nullptr;
+        mWhitelistDataVersionStatement = nullptr;
+        rebuildWhitelist();
     }
     /// Open user database
     int openUsersTable(const std::string &database, bool create)
@@ -572,6 +764,17 @@ public:
                     error = 1;
                 }
             }
+            if (error == 0)
+            {
+                mDataVersionStatement = ::prepareDataVersion(mUsersTable);
+                if (mDataVersionStatement == nullptr)
+                {
+                    mLogger->warn("Failed to prepare data version query; "
+                                + std::string {"changes made by other "}
+                                + "processes will not be detected");
+                }
+                reloadUsers();
+            }
         }
         else
         {
@@ -607,6 +810,12 @@ public:
                     error = 1;
                 }   
             }
+            if (error == 0)
+            {
+                mBlacklistDataVersionStatement
+                    = ::prepareDataVersion(mBlacklistTable);
+                rebuildBlacklist();
+            }
         }
         else
         {
@@ -642,6 +851,12 @@ public:
                     error = 1;
                 }   
             }
+            if (error == 0)
+            {
+                mWhitelistDataVersionStatement
+                    = ::prepareDataVersion(mWhitelistTable);
+                rebuildWhitelist();
+            }
         }
         else
         {
@@ -678,6 +893,7 @@ public:
         {
             mLogger->info("Adding user: " + userName);
             ::addUserToDatabase(mUsersTable, user);
+            reloadUsers();
         }
         else
         {
@@ -687,6 +903,7 @@ public:
     /// Update user - if doesn't exist then add
     void updateUser(const User &user)
     {
+        std::scoped_lock lock(mMutex);
         if (!mHaveUsersTable){throw std::runtime_error("User table not open");}
         auto userName = user.getName();
         constexpr bool queryUser = true;
@@ -706,10 +923,12 @@ public:
             userWork.setIdentifier(users[0].getIdentifier());
             updateUserToDatabase(mUsersTable, userWork);
         }
+        reloadUsers();
     }
     /// Delete user
     void deleteUser(const User &user)
     {
+        std::scoped_lock lock(mMutex);
         if (!mHaveUsersTable){throw std::runtime_error("User table not open");}
         auto userName = user.getName();
         constexpr bool queryUser = true;
@@ -725,6 +944,7 @@ public:
             users = ::queryFromUsersTable(mUsersTable, userName, queryUser);
             assert(users.empty());
 #endif
+            reloadUsers();
         }
         else
         {
@@ -741,51 +961,90 @@ public:
         constexpr bool queryUser = true;
         return ::queryFromUsersTable(mUsersTable, userName, queryUser);
     }
+    /// Rebuilds the in-memory index of the user table and forgets the
+    /// verified credentials.  The caller must hold the mutex.
+    void reloadUsers()
+    {
+        mUsersByName.clear();
+        mUserNameByPublicKey.clear();
+        mCredentialCache.clear();
+        const std::string userName{};
+        constexpr bool queryUser = true;
+        auto users = ::queryFromUsersTable(mUsersTable, userName, queryUser);
+        for (auto &user : users)
+        {
+            auto name = user.getName();
+            if (user.havePublicKey())
+            {
+                mUserNameByPublicKey.insert_or_assign(user.getPublicKey(),
+                                                      name);
+            }
+            mUsersByName.insert_or_assign(name, std::move(user));
+        }
+        mDataVersion = ::queryDataVersion(mDataVersionStatement);
+    }
+    /// Reloads the index if another connection, e.g., an administrator's
+    /// tool, modified the user table.  The caller must hold the mutex.
+    void reloadUsersIfChanged()
+    {
+        if (::queryDataVersion(mDataVersionStatement) != mDataVersion)
+        {
+            mLogger->debug("User table changed; reloading users");
+            reloadUsers();
+        }
+    }
     /// Does user and password match?
     std::pair<std::string, std::string> 
         isValid(const std::string &userName,
-                const std::string &password) const
+                const std::string &password)
     {
+        // Look up the user in the index.  The (expensive) password check
+        // is performed after releasing the lock.
+        User user;
+        {
         std::scoped_lock lock(mMutex);
         if (!mHaveUsersTable)
         {
             return std::pair(serverErrorStatus(), "User table not opened");
         }
-        // Query all users named userName
-        const bool queryUser = true;
-        auto returnedUsers = ::queryFromUsersTable(mUsersTable, userName,
-                                                   queryUser);
+        reloadUsersIfChanged();
+        auto it = mUsersByName.find(userName);
         // No user exists
-        if (returnedUsers.empty())
+        if (it == mUsersByName.end())
         {
             return std::pair{clientErrorStatus(),
                             "User: " + userName + " does not exist"};
         }
-#ifndef NDEBUG 
-        assert(static_cast<int> (returnedUsers.size()) == 1); 
-#endif
-        if (!returnedUsers[0].haveHashedPassword())
+        user = it->second;
+        }
+        if (!user.haveHashedPassword())
         {
             return std::pair{clientErrorStatus(),
                              "User: " + userName + " does not have password"};
         }
-        if (returnedUsers[0].getPrivileges() < mPrivileges)
+        if (user.getPrivileges() < mPrivileges)
         {
             return std::pair{clientErrorStatus(),
                              "User: " + userName
                            + " has insufficient privileges."
                            + userName + " has " 
                            + ::toPrivilegeString(
-                                 returnedUsers[0].getPrivileges())
+                                 user.getPrivileges())
                            + " but requires "
                            + ::toPrivilegeString(mPrivileges)};
         }
-        if (!returnedUsers[0].doesPasswordMatch(password))
+        auto hashedPassword = user.getHashedPassword();
+        auto digest = mCredentialCache.digest(userName, password);
+        if (!mCredentialCache.contains(digest, hashedPassword))
         {
-            return std::pair{clientErrorStatus(),
-                             "Given password: " + password
-                           + " does not match user's " + userName
-                           + " password"};
+            if (!user.doesPasswordMatch(password))
+            {
+                return std::pair{clientErrorStatus(),
+                                 "Given password: " + password
+                               + " does not match user's " + userName
+                               + " password"};
+            }
+            mCredentialCache.insert(digest, hashedPassword);
         }
         mLogger->info("Validated user/password for user " + userName
                     + " who has minimum privileges "
@@ -794,37 +1053,34 @@ public:
     }
     /// Does public key match?
     std::pair<std::string, std::string>
-        isValid(const std::string &publicKey) const
+        isValid(const std::string &publicKey)
     {
         std::scoped_lock lock(mMutex);
         if (!mHaveUsersTable)
         {
             return std::pair(serverErrorStatus(), "User table not opened");
         }
-        // Query for this public key
-        const bool queryUser = false;
-        auto returnedUsers = ::queryFromUsersTable(mUsersTable, publicKey,
-                                                   queryUser);
+        reloadUsersIfChanged();
+        // Look up this public key
+        auto it = mUserNameByPublicKey.find(publicKey);
         // No user exists
-        if (returnedUsers.empty())
+        if (it == mUserNameByPublicKey.end())
         {
             return std::pair(clientErrorStatus(), "Public key does not exist");
         }
-#ifndef NDEBUG 
-        assert(static_cast<int> (returnedUsers.size()) == 1);  
-#endif
-        if (returnedUsers[0].getPrivileges() < mPrivileges)
+        const auto &user = mUsersByName.at(it->second);
+        if (user.getPrivileges() < mPrivileges)
         {
             return std::pair{clientErrorStatus(),
                             "User has insufficient privileges.  "
-                           + returnedUsers[0].getName() + " has " 
+                           + user.getName() + " has " 
                            + ::toPrivilegeString(
-                                 returnedUsers[0].getPrivileges())
+                                 user.getPrivileges())
                            + " but requires "
                            + ::toPrivilegeString(mPrivileges)};
         }
         mLogger->info("Validated public key for user "
-                    + returnedUsers[0].getName()
+                    + user.getName()
                     + " who has minimum privileges "
                     + ::toPrivilegeString(mPrivileges));
         return std::pair{okayStatus(), okayMessage()};
@@ -835,9 +1091,22 @@ public:
     //std::set<User, UserComparitor> mUsers;
     std::set<std::string> mBlacklist;
     std::set<std::string> mWhitelist;
+    std::shared_ptr<const ::IPAddressTrie> mBlacklistTrie{
+        std::make_shared<const ::IPAddressTrie> ()};
+    std::shared_ptr<const ::IPAddressTrie> mWhitelistTrie{
+        std::make_shared<const ::IPAddressTrie> ()};
+    std::unordered_map<std::string, User> mUsersByName;
+    std::unordered_map<std::string, std::string> mUserNameByPublicKey;
+    ::CredentialCache mCredentialCache;
     sqlite3 *mUsersTable{nullptr};
+    sqlite3_stmt *mDataVersionStatement{nullptr};
+    int64_t mDataVersion{-1};
     sqlite3 *mWhitelistTable{nullptr};
     sqlite3 *mBlacklistTable{nullptr};
+    sqlite3_stmt *mWhitelistDataVersionStatement{nullptr};
+    sqlite3_stmt *mBlacklistDataVersionStatement{nullptr};
+    int64_t mWhitelistDataVersion{-1};
+    int64_t mBlacklistDataVersion{-1};
     std::string mUsersTableFile;
     std::string mWhitelistTableFile;
     std::string mBlacklistTableFile;
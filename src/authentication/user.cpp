@@ -344,9 +344,8 @@ std::string User::toJSON(const int nIndent) const
 /// To CBOR
 std::string User::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    std::string result;
+    serializeInto(&result);
     return result;
 }
 
@@ -398,6 +397,13 @@ std::string User::toMessage() const
     return toCBOR();
 }
 
+void User::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    auto obj = toJSONObject(*this);
+    nlohmann::json::to_cbor(obj, *message);
+}
+
 /// Create class from message
 void User::fromMessage(const std::string &message)
 {
@@ -1,8 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <string_view>
 #include "umps/messageFormats/failure.hpp"
+#include "private/messageFormats/cbor.hpp"
 
 #define MESSAGE_TYPE "UMPS::MessageFormats::Failure"
 #define MESSAGE_VERSION "1.0.0"
@@ -12,39 +13,31 @@ using namespace UMPS::MessageFormats;
 namespace
 {
 
-nlohmann::json toJSONObject(const Failure &message)
+/// Create CBOR and append it to the message
+void toCBORMessage(const Failure &failure, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Details"] = message.getDetails();
-    return obj;
+    CBORWriter writer(message);
+    writer.writeMapHeader(3);
+    writer.write("Details", failure.getDetails());
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
-Failure objectToFailure(const nlohmann::json &obj)
+void fromCBORMessage(const uint8_t *message, const size_t length,
+                     Failure *failure)
 {
-    Failure message;
-    if (obj["MessageType"] != message.getMessageType())
-    {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    message.setDetails(obj["Details"].get<std::string> ());
-    return message;
-}
-
-/// Create CBOR
-std::string toCBORMessage(const Failure &message)
-{
-    auto obj = toJSONObject(message);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
-}
-
-Failure fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToFailure(obj);
+    std::string_view details;
+    bool haveDetails{false};
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key != "Details"){return false;}
+                        details = reader.readString();
+                        haveDetails = true;
+                        return true;
+                    });
+    if (!haveDetails){throw std::invalid_argument("Details not set");}
+    failure->setDetails(std::string {details});
 }
 
 }
@@ -113,7 +106,15 @@ std::string Failure::getDetails() const noexcept
 ///  Convert message
 std::string Failure::toMessage() const
 {
-    return ::toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void Failure::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void Failure::fromMessage(const std::string &message)
@@ -125,7 +126,7 @@ void Failure::fromMessage(const std::string &message)
 void Failure::fromMessage(const char *messageIn, const size_t length)
 {
     auto message = reinterpret_cast<const uint8_t *> (messageIn);
-    *this = ::fromCBORMessage(message, length);
+    ::fromCBORMessage(message, length, this);
 }
 
 /// Copy this class
@@ -1,3 +1,5 @@
+#include <string>
+#include <stdexcept>
 #include "umps/messageFormats/message.hpp"
 
 using namespace UMPS::MessageFormats;
@@ -5,6 +7,13 @@ using namespace UMPS::MessageFormats;
 /// Destructor
 IMessage::~IMessage() = default;
 
+/// Serialize into a buffer
+void IMessage::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    message->append(toMessage());
+}
+
 /*
 /// Sets a message from a string container
 void IMessage::fromMessage(const std::string &message)
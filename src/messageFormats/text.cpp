@@ -1,8 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <string_view>
 #include "umps/messageFormats/text.hpp"
+#include "private/messageFormats/cbor.hpp"
 
 #define MESSAGE_TYPE "UMPS::MessageFormats::Text"
 #define MESSAGE_VERSION "1.0.0"
@@ -12,39 +13,30 @@ using namespace UMPS::MessageFormats;
 namespace
 {
 
-nlohmann::json toJSONObject(const Text &text)
+/// Create CBOR and append it to the message
+void toCBORMessage(const Text &text, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = text.getMessageType();
-    obj["MessageVersion"] = text.getMessageVersion();
-    obj["Contents"] = text.getContents();
-    return obj;
+    CBORWriter writer(message);
+    writer.writeMapHeader(3);
+    writer.write("Contents", text.getContents());
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
-Text objectToText(const nlohmann::json &obj)
+void fromCBORMessage(const uint8_t *message, const size_t length, Text *text)
 {
-    Text text;
-    if (obj["MessageType"] != text.getMessageType())
-    {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    text.setContents(obj["Contents"].get<std::string> ());
-    return text;
-}
-
-/// Create CBOR
-std::string toCBORMessage(const Text &text)
-{
-    auto obj = toJSONObject(text);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
-}
-
-Text fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToText(obj);
+    std::string_view contents;
+    bool haveContents{false};
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key != "Contents"){return false;}
+                        contents = reader.readString();
+                        haveContents = true;
+                        return true;
+                    });
+    if (!haveContents){throw std::invalid_argument("Contents not set");}
+    text->setContents(std::string {contents});
 }
 
 }
@@ -112,7 +104,15 @@ std::string Text::getContents() const noexcept
 ///  Convert message
 std::string Text::toMessage() const
 {
-    return ::toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void Text::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void Text::fromMessage(const std::string &message)
@@ -124,7 +124,7 @@ void Text::fromMessage(const std::string &message)
 void Text::fromMessage(const char *messageIn, const size_t length)
 {
     auto message = reinterpret_cast<const uint8_t *> (messageIn);
-    *this = ::fromCBORMessage(message, length);
+    ::fromCBORMessage(message, length, this);
 }
 
 /// Copy this class
@@ -14,6 +14,7 @@ public:
     std::string mAddress;
     std::chrono::milliseconds mTimeOut{-1}; // Wait forever
     int mHighWaterMark = 0;
+    bool mSequenceNumbers{false};
 };
 
 /// C'tor
@@ -127,3 +128,19 @@ std::chrono::milliseconds PublisherOptions::getSendTimeOut() const noexcept
 {
     return pImpl->mTimeOut;
 }
+
+/// Sequence numbers
+void PublisherOptions::enableSequenceNumbers() noexcept
+{
+    pImpl->mSequenceNumbers = true;
+}
+
+void PublisherOptions::disableSequenceNumbers() noexcept
+{
+    pImpl->mSequenceNumbers = false;
+}
+
+bool PublisherOptions::sendSequenceNumbers() const noexcept
+{
+    return pImpl->mSequenceNumbers;
+}
@@ -12,6 +12,9 @@
 #include "umps/messageFormats/messages.hpp"
 #include "umps/services/connectionInformation/socketDetails/subscriber.hpp"
 #include "umps/logging/standardOut.hpp"
+#include "private/messageFormats/messageTypeRegistry.hpp"
+#include "private/messaging/sequenceStamp.hpp"
+#include "private/messaging/gapDetector.hpp"
 
 using namespace UMPS::Messaging::PublisherSubscriber;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -64,7 +67,84 @@ public:
         mSocketDetails.setSecurityLevel(mSecurityLevel);
         mSocketDetails.setConnectOrBind(UCI::ConnectOrBind::Bind);
     }
-    UMPS::MessageFormats::Messages mMessageTypes;
+    /// Receives the message type and payload into the reusable frames.
+    /// A publisher or federated proxy may append a sequence stamp frame
+    /// which is kept in its own frame and checked for gaps.  Returns false
+    /// if the receive timed out.
+    bool receiveFrames()
+    {
+        auto result = mSubscriber->recv(mTypeFrame);
+        if (!result){return false;}
+        if (!mTypeFrame.more())
+        {
+            mLogger->error("Only 2-part messages handled");
+            throw std::runtime_error("Only 2-part messages handled");
+        }
+        // The remaining parts of a multi-part message arrive atomically
+        result = mSubscriber->recv(mPayloadFrame);
+        if (!result)
+        {
+            throw std::runtime_error("Failed to receive message payload");
+        }
+        mHaveStampFrame = false;
+        if (mPayloadFrame.more())
+        {
+            result = mSubscriber->recv(mStampFrame);
+            if (!result)
+            {
+                throw std::runtime_error("Failed to receive message stamp");
+            }
+            mHaveStampFrame = true;
+        }
+        if (mHaveStampFrame && mStampFrame.more())
+        {
+            // Drain the remaining parts so the next receive is aligned
+            while (mStampFrame.more())
+            {
+                static_cast<void> (mSubscriber->recv(mStampFrame));
+            }
+            mHaveStampFrame = false;
+            mLogger->error("Only 2 and 3-part messages handled");
+            throw std::runtime_error("Only 2 and 3-part messages handled");
+        }
+        if (mHaveStampFrame)
+        {
+            ::SequenceStamp stamp;
+            if (::unpackSequenceStamp(
+                    std::string_view{static_cast<const char *>
+                                     (mStampFrame.data()),
+                                     mStampFrame.size()}, &stamp))
+            {
+                mGapDetector.update(getFrameMessageType(), stamp);
+            }
+        }
+        return true;
+    }
+    /// The message type of the last received frame
+    [[nodiscard]] std::string_view getFrameMessageType() const noexcept
+    {
+        return std::string_view{static_cast<const char *> (mTypeFrame.data()),
+                                mTypeFrame.size()};
+    }
+    /// Looks up and validates the message type of a caller-owned message.
+    const std::string &getMessageType(
+        const UMPS::MessageFormats::IMessage &message) const
+    {
+        auto id = mMessageTypes.find(message);
+        if (id < 0)
+        {
+            throw std::invalid_argument("Message type: "
+                                      + message.getMessageType()
+                                      + " not subscribed to");
+        }
+        return mMessageTypes.getMessageType(id);
+    }
+    ::MessageTypeRegistry mMessageTypes;
+    ::MessagePool mMessagePool;
+    ::GapDetector mGapDetector;
+    zmq::message_t mTypeFrame;
+    zmq::message_t mPayloadFrame;
+    zmq::message_t mStampFrame;
     std::shared_ptr<UMPS::Messaging::Context> mContext{nullptr};
     std::unique_ptr<zmq::socket_t> mSubscriber{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
@@ -74,6 +154,7 @@ public:
     UAuth::SecurityLevel mSecurityLevel{UAuth::SecurityLevel::Grasslands};
     bool mInitialized{false};
     bool mConnected{false};
+    bool mHaveStampFrame{false};
 };
 
 /// Constructors
@@ -165,13 +246,18 @@ void Subscriber::initialize(const SubscriberOptions &options)
     }
     pImpl->mConnected = true;
     // Add the subscriptions
-    pImpl->mMessageTypes = pImpl->mOptions.getMessageTypes();
-    auto messageTypeMap = pImpl->mMessageTypes.get();
-    for (const auto &messageType : messageTypeMap)
+    pImpl->mMessageTypes
+        = ::MessageTypeRegistry(pImpl->mOptions.getMessageTypes());
+    pImpl->mMessagePool.reset(pImpl->mMessageTypes);
+    // Streams from the previous connection aren't continued
+    pImpl->mGapDetector.clear();
+    pImpl->mGapDetector.setCallback(pImpl->mOptions.getGapCallback());
+    for (int id = 0; id < pImpl->mMessageTypes.size(); ++id)
     {
+        const auto &messageType = pImpl->mMessageTypes.getMessageType(id);
         pImpl->mLogger->debug("Subscriber adding subscription type "
-                             + messageType.first);
-        pImpl->mSubscriber->set(zmq::sockopt::subscribe, messageType.first);
+                             + messageType);
+        pImpl->mSubscriber->set(zmq::sockopt::subscribe, messageType);
     }
     // Set some final details
     pImpl->mSecurityLevel = zapOptions.getSecurityLevel();
@@ -185,6 +271,22 @@ bool Subscriber::isInitialized() const noexcept
     return pImpl->mInitialized;
 }
 
+/// Gap detection
+uint64_t Subscriber::getNumberOfSequencedMessages() const noexcept
+{
+    return pImpl->mGapDetector.getNumberOfSequencedMessages();
+}
+
+uint64_t Subscriber::getNumberOfMissedMessages() const noexcept
+{
+    return pImpl->mGapDetector.getNumberOfMissedMessages();
+}
+
+uint64_t Subscriber::getNumberOfGaps() const noexcept
+{
+    return pImpl->mGapDetector.getNumberOfGaps();
+}
+
 /// Disconnect from endpoint
 void Subscriber::disconnect()
 {
@@ -196,41 +298,85 @@ void Subscriber::disconnect()
 std::unique_ptr<UMPS::MessageFormats::IMessage> Subscriber::receive() const
 {
     if (!isInitialized()){throw std::runtime_error("Class not initialized");}
-    // Receive all parts of the message
-    zmq::multipart_t messagesReceived(*pImpl->mSubscriber);
-    if (messagesReceived.empty()){return nullptr;}
-#ifndef NDEBUG
-    assert(static_cast<int> (messagesReceived.size()) == 2);
-#else
-    if (static_cast<int> (messagesReceived.size()) != 2)
-    {
-        pImpl->mLogger->error("Only 2-part messages handled");
-        throw std::runtime_error("Only 2-part messages handled");
-    }
-#endif
-    std::string messageType = messagesReceived.at(0).to_string();
-    if (!pImpl->mMessageTypes.contains(messageType))
-    {
-        auto errorMsg = "Unhandled message type: " + messageType;
+    if (!pImpl->receiveFrames()){return nullptr;} // Timeout
+    auto messageType = pImpl->getFrameMessageType();
+    auto id = pImpl->mMessageTypes.find(messageType);
+    if (id < 0)
+    {
+        auto errorMsg = "Unhandled message type: " + std::string{messageType};
         pImpl->mLogger->error(errorMsg); 
         throw std::runtime_error(errorMsg);
     }
-    const auto payload = static_cast<char *> (messagesReceived.at(1).data());
-    auto messageLength = messagesReceived.at(1).size();
-    auto result = pImpl->mMessageTypes.get(messageType);
+    auto result = pImpl->mMessagePool.acquire(id);
     try
     {
-        result->fromMessage(payload, messageLength);
+        result->fromMessage(
+            static_cast<const char *> (pImpl->mPayloadFrame.data()),
+            pImpl->mPayloadFrame.size());
     }
     catch (const std::exception &e)
     {
-        auto errorMsg = "Failed to unpack message of type: " + messageType;
+        auto errorMsg = "Failed to unpack message of type: "
+                      + std::string{messageType}
+                      + " with error: " + std::string(e.what());
         pImpl->mLogger->error(errorMsg);
+        pImpl->mMessagePool.release(std::move(result));
         throw;
     }
     return result;
 }
 
+/// Recycle a message
+void Subscriber::recycle(
+    std::unique_ptr<UMPS::MessageFormats::IMessage> &&message) const
+{
+    pImpl->mMessagePool.release(std::move(message));
+}
+
+/// Receive a message into a caller-owned message
+bool Subscriber::receive(UMPS::MessageFormats::IMessage *message) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    const auto &expectedMessageType = pImpl->getMessageType(*message);
+    if (!pImpl->receiveFrames()){return false;}
+    auto messageType = pImpl->getFrameMessageType();
+    if (messageType != expectedMessageType)
+    {
+        auto errorMsg = "Received message type: " + std::string{messageType}
+                      + " but expected: " + expectedMessageType;
+        pImpl->mLogger->error(errorMsg);
+        throw std::runtime_error(errorMsg);
+    }
+    try
+    {
+        message->fromMessage(
+            static_cast<const char *> (pImpl->mPayloadFrame.data()),
+            pImpl->mPayloadFrame.size());
+    }
+    catch (const std::exception &e)
+    {
+        auto errorMsg = "Failed to unpack message of type: "
+                      + expectedMessageType
+                      + " with error: " + std::string(e.what());
+        pImpl->mLogger->error(errorMsg);
+        throw;
+    }
+    return true;
+}
+
+/// Receive a view of the message
+UMPS::Messaging::MessageView Subscriber::receiveView() const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (!pImpl->receiveFrames()){return UMPS::Messaging::MessageView {};}
+    std::span<const char> payload{
+        static_cast<const char *> (pImpl->mPayloadFrame.data()),
+        pImpl->mPayloadFrame.size()};
+    return UMPS::Messaging::MessageView {pImpl->getFrameMessageType(),
+                                         payload};
+}
+
 /// Socket details
 UCI::SocketDetails::Subscriber Subscriber::getSocketDetails() const
 {
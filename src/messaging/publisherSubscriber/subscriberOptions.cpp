@@ -12,6 +12,8 @@ class SubscriberOptions::SubscriberOptionsImpl
 public:
     UAuth::ZAPOptions mZAPOptions;
     UMPS::MessageFormats::Messages mMessageTypes;
+    std::function<void (uint64_t, std::string_view, uint64_t)>
+        mGapCallback{nullptr};
     std::string mAddress;
     std::chrono::milliseconds mTimeOut{-1};
     int mHighWaterMark = 0;
@@ -153,3 +155,18 @@ bool SubscriberOptions::haveMessageTypes() const noexcept
 {
     return !pImpl->mMessageTypes.empty();
 }
+
+/// Gap callback
+void SubscriberOptions::setGapCallback(
+    const std::function<void (uint64_t publisher,
+                              std::string_view messageType,
+                              uint64_t nMissed)> &callback)
+{
+    pImpl->mGapCallback = callback;
+}
+
+std::function<void (uint64_t, std::string_view, uint64_t)>
+    SubscriberOptions::getGapCallback() const
+{
+    return pImpl->mGapCallback;
+}
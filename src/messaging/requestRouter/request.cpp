@@ -14,6 +14,7 @@
 #include "umps/messageFormats/messages.hpp"
 #include "umps/services/connectionInformation/socketDetails/request.hpp"
 #include "umps/logging/standardOut.hpp"
+#include "private/messageFormats/messageTypeRegistry.hpp"
 
 using namespace UMPS::Messaging::RequestRouter;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -59,11 +60,12 @@ public:
 //private:
     //std::map<std::string, std::unique_ptr<UMPS::MessageFormats::IMessage>> 
     //    mSubscriptions;
-    UMPS::MessageFormats::Messages mMessageFormats;
+    ::MessageTypeRegistry mMessageFormats;
     RequestOptions mOptions;
     std::shared_ptr<UMPS::Messaging::Context> mContext{nullptr};
     std::unique_ptr<zmq::socket_t> mClient{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
+    std::string mSendBuffer;
     std::string mAddress;
     UCI::SocketDetails::Request mSocketDetails;
     int mHighWaterMark{200};
@@ -101,7 +103,8 @@ void Request::initialize(const RequestOptions &options)
     {
         throw std::invalid_argument("End point not set");
     }
-    pImpl->mMessageFormats = options.getMessageFormats();
+    pImpl->mMessageFormats
+        = ::MessageTypeRegistry(options.getMessageFormats());
     if (pImpl->mMessageFormats.empty())
     {
         pImpl->mLogger->warn("No message types set in options");
@@ -191,7 +194,9 @@ std::unique_ptr<UMPS::MessageFormats::IMessage>
         pImpl->mLogger->error("Message type is empty");
     }
     //auto requestMessage = request.toCBOR();
-    auto requestMessage = request.toMessage();
+    pImpl->mSendBuffer.clear();
+    request.serializeInto(&pImpl->mSendBuffer);
+    const auto &requestMessage = pImpl->mSendBuffer;
     if (requestMessage.empty())
     {
         pImpl->mLogger->error("Message contents is empty");
@@ -219,16 +224,17 @@ std::unique_ptr<UMPS::MessageFormats::IMessage>
     }
 #endif
     // Unpack the response
-    std::string responseMessageType = responseReceived.at(0).to_string();
-    if (!pImpl->mMessageFormats.contains(responseMessageType))
+    auto responseMessageType = responseReceived.at(0).to_string_view();
+    auto id = pImpl->mMessageFormats.find(responseMessageType);
+    if (id < 0)
     {
         throw std::runtime_error("Unhandled response type: "
-                               + responseMessageType);
+                               + std::string {responseMessageType});
     }
     const auto payload
          = static_cast<const char *> (responseReceived.at(1).data());
     auto responseLength = responseReceived.at(1).size();
-    auto response = pImpl->mMessageFormats.get(responseMessageType);
+    auto response = pImpl->mMessageFormats.createInstance(id);
     try
     {
         response->fromMessage(payload, responseLength);
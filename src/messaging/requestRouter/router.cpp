@@ -1,4 +1,6 @@
 #include <string>
+#include <vector>
+#include <sstream>
 #include <thread>
 #include <mutex>
 #ifndef NDEBUG
@@ -11,6 +13,7 @@
 #include "umps/messaging/context.hpp"
 #include "umps/authentication/zapOptions.hpp"
 #include "umps/messageFormats/message.hpp"
+#include "umps/messageFormats/failure.hpp"
 #include "umps/services/connectionInformation/socketDetails/router.hpp"
 #include "umps/logging/standardOut.hpp"
 #include "private/messaging/ipcDirectory.hpp"
@@ -94,6 +97,136 @@ public:
         mSocketDetails.setSecurityLevel(mSecurityLevel);
         mSocketDetails.setConnectOrBind(UCI::ConnectOrBind::Connect);
     }
+    /// Runs the callback on a request and sends the reply on the socket.
+    /// The request is the [identity, delimiter, message type, payload]
+    /// envelope and the reply is sent with the same envelope.
+    void processRequest(const zmq::multipart_t &messagesReceived,
+                        zmq::socket_t *socket,
+                        std::string *sendBuffer,
+                        const UMPS::Logging::Level logLevel)
+    {
+#ifndef NDEBUG
+        assert(messagesReceived.size() == 4);
+#else
+        if (messagesReceived.size() != 4)
+        {
+            mLogger->error("Only 2-part messages handled");
+            return;
+        }
+#endif
+        std::string messageType = messagesReceived.at(2).to_string();
+        auto messageContents = reinterpret_cast<const void *>
+                               (messagesReceived.at(3).data());
+        auto messageSize = messagesReceived.at(3).size();
+        auto response = mCallback(messageType, messageContents, messageSize);
+        // Send the response back
+        auto responseMessageType = response->getMessageType();
+        sendBuffer->clear();
+        response->serializeInto(sendBuffer);
+        const auto &responseMessage = *sendBuffer;
+        if (responseMessage.empty())
+        {
+            mLogger->warn("Router received empty message");
+        }
+        if (logLevel >= UMPS::Logging::Level::Debug)
+        {
+            mLogger->debug("Replying...");
+        }
+        zmq::const_buffer zmqHdr1{messagesReceived.at(0).data(),
+                                  messagesReceived.at(0).size()};
+        socket->send(zmqHdr1, zmq::send_flags::sndmore);
+        zmq::const_buffer zmqHdr2{messagesReceived.at(1).data(),
+                                  messagesReceived.at(1).size()};
+        socket->send(zmqHdr2, zmq::send_flags::sndmore);
+        zmq::const_buffer header{responseMessageType.data(),
+                                 responseMessageType.size()};
+        socket->send(header, zmq::send_flags::sndmore);
+        zmq::const_buffer responseBuffer{responseMessage.data(),
+                                         responseMessage.size()};
+        socket->send(responseBuffer);
+    }
+    /// Replies to a request that could not be processed with a failure
+    /// message so the client is not left waiting for its time out.
+    void sendFailure(const zmq::multipart_t &messagesReceived,
+                     zmq::socket_t *socket,
+                     std::string *sendBuffer,
+                     const std::string &details)
+    {
+        if (messagesReceived.size() < 2){return;}
+        UMPS::MessageFormats::Failure failure;
+        failure.setDetails(details);
+        auto failureMessageType = failure.getMessageType();
+        sendBuffer->clear();
+        failure.serializeInto(sendBuffer);
+        zmq::const_buffer zmqHdr1{messagesReceived.at(0).data(),
+                                  messagesReceived.at(0).size()};
+        socket->send(zmqHdr1, zmq::send_flags::sndmore);
+        zmq::const_buffer zmqHdr2{messagesReceived.at(1).data(),
+                                  messagesReceived.at(1).size()};
+        socket->send(zmqHdr2, zmq::send_flags::sndmore);
+        zmq::const_buffer header{failureMessageType.data(),
+                                 failureMessageType.size()};
+        socket->send(header, zmq::send_flags::sndmore);
+        zmq::const_buffer failureBuffer{sendBuffer->data(),
+                                        sendBuffer->size()};
+        socket->send(failureBuffer);
+    }
+    /// Worker thread.  This receives requests, with their envelopes, from
+    /// the backend and returns the replies to the backend.
+    void runWorker(const std::string &backendAddress)
+    {
+        auto contextPtr = reinterpret_cast<zmq::context_t *>
+                          (mContext->getContext());
+        zmq::socket_t worker(*contextPtr, zmq::socket_type::dealer);
+        worker.set(zmq::sockopt::linger, 0);
+        worker.connect(backendAddress);
+        std::string sendBuffer;
+        auto logLevel = mLogger->getLevel();
+        zmq::pollitem_t items[] =
+        {
+            {worker.handle(), 0, ZMQ_POLLIN, 0}
+        };
+        while (isRunning())
+        {
+            zmq::poll(&items[0], 1, mPollTimeOutMS);
+            if (items[0].revents & ZMQ_POLLIN)
+            {
+                zmq::multipart_t messagesReceived(worker);
+                if (messagesReceived.empty()){continue;}
+                try
+                {
+                    processRequest(messagesReceived, &worker, &sendBuffer,
+                                   logLevel);
+                }
+                catch (const std::exception &e)
+                {
+                    auto errorMessage = "Worker failed to process request: "
+                                      + std::string {e.what()};
+                    mLogger->error(errorMessage);
+                    try
+                    {
+                        sendFailure(messagesReceived, &worker, &sendBuffer,
+                                    errorMessage);
+                    }
+                    catch (const std::exception &failureError)
+                    {
+                        mLogger->error("Worker failed to send failure: "
+                                     + std::string {failureError.what()});
+                    }
+                }
+            }
+        }
+    }
+    /// Runs the service with a pool of workers
+    void runWithWorkers();
+    /// Creates a unique inproc address for the workers' backend
+    [[nodiscard]] std::string makeBackendAddress() const
+    {
+        std::ostringstream address;
+        address << "inproc://umps.requestRouter.workers."
+                << static_cast<const void *> (this);
+        return address.str();
+    }
 //    std::map<std::string, std::unique_ptr<UMPS::MessageFormats::IMessage>> 
         //mSubscriptions;
 //    UMPS::MessageFormats::Messages mMessageFormats;
@@ -111,14 +244,76 @@ public:
     // wait indefinitely.
     std::chrono::milliseconds mPollTimeOutMS{10};
     mutable std::mutex mMutex;
+    std::string mSendBuffer;
     std::string mAddress;
     int mHighWaterMark{100};
+    int mWorkers{1};
     UAuth::SecurityLevel mSecurityLevel{UAuth::SecurityLevel::Grasslands};
     bool mBound{false};
     bool mRunning{false};
     bool mInitialized{false};
 };
 
+/// Starts the service with a pool of workers
+void Router::RouterImpl::runWithWorkers()
+{
+    // The backend hands requests to the workers.  Since the workers are
+    // DEALERs the full envelope, including the client's identity, is
+    // passed through to the workers and returned with the replies.
+    auto contextPtr = reinterpret_cast<zmq::context_t *>
+                      (mContext->getContext());
+    zmq::socket_t backend(*contextPtr, zmq::socket_type::dealer);
+    backend.set(zmq::sockopt::linger, 0);
+    auto backendAddress = makeBackendAddress();
+    backend.bind(backendAddress);
+    // Poll setup
+    constexpr size_t nPollItems = 2;
+    zmq::pollitem_t items[] =
+    {
+        {mServer->handle(), 0, ZMQ_POLLIN, 0},
+        {backend.handle(),  0, ZMQ_POLLIN, 0}
+    };
+    start();
+    mLogger->debug("Starting " + std::to_string(mWorkers)
+                 + " router workers");
+    std::vector<std::thread> workers;
+    workers.reserve(mWorkers);
+    for (int i = 0; i < mWorkers; ++i)
+    {
+        workers.push_back(std::thread(&RouterImpl::runWorker, this,
+                                      backendAddress));
+    }
+    auto logLevel = mLogger->getLevel();
+    while (isRunning())
+    {
+        zmq::poll(&items[0], nPollItems, mPollTimeOutMS);
+        // Requests from clients are dealt round-robin to the workers
+        if (items[0].revents & ZMQ_POLLIN)
+        {
+            zmq::multipart_t messagesReceived(*mServer);
+            if (!messagesReceived.empty())
+            {
+                if (logLevel >= UMPS::Logging::Level::Debug)
+                {
+                    mLogger->debug("Message received!");
+                }
+                messagesReceived.send(backend);
+            }
+        }
+        // Replies from the workers go back to the clients
+        if (items[1].revents & ZMQ_POLLIN)
+        {
+            zmq::multipart_t reply(backend);
+            if (!reply.empty()){reply.send(*mServer);}
+        }
+    }
+    for (auto &worker : workers)
+    {
+        if (worker.joinable()){worker.join();}
+    }
+    mLogger->debug("Service loop finished");
+}
+
 /// C'tor
 Router::Router() :
     pImpl(std::make_unique<RouterImpl> (nullptr, nullptr))
@@ -203,6 +398,7 @@ void Router::initialize(const RouterOptions &options)
     pImpl->mServer->set(zmq::sockopt::sndhwm, highWaterMark); 
     // Set the callback 
     pImpl->mCallback = pImpl->mOptions.getCallback(); 
+    pImpl->mWorkers = pImpl->mOptions.getNumberOfWorkers();
     // Bind
     pImpl->mServer->bind(address);
     // Resolve end point
@@ -231,6 +427,11 @@ void Router::start()
          throw std::runtime_error("Router not initialized");
     }
     stop(); // Make sure service is stopped
+    if (pImpl->mWorkers > 1)
+    {
+        pImpl->runWithWorkers();
+        return;
+    }
     // Poll setup
     constexpr size_t nPollItems = 1;
     zmq::pollitem_t items[] =
@@ -251,66 +452,8 @@ void Router::start()
             {
                 pImpl->mLogger->debug("Message received!");
             }
-/*
-std::cout << messagesReceived.size() << std::endl;
-std::cout << messagesReceived.at(0).to_string() << std::endl;
-std::cout << messagesReceived.at(1).to_string() << std::endl;
-std::cout << messagesReceived.at(2).to_string() << std::endl;
-std::cout << messagesReceived.at(3).to_string() << std::endl;
-*/
-#ifndef NDEBUG
-            assert(messagesReceived.size() == 4);
-#else
-            if (messagesReceived.size() != 4)
-            {
-                pImpl->mLogger->error("Only 2-part messages handled");
-                continue; 
-            }
-#endif
-            std::string messageType = messagesReceived.at(2).to_string();
-/*
-            if (!pImpl->mMessageFormats.contains(messageType))
-            {
-                auto errorMsg = "Unhandled message type: " + messageType;
-                pImpl->mLogger->error(errorMsg);
-                continue;
-            }
-            auto index = pImpl->mSubscriptions.find(messageType);
-            if (index == pImpl->mSubscriptions.end())
-            {
-                auto errorMsg = "Unhandled message type: " + messageType;
-                pImpl->mLogger->error(errorMsg);
-                continue;
-            }
-*/
-            auto messageContents = reinterpret_cast<const void *>
-                                   (messagesReceived.at(3).data());
-            auto messageSize = messagesReceived.at(3).size();
-            auto response = pImpl->mCallback(messageType,
-                                             messageContents, messageSize);
-            // Send the response back
-            auto responseMessageType = response->getMessageType();
-            auto responseMessage = response->toMessage(); 
-            if (responseMessage.empty())
-            {
-                pImpl->mLogger->warn("Router received empty message");
-            }
-            if (logLevel >= UMPS::Logging::Level::Debug)
-            {
-                pImpl->mLogger->debug("Replying...");
-            }
-            zmq::const_buffer zmqHdr1{messagesReceived.at(0).data(),
-                                      messagesReceived.at(0).size()};
-            pImpl->mServer->send(zmqHdr1, zmq::send_flags::sndmore);
-            zmq::const_buffer zmqHdr2{messagesReceived.at(1).data(),
-                                      messagesReceived.at(1).size()};
-            pImpl->mServer->send(zmqHdr2, zmq::send_flags::sndmore);
-            zmq::const_buffer header{responseMessageType.data(),
-                                     responseMessageType.size()};
-            pImpl->mServer->send(header, zmq::send_flags::sndmore);
-            zmq::const_buffer responseBuffer{responseMessage.data(),
-                                             responseMessage.size()};
-            pImpl->mServer->send(responseBuffer);
+            pImpl->processRequest(messagesReceived, &*pImpl->mServer,
+                                  &pImpl->mSendBuffer, logLevel);
         }
     }
     pImpl->mLogger->debug("Service loop finished");
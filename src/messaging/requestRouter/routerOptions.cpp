@@ -23,6 +23,7 @@ public:
     > mCallback;
     std::chrono::milliseconds mPollTimeOutInMilliSeconds{10};
     int mHighWaterMark = 0;
+    int mWorkers = 1;
     bool mHaveCallback = false;
 };
 
@@ -116,6 +117,21 @@ int RouterOptions::getHighWaterMark() const noexcept
     return pImpl->mHighWaterMark;
 }
 
+/// Number of workers
+void RouterOptions::setNumberOfWorkers(const int nWorkers)
+{
+    if (nWorkers < 1)
+    {
+        throw std::invalid_argument("Number of workers must be positive");
+    }
+    pImpl->mWorkers = nWorkers;
+}
+
+int RouterOptions::getNumberOfWorkers() const noexcept
+{
+    return pImpl->mWorkers;
+}
+
 /// Sets the timeout
 void RouterOptions::setPollTimeOut(
     const std::chrono::milliseconds &timeOut) noexcept
@@ -0,0 +1,469 @@
+#include <string>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstring>
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+#include "umps/messaging/routerDealer/asynchronousRequest.hpp"
+#include "umps/messaging/routerDealer/requestOptions.hpp"
+#include "umps/messaging/context.hpp"
+#include "umps/authentication/zapOptions.hpp"
+#include "umps/messageFormats/message.hpp"
+#include "umps/messageFormats/messages.hpp"
+#include "umps/services/connectionInformation/socketDetails/dealer.hpp"
+#include "umps/logging/standardOut.hpp"
+#include "private/messaging/requestReplySocket.hpp"
+
+using namespace UMPS::Messaging::RouterDealer;
+namespace UCI = UMPS::Services::ConnectionInformation;
+
+namespace
+{
+/// A request that is awaiting its response.
+struct PendingRequest
+{
+    std::promise<std::unique_ptr<UMPS::MessageFormats::IMessage>> promise;
+    AsynchronousRequest::Callback callback;
+    std::chrono::steady_clock::time_point deadline;
+    bool haveCallback{false};
+    bool haveDeadline{false};
+};
+}
+
+class AsynchronousRequest::AsynchronousRequestImpl :
+    public ::RequestReplySocket
+{
+public:
+    /// C'tor
+    AsynchronousRequestImpl(
+        const std::shared_ptr<UMPS::Messaging::Context> &context,
+        const std::shared_ptr<UMPS::Logging::ILog> &logger) :
+        RequestReplySocket(zmq::socket_type::dealer, context, logger)
+    {
+    }
+    /// Destructor
+    ~AsynchronousRequestImpl() override
+    {
+        disconnect();
+    }
+    /// Creates the inproc pipe on which requests are handed to the
+    /// background thread.  A ZeroMQ socket cannot be shared between
+    /// threads so the requesting threads never touch the DEALER socket.
+    void createPipe()
+    {
+        auto contextPtr = reinterpret_cast<zmq::context_t *>
+                          (mContext->getContext());
+        std::ostringstream address;
+        address << "inproc://umps.routerDealer.asynchronousRequest."
+                << static_cast<const void *> (this);
+        mPipeReceiver = std::make_unique<zmq::socket_t>
+                        (*contextPtr, zmq::socket_type::pair);
+        mPipeReceiver->set(zmq::sockopt::linger, 0);
+        mPipeReceiver->set(zmq::sockopt::rcvhwm, 0);
+        mPipeReceiver->bind(address.str());
+        mPipeSender = std::make_unique<zmq::socket_t>
+                      (*contextPtr, zmq::socket_type::pair);
+        mPipeSender->set(zmq::sockopt::linger, 0);
+        mPipeSender->set(zmq::sockopt::sndhwm, 0);
+        mPipeSender->connect(address.str());
+    }
+    /// Stops the background thread, completes the outstanding requests,
+    /// and disconnects.
+    void disconnect() override
+    {
+        {
+        std::scoped_lock lock(mPendingMutex);
+        mAccepting = false;
+        }
+        mWindowCondition.notify_all();
+        stop();
+        std::map<uint64_t, ::PendingRequest> abandoned;
+        {
+        std::scoped_lock lock(mPendingMutex);
+        abandoned.swap(mPending);
+        mPipeSender = nullptr;
+        mPipeReceiver = nullptr;
+        }
+        if (!abandoned.empty())
+        {
+            mLogger->warn(std::to_string(abandoned.size())
+                        + " requests abandoned on disconnect");
+        }
+        for (auto &pending : abandoned)
+        {
+            complete(std::move(pending.second), nullptr, nullptr);
+        }
+        RequestReplySocket::disconnect();
+    }
+    /// Hands a request to the background thread.  This blocks while the
+    /// window is full.
+    void submit(const UMPS::MessageFormats::IMessage &request,
+                ::PendingRequest &&pending)
+    {
+        auto messageType = request.getMessageType();
+        std::string payload;
+        request.serializeInto(&payload);
+        std::unique_lock lock(mPendingMutex);
+        mWindowCondition.wait(lock, [this]
+                              {
+                                  return !mAccepting ||
+                                         static_cast<int> (mPending.size())
+                                       < mWindow;
+                              });
+        if (!mAccepting){throw std::runtime_error("Requestor not running");}
+        auto identifier = mNextIdentifier;
+        mNextIdentifier = mNextIdentifier + 1;
+        if (mTimeOut.count() >= 0)
+        {
+            pending.deadline = std::chrono::steady_clock::now() + mTimeOut;
+            pending.haveDeadline = true;
+        }
+        mPending.emplace(identifier, std::move(pending));
+        try
+        {
+            zmq::const_buffer identifierBuffer{&identifier,
+                                               sizeof(identifier)};
+            mPipeSender->send(identifierBuffer, zmq::send_flags::sndmore);
+            zmq::const_buffer header{messageType.data(), messageType.size()};
+            mPipeSender->send(header, zmq::send_flags::sndmore);
+            zmq::const_buffer buffer{payload.data(), payload.size()};
+            mPipeSender->send(buffer, zmq::send_flags::none);
+        }
+        catch (...)
+        {
+            mPending.erase(identifier);
+            throw;
+        }
+    }
+    /// The background thread's loop.  This forwards requests to the
+    /// DEALER socket, matches responses to requests, and expires requests
+    /// that have timed out.
+    void poll() override
+    {
+        mLogger->debug("Starting asynchronous request loop...");
+        while (isRunning())
+        {
+            std::array<zmq::pollitem_t, 2> pollItems
+            {
+                {{mSocket->handle(),       0, ZMQ_POLLIN, 0},
+                 {mPipeReceiver->handle(), 0, ZMQ_POLLIN, 0}}
+            };
+            zmq::poll(pollItems.data(), pollItems.size(), mPollingTimeOut);
+            if (pollItems[1].revents & ZMQ_POLLIN){forwardRequests();}
+            if (pollItems[0].revents & ZMQ_POLLIN){receiveResponses();}
+            expireRequests();
+        }
+        mLogger->debug("Asynchronous request loop finished");
+    }
+    /// Moves the requests from the pipe to the DEALER socket.  The
+    /// correlation identifier is followed by an empty delimiter frame so
+    /// that a REP socket treats the identifier as part of the envelope
+    /// and returns it with the reply.
+    void forwardRequests()
+    {
+        while (true)
+        {
+            zmq::multipart_t request;
+            if (!request.recv(*mPipeReceiver, ZMQ_DONTWAIT)){break;}
+            if (request.size() != 3)
+            {
+                mLogger->error("Internal request has wrong number of parts");
+                continue;
+            }
+            uint64_t identifier{0};
+            std::memcpy(&identifier, request.at(0).data(), sizeof(identifier));
+            zmq::multipart_t envelope;
+            envelope.add(request.pop());
+            envelope.addmem(nullptr, 0);
+            envelope.add(request.pop());
+            envelope.add(request.pop());
+            bool sent{false};
+            try
+            {
+                sent = envelope.send(*mSocket);
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Failed to send request: "
+                             + std::string {e.what()});
+            }
+            if (!sent)
+            {
+                mLogger->warn("Request send timed out");
+                auto pending = takePending(identifier);
+                if (pending){complete(std::move(*pending), nullptr, nullptr);}
+            }
+        }
+    }
+    /// Matches the responses on the DEALER socket to their requests.
+    void receiveResponses()
+    {
+        while (true)
+        {
+            zmq::multipart_t response;
+            if (!response.recv(*mSocket, ZMQ_DONTWAIT)){break;}
+            if (response.size() != 4 ||
+                response.at(0).size() != sizeof(uint64_t))
+            {
+                mLogger->error("Unhandled response with "
+                             + std::to_string(response.size()) + " parts");
+                continue;
+            }
+            uint64_t identifier{0};
+            std::memcpy(&identifier, response.at(0).data(),
+                        sizeof(identifier));
+            auto pending = takePending(identifier);
+            if (!pending)
+            {
+                mLogger->warn("Discarding response to expired request");
+                continue;
+            }
+            std::unique_ptr<UMPS::MessageFormats::IMessage> message{nullptr};
+            std::exception_ptr error{nullptr};
+            try
+            {
+                auto messageType = response.at(2).to_string_view();
+                auto id = mMessageFormats.find(messageType);
+                if (id < 0)
+                {
+                    throw std::runtime_error("Unhandled response type: "
+                                           + std::string {messageType});
+                }
+                message = mMessageFormats.createInstance(id);
+                message->fromMessage(
+                    static_cast<const char *> (response.at(3).data()),
+                    response.at(3).size());
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Failed to unpack response: "
+                             + std::string {e.what()});
+                message = nullptr;
+                error = std::current_exception();
+            }
+            complete(std::move(*pending), std::move(message), error);
+        }
+    }
+    /// Completes the requests whose deadlines have passed.  Since every
+    /// request has the same time out the deadlines increase with the
+    /// identifier so only the front of the table needs to be checked.
+    void expireRequests()
+    {
+        std::vector<::PendingRequest> expired;
+        {
+        std::scoped_lock lock(mPendingMutex);
+        auto now = std::chrono::steady_clock::now();
+        while (!mPending.empty())
+        {
+            auto front = mPending.begin();
+            if (!front->second.haveDeadline ||
+                front->second.deadline > now)
+            {
+                break;
+            }
+            expired.push_back(std::move(front->second));
+            mPending.erase(front);
+        }
+        }
+        if (expired.empty()){return;}
+        mWindowCondition.notify_all();
+        for (auto &pending : expired)
+        {
+            mLogger->warn("Request timed out");
+            complete(std::move(pending), nullptr, nullptr);
+        }
+    }
+    /// Removes the request from the table of outstanding requests.
+    [[nodiscard]] std::unique_ptr<::PendingRequest>
+        takePending(const uint64_t identifier)
+    {
+        std::unique_ptr<::PendingRequest> result{nullptr};
+        {
+        std::scoped_lock lock(mPendingMutex);
+        auto it = mPending.find(identifier);
+        if (it == mPending.end()){return result;}
+        result = std::make_unique<::PendingRequest> (std::move(it->second));
+        mPending.erase(it);
+        }
+        mWindowCondition.notify_one();
+        return result;
+    }
+    /// Delivers the response to the future or callback.
+    void complete(::PendingRequest &&pending,
+                  std::unique_ptr<UMPS::MessageFormats::IMessage> &&message,
+                  const std::exception_ptr &error)
+    {
+        if (pending.haveCallback)
+        {
+            try
+            {
+                pending.callback(std::move(message));
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Error in response callback: "
+                             + std::string {e.what()});
+            }
+            return;
+        }
+        if (error)
+        {
+            pending.promise.set_exception(error);
+        }
+        else
+        {
+            pending.promise.set_value(std::move(message));
+        }
+    }
+///private:
+    mutable std::mutex mPendingMutex;
+    std::condition_variable mWindowCondition;
+    std::map<uint64_t, ::PendingRequest> mPending;
+    std::unique_ptr<zmq::socket_t> mPipeSender{nullptr};
+    std::unique_ptr<zmq::socket_t> mPipeReceiver{nullptr};
+    RequestOptions mRequestOptions;
+    std::chrono::milliseconds mTimeOut{-1};
+    uint64_t mNextIdentifier{0};
+    int mWindow{32};
+    bool mAccepting{false};
+};
+
+/// C'tor
+AsynchronousRequest::AsynchronousRequest() :
+    pImpl(std::make_unique<AsynchronousRequestImpl> (nullptr, nullptr))
+{
+}
+
+AsynchronousRequest::AsynchronousRequest(
+    std::shared_ptr<UMPS::Logging::ILog> &logger) :
+    pImpl(std::make_unique<AsynchronousRequestImpl> (nullptr, logger))
+{
+}
+
+AsynchronousRequest::AsynchronousRequest(
+    std::shared_ptr<UMPS::Messaging::Context> &context) :
+    pImpl(std::make_unique<AsynchronousRequestImpl> (context, nullptr))
+{
+}
+
+AsynchronousRequest::AsynchronousRequest(
+    std::shared_ptr<UMPS::Messaging::Context> &context,
+    std::shared_ptr<UMPS::Logging::ILog> &logger) :
+    pImpl(std::make_unique<AsynchronousRequestImpl> (context, logger))
+{
+}
+
+/// Move c'tor
+AsynchronousRequest::AsynchronousRequest(
+    AsynchronousRequest &&request) noexcept
+{
+    *this = std::move(request);
+}
+
+/// Move assignment
+AsynchronousRequest&
+AsynchronousRequest::operator=(AsynchronousRequest &&request) noexcept
+{
+    if (&request == this){return *this;}
+    pImpl = std::move(request.pImpl);
+    return *this;
+}
+
+/// Destructor
+AsynchronousRequest::~AsynchronousRequest() = default;
+
+/// Initialize
+void AsynchronousRequest::initialize(const RequestOptions &options)
+{
+    if (!options.haveAddress())
+    {
+        throw std::invalid_argument("Address not set");
+    }
+    if (!options.haveMessageFormats())
+    {
+        throw std::invalid_argument("No message formats set");
+    }
+    pImpl->disconnect();
+    // Extract options for populating the socket info
+    UMPS::Messaging::SocketOptions socketOptions;
+    socketOptions.setAddress(options.getAddress());
+    socketOptions.setMessageFormats(options.getMessageFormats());
+    socketOptions.setZAPOptions(options.getZAPOptions());
+    socketOptions.setSendHighWaterMark(options.getSendHighWaterMark());
+    socketOptions.setReceiveHighWaterMark(options.getReceiveHighWaterMark());
+    socketOptions.setSendTimeOut(options.getSendTimeOut());
+    // The poll loop waits for responses so receive need not block
+    socketOptions.setReceiveTimeOut(std::chrono::milliseconds {0});
+    // Connect
+    constexpr bool lConnect{true};
+    pImpl->connectOrBind(socketOptions, lConnect);
+    pImpl->createPipe();
+    // Copy the options
+    pImpl->mRequestOptions = options;
+    pImpl->mTimeOut = options.getReceiveTimeOut();
+    pImpl->mWindow = options.getMaximumNumberOfOutstandingRequests();
+    {
+    std::scoped_lock lock(pImpl->mPendingMutex);
+    pImpl->mAccepting = true;
+    }
+    // Start the background thread
+    pImpl->start();
+}
+
+/// Initialized?
+bool AsynchronousRequest::isInitialized() const noexcept
+{
+    return pImpl->isConnected();
+}
+
+/// Make a request
+std::future<std::unique_ptr<UMPS::MessageFormats::IMessage>>
+    AsynchronousRequest::request(
+        const UMPS::MessageFormats::IMessage &request)
+{
+    if (!isInitialized()){throw std::runtime_error("Not initialized");}
+    ::PendingRequest pending;
+    auto result = pending.promise.get_future();
+    pImpl->submit(request, std::move(pending));
+    return result;
+}
+
+void AsynchronousRequest::request(
+    const UMPS::MessageFormats::IMessage &request,
+    const Callback &callback)
+{
+    if (!isInitialized()){throw std::runtime_error("Not initialized");}
+    if (!callback){throw std::invalid_argument("Callback not set");}
+    ::PendingRequest pending;
+    pending.callback = callback;
+    pending.haveCallback = true;
+    pImpl->submit(request, std::move(pending));
+}
+
+/// Outstanding requests
+int AsynchronousRequest::getNumberOfOutstandingRequests() const noexcept
+{
+    std::scoped_lock lock(pImpl->mPendingMutex);
+    return static_cast<int> (pImpl->mPending.size());
+}
+
+/// Disconnect
+void AsynchronousRequest::disconnect()
+{
+    pImpl->disconnect();
+}
+
+/// Connection details
+UCI::SocketDetails::Dealer AsynchronousRequest::getSocketDetails() const
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Requestor not initialized");
+    }
+    return pImpl->mDealerSocketDetails;
+}
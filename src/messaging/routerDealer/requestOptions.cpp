@@ -18,6 +18,7 @@ public:
     std::chrono::milliseconds mReceiveTimeOut{-1};
     int mSendHighWaterMark{0};
     int mReceiveHighWaterMark{0};
+    int mMaximumNumberOfOutstandingRequests{32};
 };
 
 /// C'tor
@@ -163,6 +164,21 @@ std::chrono::milliseconds RequestOptions::getSendTimeOut() const noexcept
     return pImpl->mSendTimeOut;
 }
 
+/// Window of outstanding requests
+void RequestOptions::setMaximumNumberOfOutstandingRequests(const int nRequests)
+{
+    if (nRequests < 1)
+    {
+        throw std::invalid_argument("Number of requests must be positive");
+    }
+    pImpl->mMaximumNumberOfOutstandingRequests = nRequests;
+}
+
+int RequestOptions::getMaximumNumberOfOutstandingRequests() const noexcept
+{
+    return pImpl->mMaximumNumberOfOutstandingRequests;
+}
+
 /*
 /// Add a message subscription
 void RequestOptions::addMessageFormat(
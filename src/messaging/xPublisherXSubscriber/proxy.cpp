@@ -1,9 +1,12 @@
 #include <string>
 #include <thread>
 #include <array>
+#include <vector>
+#include <string_view>
 #include <mutex>
 #include <chrono>
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
 #include "umps/messaging/xPublisherXSubscriber/proxy.hpp"
 #include "umps/messaging/xPublisherXSubscriber/proxyOptions.hpp"
 #include "umps/messaging/context.hpp"
@@ -16,6 +19,11 @@
 #include "umps/services/connectionInformation/socketDetails/xSubscriber.hpp"
 #include "umps/logging/standardOut.hpp"
 #include "private/messaging/ipcDirectory.hpp"
+#include "private/messaging/topicStatistics.hpp"
+#include "private/messaging/subscriptionFilter.hpp"
+#include "private/messaging/lastValueCache.hpp"
+#include "private/messaging/duplicateFilter.hpp"
+#include "private/messaging/sequenceStamp.hpp"
 
 using namespace UMPS::Messaging::XPublisherXSubscriber;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -24,6 +32,13 @@ namespace UAuth = UMPS::Authentication;
 namespace 
 {
 
+using namespace std::literals;
+
+/// A federated proxy subscribes to everything its upstream proxies publish
+/// with this topic.  This lets an upstream proxy tell its federated peers
+/// from its subscribers.
+constexpr auto federationTopic = "\0UMPS::Federation"sv;
+
 void checkOptions(const ProxyOptions &options)
 {
     if (!options.haveFrontendAddress())
@@ -34,6 +49,30 @@ void checkOptions(const ProxyOptions &options)
     {
         throw std::invalid_argument("Backend address not specified");
     } 
+    if (options.haveLastValueCache())
+    {
+        // The cache needs every topic but filtering only subscribes
+        // upstream to what the subscribers want
+        if (options.filterTopics())
+        {
+            throw std::invalid_argument(
+                "Last-value cache cannot be combined with topic filtering");
+        }
+        if (!options.haveSnapshotAddress())
+        {
+            throw std::invalid_argument(
+                "Last-value cache requires a snapshot address");
+        }
+    }
+    else if (options.haveSnapshotAddress())
+    {
+        throw std::invalid_argument(
+            "Snapshot address requires a last-value cache");
+    }
+    if (!options.getUpstreamProxies().empty() && !options.isFederated())
+    {
+        throw std::invalid_argument("Upstream proxies require federation");
+    }
 }
 
 }
@@ -100,12 +139,17 @@ public:
                                                      zmq::socket_type::xsub);
         mBackend = std::make_unique<zmq::socket_t> (*backendContextPtr,
                                                     zmq::socket_type::xpub);
+        mSnapshot = std::make_unique<zmq::socket_t> (*backendContextPtr,
+                                                     zmq::socket_type::router);
+        mUpstream = std::make_unique<zmq::socket_t> (*frontendContextPtr,
+                                                     zmq::socket_type::xsub);
     }
     /// Destructor
     ~ProxyImpl()
     {
         disconnectFrontend();
         disconnectBackend();
+        disconnectSnapshot();
     }
     void setStarted(const bool status)
     {
@@ -129,6 +173,13 @@ public:
             mLogger->debug("xPubxSub disconnected frontend");
             mHaveFrontend = false;
         }
+        for (const auto &upstreamAddress : mUpstreamAddresses)
+        {
+            mLogger->debug("xPubxSub disconnecting from upstream proxy: "
+                         + upstreamAddress);
+            mUpstream->disconnect(upstreamAddress);
+        }
+        mUpstreamAddresses.clear();
     }
     void disconnectBackend()
     {
@@ -143,6 +194,19 @@ public:
             mHaveBackend = false;
         }
     }
+    void disconnectSnapshot()
+    {
+        if (mHaveSnapshot)
+        {
+            ::removeIPCFile(mSnapshotAddress, &*mLogger);
+            mLogger->debug(
+                "xPubxSub disconnecting from current snapshot: "
+               + mSnapshotAddress);
+            mSnapshot->disconnect(mSnapshotAddress);
+            mLogger->debug("xPubxSub disconnected from snapshot");
+            mHaveSnapshot = false;
+        }
+    }
     void disconnectControl()
     {
         if (mHaveControl)
@@ -168,6 +232,23 @@ public:
             mBackend->set(zmq::sockopt::linger, 0);
             int hwm = mOptions.getBackendHighWaterMark();
             if (hwm > 0){mBackend->set(zmq::sockopt::sndhwm, hwm);}
+            if (useForwardingLoop())
+            {
+                // Pass every (un)subscription so subscribers can be counted
+                mBackend->set(zmq::sockopt::xpub_verboser, 1);
+            }
+            if (mOptions.isFederated())
+            {
+                // Federated peers' subscriptions are translated before
+                // they are applied
+                mBackend->set(zmq::sockopt::xpub_manual, 1);
+            }
+            if (mOptions.backendNoDrop())
+            {
+                // Refuse rather than silently drop messages at the high
+                // water mark so drops can be counted
+                mBackend->set(zmq::sockopt::xpub_nodrop, 1);
+            }
             mBackend->bind(mBackendAddress);
             mHaveBackend = true;
         }
@@ -189,6 +270,36 @@ public:
             }   
         } 
     }
+    /// Bind the socket that serves the last-value cache
+    void bindSnapshot()
+    {
+        if (!mOptions.haveSnapshotAddress()){return;}
+        mSnapshotAddress = mOptions.getSnapshotAddress();
+        // Resolve a directory issue for IPC
+        ::createIPCDirectoryFromConnectionString(mSnapshotAddress, &*mLogger);
+        try
+        {
+            mLogger->debug("xPubSubProxy proxy attempting to bind to snapshot: "
+                         + mSnapshotAddress);
+            mSnapshot->set(zmq::sockopt::linger, 0);
+            mSnapshot->bind(mSnapshotAddress);
+            mHaveSnapshot = true;
+        }
+        catch (const std::exception &e)
+        {
+            auto errorMsg = "xPubSubProxy proxy failed to bind to snapshot: "
+                          + mSnapshotAddress
+                          + ".\nZeroMQ failed with:\n" + std::string(e.what());
+            mLogger->error(errorMsg);
+            throw std::runtime_error(errorMsg);
+        }
+        // Resolve the snapshot address
+        if (mSnapshotAddress.find("tcp") != std::string::npos ||
+            mSnapshotAddress.find("ipc") != std::string::npos)
+        {
+            mSnapshotAddress = mSnapshot->get(zmq::sockopt::last_endpoint);
+        }
+    }
     void bindFrontend()
     {
         mFrontendAddress = mOptions.getFrontendAddress();
@@ -221,6 +332,33 @@ public:
                 mFrontendAddress = mFrontend->get(zmq::sockopt::last_endpoint);
             }
         }
+        // Receive what upstream proxies publish.  This is a separate
+        // socket so that subscriptions are never forwarded from one
+        // federated proxy to another.
+        if (!mOptions.getUpstreamProxies().empty())
+        {
+            mUpstream->set(zmq::sockopt::linger, 0);
+            int hwm = mOptions.getFrontendHighWaterMark();
+            if (hwm > 0){mUpstream->set(zmq::sockopt::rcvhwm, hwm);}
+        }
+        for (const auto &upstreamAddress : mOptions.getUpstreamProxies())
+        {
+            try
+            {
+                mLogger->debug("xPubSubProxy connecting to upstream proxy: "
+                             + upstreamAddress);
+                mUpstream->connect(upstreamAddress);
+                mUpstreamAddresses.push_back(upstreamAddress);
+            }
+            catch (const std::exception &e)
+            {
+                auto errorMsg = "xPubSubProxy failed to connect to upstream: "
+                              + upstreamAddress + ".\nZeroMQ failed with:\n"
+                              + std::string(e.what());
+                mLogger->error(errorMsg);
+                throw std::runtime_error(errorMsg);
+            }
+        }
     }
     void connectControl()
     {
@@ -246,6 +384,10 @@ public:
             //mControl->set(zmq::sockopt::subscribe, std::string(""));
             //mControl->set(zmq::sockopt::linger, 1);
             mCommand->set(zmq::sockopt::linger, 0);
+            // Commands like PAUSE don't get a reply so don't wait for one
+            // before sending the next command
+            mCommand->set(zmq::sockopt::req_relaxed, 1);
+            mCommand->set(zmq::sockopt::req_correlate, 1);
             mCommand->connect(mControlAddress); // Connects instead of binds?
             mHaveControl = true;
         }
@@ -258,6 +400,366 @@ public:
             throw std::runtime_error(errorMsg);
         }
     }
+    /// @brief Sends a command to the control socket.
+    void sendCommand(const std::string &command)
+    {
+        std::scoped_lock lock(mCommandMutex);
+        zmq::const_buffer commandBuffer{command.data(), command.size()};
+        mCommand->send(commandBuffer, zmq::send_flags::none);
+    }
+    /// @brief Asks the forwarding loop for its statistics.
+    [[nodiscard]] std::string requestStatistics()
+    {
+        std::scoped_lock lock(mCommandMutex);
+        mCommand->send(zmq::str_buffer("STATISTICS"), zmq::send_flags::none);
+        zmq::pollitem_t item{mCommand->handle(), 0, ZMQ_POLLIN, 0};
+        if (zmq::poll(&item, 1, mStatisticsTimeOut) > 0)
+        {
+            zmq::message_t reply;
+            if (mCommand->recv(reply, zmq::recv_flags::dontwait))
+            {
+                return reply.to_string();
+            }
+        }
+        throw std::runtime_error("Proxy did not return statistics");
+    }
+    /// @result True indicates the proxy runs its own forwarding loop
+    ///         instead of zmq::proxy_steerable.
+    [[nodiscard]] bool useForwardingLoop() const noexcept
+    {
+        return mOptions.collectTopicStatistics() ||
+               mOptions.backendNoDrop() ||
+               mOptions.filterTopics() ||
+               mOptions.haveLastValueCache() ||
+               mOptions.isFederated();
+    }
+    /// @brief Moves up to maxMessages messages from the frontend, or the
+    ///        upstream proxies, to the backend.
+    void forwardMessages(zmq::socket_t &source,
+                         const int maxMessages,
+                         ::TopicStatistics *statistics,
+                         ::SubscriptionFilter *filter,
+                         ::LastValueCache *cache,
+                         ::DuplicateFilter *duplicates)
+    {
+        for (int i = 0; i < maxMessages; ++i)
+        {
+            if (!mMessage.recv(source, ZMQ_DONTWAIT)){break;}
+            if (mMessage.empty()){continue;}
+            if (duplicates != nullptr && !stampMessage(*duplicates))
+            {
+                mMessage.clear();
+                continue;
+            }
+            // Cache before filtering so a later subscriber can get this
+            if (cache != nullptr)
+            {
+                mFrames.clear();
+                for (const auto &frame : mMessage)
+                {
+                    mFrames.push_back(frame.to_string_view());
+                }
+                cache->update(mFrames);
+            }
+            // Discard what nobody wants before it is queued for anyone
+            if (filter != nullptr &&
+                !filter->wants(mMessage[0].to_string_view()))
+            {
+                mMessage.clear();
+                continue;
+            }
+            if (statistics == nullptr)
+            {
+                if (!mMessage.send(*mBackend, ZMQ_DONTWAIT)){mMessage.clear();}
+                continue;
+            }
+            // Sending consumes the message so copy what is counted
+            mTopic.assign(mMessage[0].to_string_view());
+            size_t nBytes{0};
+            for (const auto &frame : mMessage){nBytes = nBytes + frame.size();}
+            if (mMessage.send(*mBackend, ZMQ_DONTWAIT))
+            {
+                statistics->addMessage(mTopic, nBytes);
+            }
+            else
+            {
+                // A subscriber is at its high water mark
+                statistics->addDrop(mTopic);
+                mMessage.clear();
+            }
+        }
+    }
+    /// @brief Stamps a message that a publisher sent directly to this proxy
+    ///        with this proxy's origin and the next sequence number on its
+    ///        topic.  A message that was already stamped is checked against
+    ///        the messages this proxy has forwarded.
+    /// @result False indicates the message is a repeat and should be dropped.
+    [[nodiscard]] bool stampMessage(::DuplicateFilter &duplicates)
+    {
+        auto topic = mMessage[0].to_string_view();
+        ::SequenceStamp stamp;
+        if (mMessage.size() > 2 &&
+            ::unpackSequenceStamp(mMessage[mMessage.size() - 1].to_string_view(),
+                                  &stamp))
+        {
+            return duplicates.accept(topic, stamp);
+        }
+        stamp = mStamper->next(topic);
+        // Remember it in case it comes back around a loop
+        static_cast<void> (duplicates.accept(topic, stamp));
+        auto frame = ::packSequenceStamp(stamp);
+        mMessage.addmem(frame.data(), frame.size());
+        return true;
+    }
+    /// @brief Moves up to maxMessages subscription messages from the backend
+    ///        to the frontend.
+    void forwardSubscriptions(const int maxMessages,
+                              ::TopicStatistics *statistics,
+                              ::SubscriptionFilter *filter)
+    {
+        zmq::message_t subscription;
+        for (int i = 0; i < maxMessages; ++i)
+        {
+            if (!mBackend->recv(subscription, zmq::recv_flags::dontwait))
+            {
+                break;
+            }
+            auto more = subscription.more();
+            if (!more && mOptions.isFederated())
+            {
+                applySubscription(subscription);
+            }
+            if (!more)
+            {
+                auto message = subscription.to_string_view();
+                if (statistics != nullptr)
+                {
+                    statistics->addSubscription(message);
+                }
+                // Publishers only need to hear about a topic's first
+                // subscriber and last unsubscriber
+                if (filter != nullptr && !filter->update(message)){continue;}
+            }
+            mFrontend->send(subscription,
+                            more ? zmq::send_flags::sndmore :
+                                   zmq::send_flags::none);
+        }
+    }
+    /// @brief The backend handles subscriptions manually when federated.
+    ///        A federated peer subscribes to the federation topic which is
+    ///        rewritten as the empty topic, i.e., everything.  It is then
+    ///        forwarded to the publishers like any other subscription.
+    ///        Since subscriptions are never forwarded to upstream proxies
+    ///        they can't come back around a loop and keep themselves alive.
+    /// @param[in,out] subscription  The subscription message.  On exit, a
+    ///                              peer's subscription is rewritten.
+    void applySubscription(zmq::message_t &subscription)
+    {
+        auto message = subscription.to_string_view();
+        if (message.empty()){return;}
+        if (message[0] != 0 && message[0] != 1){return;}
+        if (message.substr(1) == federationTopic)
+        {
+            const char subscribe = message[0];
+            subscription.rebuild(&subscribe, 1);
+            message = subscription.to_string_view();
+        }
+        // This applies to the subscriber that sent the message
+        auto topic = message.substr(1);
+        if (message[0] == 1)
+        {
+            mBackend->set(zmq::sockopt::subscribe, topic);
+        }
+        else
+        {
+            mBackend->set(zmq::sockopt::unsubscribe, topic);
+        }
+    }
+    /// @brief Answers up to maxRequests snapshot requests.  A request is
+    ///        the routing envelope followed by a frame for each subscription.
+    ///        The reply is the envelope followed by the topic and payload of
+    ///        each cached message matching a subscription or, if nothing
+    ///        matches, a single empty frame.  Only the requester receives it.
+    void serveSnapshots(const int maxRequests, const ::LastValueCache &cache)
+    {
+        for (int i = 0; i < maxRequests; ++i)
+        {
+            zmq::multipart_t request;
+            if (!request.recv(*mSnapshot, ZMQ_DONTWAIT)){break;}
+            zmq::multipart_t reply;
+            // The envelope ends with an empty delimiter
+            while (!request.empty())
+            {
+                auto frame = request.pop();
+                auto isDelimiter = frame.size() == 0;
+                reply.add(std::move(frame));
+                if (isDelimiter){break;}
+            }
+            if (reply.empty() || reply[reply.size() - 1].size() != 0)
+            {
+                mLogger->warn(
+                    "xPubxSub proxy ignoring malformed snapshot request");
+                continue;
+            }
+            const auto nEnvelope = reply.size();
+            cache.forEach("",
+                          [&reply, &request](
+                              const std::vector<std::string> &frames)
+            {
+                if (frames.size() < 2){return;}
+                for (const auto &subscription : request)
+                {
+                    if (frames[0].starts_with(subscription.to_string_view()))
+                    {
+                        // Sequence stamps are for the live stream only
+                        reply.addstr(frames[0]);
+                        reply.addstr(frames[1]);
+                        return;
+                    }
+                }
+            });
+            if (reply.size() == nEnvelope){reply.add(zmq::message_t {});}
+            if (!reply.send(*mSnapshot, ZMQ_DONTWAIT)){reply.clear();}
+        }
+    }
+    /// @brief Forwards messages like zmq::proxy_steerable but optionally
+    ///        counts the traffic on each topic, filters the topics, serves
+    ///        snapshots of the last values to new subscribers, and federates
+    ///        with other proxies.  The
+    ///        control socket accepts the same PAUSE, RESUME, and TERMINATE
+    ///        commands and replies to STATISTICS with the counters as JSON.
+    void runForwardingLoop()
+    {
+        // Bound the work per socket so the others aren't starved
+        constexpr int MAX_MESSAGES_PER_POLL{1024};
+        ::TopicStatistics statistics;
+        ::SubscriptionFilter filter;
+        auto statisticsPointer
+            = mOptions.collectTopicStatistics() ? &statistics : nullptr;
+        // Publishers only need to hear about the first subscription from a
+        // federated proxy's subscribers and peers
+        auto filterPointer
+            = mOptions.filterTopics() || mOptions.isFederated() ?
+              &filter : nullptr;
+        ::DuplicateFilter duplicates;
+        auto duplicatesPointer
+            = mOptions.isFederated() ? &duplicates : nullptr;
+        if (mOptions.isFederated())
+        {
+            // A new origin each run means a restarted proxy's sequence
+            // numbers can't be mistaken for repeats
+            mStamper = std::make_unique<::SequenceStamper> ();
+            mLogger->debug("xPubxSub proxy federating with origin "
+                         + std::to_string(mStamper->getOrigin()));
+        }
+        std::unique_ptr<::LastValueCache> cache{nullptr};
+        if (mOptions.haveLastValueCache())
+        {
+            cache = std::make_unique<::LastValueCache>
+                    (static_cast<size_t> (mOptions.getLastValueCacheCapacity()),
+                     static_cast<size_t>
+                        (mOptions.getLastValueCacheMaximumBytes()),
+                     mOptions.getLastValueCacheKeyExtractor());
+            // The cache can only serve what the publishers send to us
+            // so subscribe to everything
+            constexpr std::array<char, 1> subscribeAll{1};
+            mFrontend->send(zmq::const_buffer{subscribeAll.data(),
+                                              subscribeAll.size()},
+                            zmq::send_flags::none);
+        }
+        // Subscribe to everything upstream proxies publish.  Nothing else
+        // is sent upstream.
+        if (!mUpstreamAddresses.empty())
+        {
+            std::string subscribeAll{"\x01"};
+            subscribeAll.append(federationTopic);
+            mUpstream->send(zmq::const_buffer{subscribeAll.data(),
+                                              subscribeAll.size()},
+                            zmq::send_flags::none);
+        }
+        std::vector<zmq::pollitem_t> items{
+        {
+            {mControl->handle(),  0, ZMQ_POLLIN, 0},
+            {mFrontend->handle(), 0, ZMQ_POLLIN, 0},
+            {mBackend->handle(),  0, ZMQ_POLLIN, 0}
+        }};
+        // The other sockets are only polled when they are used
+        size_t upstreamIndex{0};
+        if (!mUpstreamAddresses.empty())
+        {
+            upstreamIndex = items.size();
+            items.push_back({mUpstream->handle(), 0, ZMQ_POLLIN, 0});
+        }
+        size_t snapshotIndex{0};
+        if (cache)
+        {
+            snapshotIndex = items.size();
+            items.push_back({mSnapshot->handle(), 0, ZMQ_POLLIN, 0});
+        }
+        bool paused{false};
+        while (true)
+        {
+            // While paused only listen for commands
+            size_t nItems = paused ? 1 : items.size();
+            zmq::poll(items.data(), nItems, -1);
+            if (items[0].revents & ZMQ_POLLIN)
+            {
+                zmq::message_t command;
+                if (!mControl->recv(command)){continue;}
+                auto commandString = command.to_string_view();
+                std::string reply{commandString};
+                bool terminate{false};
+                if (commandString == "PAUSE")
+                {
+                    paused = true;
+                }
+                else if (commandString == "RESUME")
+                {
+                    paused = false;
+                }
+                else if (commandString == "TERMINATE")
+                {
+                    terminate = true;
+                }
+                else if (commandString == "STATISTICS")
+                {
+                    reply = statistics.toJSONObject().dump(-1);
+                }
+                else
+                {
+                    mLogger->warn("xPubxSub proxy ignoring command: "
+                                + reply);
+                    reply = "Unknown command";
+                }
+                // The control is a reply socket so always answer
+                zmq::const_buffer replyBuffer{reply.data(), reply.size()};
+                mControl->send(replyBuffer, zmq::send_flags::none);
+                if (terminate){break;}
+                continue;
+            }
+            if (items[1].revents & ZMQ_POLLIN)
+            {
+                forwardMessages(*mFrontend, MAX_MESSAGES_PER_POLL,
+                                statisticsPointer, filterPointer,
+                                cache.get(), duplicatesPointer);
+            }
+            if (items[2].revents & ZMQ_POLLIN)
+            {
+                forwardSubscriptions(MAX_MESSAGES_PER_POLL,
+                                     statisticsPointer, filterPointer);
+            }
+            if (upstreamIndex > 0 && items[upstreamIndex].revents & ZMQ_POLLIN)
+            {
+                forwardMessages(*mUpstream, MAX_MESSAGES_PER_POLL,
+                                statisticsPointer, filterPointer,
+                                cache.get(), duplicatesPointer);
+            }
+            if (snapshotIndex > 0 && items[snapshotIndex].revents & ZMQ_POLLIN)
+            {
+                serveSnapshots(MAX_MESSAGES_PER_POLL, *cache);
+            }
+        }
+    }
     /// Update socket details
     void updateSocketDetails()
     {
@@ -281,6 +783,16 @@ public:
     std::unique_ptr<zmq::socket_t> mControl{nullptr};
     // The command socket issues terminate/pause/start messages to the control.
     std::unique_ptr<zmq::socket_t> mCommand{nullptr};
+    // Serializes commands since statistics may be requested from any thread
+    std::mutex mCommandMutex;
+    // The forwarding loop reuses these for each message
+    zmq::multipart_t mMessage;
+    std::vector<std::string_view> mFrames;
+    std::string mTopic;
+    // Federation
+    std::unique_ptr<::SequenceStamper> mStamper{nullptr};
+    std::vector<std::string> mUpstreamAddresses;
+    std::chrono::milliseconds mStatisticsTimeOut{1000};
     // This context handles communication with producers.
     std::shared_ptr<UMPS::Messaging::Context> mFrontendContext{nullptr};
     // This context handles communication with the subscribers.
@@ -289,17 +801,23 @@ public:
     std::unique_ptr<zmq::socket_t> mFrontend{nullptr};
     // The backend is an xPub that faces the external clients
     std::unique_ptr<zmq::socket_t> mBackend{nullptr};
+    // The snapshot is a router that serves the last-value cache to clients
+    std::unique_ptr<zmq::socket_t> mSnapshot{nullptr};
+    // The upstream is an xSub that connects to federated upstream proxies
+    std::unique_ptr<zmq::socket_t> mUpstream{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
     // Options
     ProxyOptions mOptions;
     UCI::SocketDetails::Proxy mSocketDetails;
     std::string mFrontendAddress;
     std::string mBackendAddress;
+    std::string mSnapshotAddress;
     std::string mControlAddress;
     UAuth::SecurityLevel mSecurityLevel{UAuth::SecurityLevel::Grasslands};
     //int mHighWaterMark = 4*1024;
     bool mHaveFrontend{false};
     bool mHaveBackend{false};
+    bool mHaveSnapshot{false};
     bool mHaveControl{false};
     bool mStarted{false};
     bool mPaused{false};
@@ -356,13 +874,17 @@ void Proxy::initialize(const ProxyOptions &options)
     pImpl->mSocketDetails.clear();
     pImpl->disconnectFrontend();
     pImpl->disconnectBackend();
+    pImpl->disconnectSnapshot();
     pImpl->disconnectControl();
     // Create zap options
     auto zapOptions = pImpl->mOptions.getZAPOptions();
     zapOptions.setSocketOptions(&*pImpl->mFrontend);
     zapOptions.setSocketOptions(&*pImpl->mBackend);
+    zapOptions.setSocketOptions(&*pImpl->mSnapshot);
+    zapOptions.setSocketOptions(&*pImpl->mUpstream);
     // (Re)Establish connections
     pImpl->bindBackend();
+    pImpl->bindSnapshot();
     pImpl->bindFrontend();
     pImpl->connectControl();
     pImpl->mSecurityLevel = zapOptions.getSecurityLevel();
@@ -386,7 +908,7 @@ void Proxy::start()
     if (pImpl->mPaused)
     {
         pImpl->mLogger->debug("Resuming proxy...");
-        pImpl->mCommand->send(zmq::str_buffer("RESUME"), zmq::send_flags::none);
+        pImpl->sendCommand("RESUME");
         pImpl->mPaused = false;
     }
     else
@@ -395,13 +917,22 @@ void Proxy::start()
         {
             try
             {
-                pImpl->mLogger->debug("Making steerable proxy...");
                 pImpl->setStarted(true);
-                zmq::proxy_steerable(*pImpl->mFrontend,
-                                     *pImpl->mBackend,
-                                     zmq::socket_ref(),
-                                     *pImpl->mControl);
-                pImpl->mLogger->debug("Exited steerable proxy");
+                if (pImpl->useForwardingLoop())
+                {
+                    pImpl->mLogger->debug("Making forwarding proxy...");
+                    pImpl->runForwardingLoop();
+                    pImpl->mLogger->debug("Exited forwarding proxy");
+                }
+                else
+                {
+                    pImpl->mLogger->debug("Making steerable proxy...");
+                    zmq::proxy_steerable(*pImpl->mFrontend,
+                                         *pImpl->mBackend,
+                                         zmq::socket_ref(),
+                                         *pImpl->mControl);
+                    pImpl->mLogger->debug("Exited steerable proxy");
+                }
                 pImpl->disconnectControl();
                 pImpl->mLogger->debug("Control disconnected");
                 pImpl->setStarted(false);
@@ -430,7 +961,7 @@ void Proxy::pause()
     if (!pImpl->mPaused)
     {
         pImpl->mLogger->debug("Pausing proxy...");
-        pImpl->mCommand->send(zmq::str_buffer("PAUSE"), zmq::send_flags::none);
+        pImpl->sendCommand("PAUSE");
         pImpl->mPaused = true;
     }
 }
@@ -443,8 +974,7 @@ void Proxy::stop()
         pImpl->mLogger->debug("Terminating proxy...");
         try
         {
-            pImpl->mCommand->send(zmq::str_buffer("TERMINATE"),
-                                  zmq::send_flags::none);
+            pImpl->sendCommand("TERMINATE");
         }
         catch (const std::exception &e)
         {
@@ -471,11 +1001,36 @@ void Proxy::stop()
                 "Failed to disconnect backend.  Failed with: "
                + std::string {e.what()});
         }
+        try
+        {
+            pImpl->disconnectSnapshot();
+        }
+        catch (const std::exception &e)
+        {
+            pImpl->mLogger->error(
+                "Failed to disconnect snapshot.  Failed with: "
+               + std::string {e.what()});
+        }
     }
     pImpl->mInitialized = false;
     pImpl->mStarted = false;
 }
 
+/// Statistics
+std::string Proxy::getStatistics() const
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Proxy not initialized");
+    }
+    if (!pImpl->mOptions.collectTopicStatistics())
+    {
+        throw std::runtime_error("Topic statistics not enabled");
+    }
+    if (!isRunning()){throw std::runtime_error("Proxy not running");}
+    return pImpl->requestStatistics();
+}
+
 /// Socket details
 UCI::SocketDetails::Proxy Proxy::getSocketDetails() const
 {
@@ -1,4 +1,7 @@
 #include <string>
+#include <string_view>
+#include <functional>
+#include <vector>
 #include "umps/messaging/xPublisherXSubscriber/proxyOptions.hpp"
 #include "umps/authentication/zapOptions.hpp"
 #include "private/isEmpty.hpp"
@@ -10,10 +13,20 @@ class ProxyOptions::ProxyOptionsImpl
 {
 public:
     UAuth::ZAPOptions mZAPOptions;
+    std::vector<std::string> mUpstreamProxies;
     std::string mBackendAddress;
     std::string mFrontendAddress;
+    std::string mSnapshotAddress;
     int mBackendHighWaterMark = 0;
     int mFrontendHighWaterMark = 0;
+    std::function<std::string (std::string_view, std::string_view)>
+        mLastValueCacheKeyExtractor{nullptr};
+    int64_t mLastValueCacheMaximumBytes{16*1024*1024};
+    int mLastValueCacheCapacity{0};
+    bool mCollectTopicStatistics{false};
+    bool mBackendNoDrop{false};
+    bool mFilterTopics{false};
+    bool mFederated{false};
 };
 
 /// C'tor
@@ -141,3 +154,146 @@ UAuth::ZAPOptions ProxyOptions::getZAPOptions() const noexcept
 {
     return pImpl->mZAPOptions;
 }
+
+/// Backend no drop
+void ProxyOptions::enableBackendNoDrop() noexcept
+{
+    pImpl->mBackendNoDrop = true;
+}
+
+void ProxyOptions::disableBackendNoDrop() noexcept
+{
+    pImpl->mBackendNoDrop = false;
+}
+
+bool ProxyOptions::backendNoDrop() const noexcept
+{
+    return pImpl->mBackendNoDrop;
+}
+
+/// Topic statistics
+void ProxyOptions::enableTopicStatistics() noexcept
+{
+    pImpl->mCollectTopicStatistics = true;
+}
+
+void ProxyOptions::disableTopicStatistics() noexcept
+{
+    pImpl->mCollectTopicStatistics = false;
+}
+
+bool ProxyOptions::collectTopicStatistics() const noexcept
+{
+    return pImpl->mCollectTopicStatistics;
+}
+
+/// Topic filtering
+void ProxyOptions::enableTopicFiltering() noexcept
+{
+    pImpl->mFilterTopics = true;
+}
+
+void ProxyOptions::disableTopicFiltering() noexcept
+{
+    pImpl->mFilterTopics = false;
+}
+
+bool ProxyOptions::filterTopics() const noexcept
+{
+    return pImpl->mFilterTopics;
+}
+
+/// Last-value cache
+void ProxyOptions::setLastValueCacheCapacity(const int capacity)
+{
+    if (capacity < 0)
+    {
+        throw std::invalid_argument("Capacity cannot be negative");
+    }
+    pImpl->mLastValueCacheCapacity = capacity;
+}
+
+int ProxyOptions::getLastValueCacheCapacity() const noexcept
+{
+    return pImpl->mLastValueCacheCapacity;
+}
+
+bool ProxyOptions::haveLastValueCache() const noexcept
+{
+    return pImpl->mLastValueCacheCapacity > 0;
+}
+
+void ProxyOptions::setLastValueCacheMaximumBytes(const int64_t maximumBytes)
+{
+    if (maximumBytes <= 0)
+    {
+        throw std::invalid_argument("Maximum bytes must be positive");
+    }
+    pImpl->mLastValueCacheMaximumBytes = maximumBytes;
+}
+
+int64_t ProxyOptions::getLastValueCacheMaximumBytes() const noexcept
+{
+    return pImpl->mLastValueCacheMaximumBytes;
+}
+
+void ProxyOptions::setLastValueCacheKeyExtractor(
+    const std::function<std::string (std::string_view topic,
+                                     std::string_view message)> &keyExtractor)
+{
+    pImpl->mLastValueCacheKeyExtractor = keyExtractor;
+}
+
+std::function<std::string (std::string_view, std::string_view)>
+    ProxyOptions::getLastValueCacheKeyExtractor() const
+{
+    return pImpl->mLastValueCacheKeyExtractor;
+}
+
+/// Snapshot address
+void ProxyOptions::setSnapshotAddress(const std::string &address)
+{
+    if (isEmpty(address)){throw std::invalid_argument("Address is empty");}
+    pImpl->mSnapshotAddress = address;
+}
+
+std::string ProxyOptions::getSnapshotAddress() const
+{
+    if (!haveSnapshotAddress())
+    {
+        throw std::invalid_argument("Snapshot address not set");
+    }
+    return pImpl->mSnapshotAddress;
+}
+
+bool ProxyOptions::haveSnapshotAddress() const noexcept
+{
+    return !pImpl->mSnapshotAddress.empty();
+}
+
+/// Federation
+void ProxyOptions::enableFederation() noexcept
+{
+    pImpl->mFederated = true;
+}
+
+void ProxyOptions::disableFederation() noexcept
+{
+    pImpl->mFederated = false;
+}
+
+bool ProxyOptions::isFederated() const noexcept
+{
+    return pImpl->mFederated;
+}
+
+void ProxyOptions::addUpstreamProxy(const std::string &address)
+{
+    if (isEmpty(address)){throw std::invalid_argument("Address is empty");}
+    pImpl->mUpstreamProxies.push_back(address);
+}
+
+std::vector<std::string> ProxyOptions::getUpstreamProxies() const
+{
+    return pImpl->mUpstreamProxies;
+}
@@ -8,6 +8,7 @@
 #include "umps/messageFormats/message.hpp"
 #include "umps/services/connectionInformation/socketDetails/xPublisher.hpp"
 #include "umps/logging/standardOut.hpp"
+#include "private/messaging/messageBatch.hpp"
 
 using namespace UMPS::Messaging::XPublisherXSubscriber;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -64,6 +65,9 @@ public:
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
     PublisherOptions mOptions;
     UCI::SocketDetails::XPublisher mSocketDetails;
+    ::MessageBatch mBatch;
+    std::unique_ptr<::SequenceStamper> mStamper{nullptr};
+    std::string mSendBuffer;
     std::string mAddress;
     UAuth::SecurityLevel mSecurityLevel = UAuth::SecurityLevel::Grasslands;
     bool mConnected = false;
@@ -119,6 +123,12 @@ void Publisher::initialize(const PublisherOptions &options)
         throw std::invalid_argument("Address not set on options");
     }
     pImpl->mOptions = options; 
+    // Numbering restarts under a new identity so it is not seen as a gap
+    pImpl->mStamper = nullptr;
+    if (pImpl->mOptions.sendSequenceNumbers())
+    {
+        pImpl->mStamper = std::make_unique<::SequenceStamper> ();
+    }
     pImpl->mInitialized = false;
     // Disconnect from old connections
     pImpl->disconnect();
@@ -170,16 +180,16 @@ void Publisher::send(const MessageFormats::IMessage &message)
     {
         pImpl->mLogger->debug("Message type is empty");
     }
-    auto messageContents = message.toMessage();
+    pImpl->mSendBuffer.clear();
+    message.serializeInto(&pImpl->mSendBuffer);
+    const auto &messageContents = pImpl->mSendBuffer;
     if (messageContents.empty())
     {
         pImpl->mLogger->debug("Message contents are empty");
     }
     //pImpl->mLogger->debug("Sending message of type: " + messageType);
-    zmq::const_buffer header{messageType.data(), messageType.size()};
-    pImpl->mPublisher->send(header, zmq::send_flags::sndmore);
-    zmq::const_buffer buffer{messageContents.data(), messageContents.size()};
-    pImpl->mPublisher->send(buffer);
+    ::sendMessage(*pImpl->mPublisher, messageType, messageContents,
+                  pImpl->mStamper.get());
 }
 
 /// Disconnect
@@ -189,6 +199,38 @@ void Publisher::disconnect()
     pImpl->mInitialized = false;
 } 
 
+/// Send a batch of messages
+void Publisher::sendBatch(
+    std::span<const MessageFormats::IMessage * const> messages)
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Publisher not initialized");
+    }
+    if (messages.empty()){return;}
+    // Serialize everything first so that a bad message sends nothing
+    pImpl->mBatch.clear();
+    for (const auto &message : messages)
+    {
+        if (message == nullptr)
+        {
+            pImpl->mBatch.clear();
+            throw std::invalid_argument("Message is NULL");
+        }
+        try
+        {
+            pImpl->mBatch.add(*message);
+        }
+        catch (...)
+        {
+            pImpl->mBatch.clear();
+            throw;
+        }
+    }
+    pImpl->mBatch.send(*pImpl->mPublisher, pImpl->mStamper.get());
+    pImpl->mBatch.clear();
+}
+
 /// Socket details
 UCI::SocketDetails::XPublisher Publisher::getSocketDetails() const
 {
@@ -13,6 +13,7 @@ public:
     std::string mAddress;
     std::chrono::milliseconds mTimeOut{-1}; // Wait forever
     int mHighWaterMark = 0;
+    bool mSequenceNumbers{false};
 };
 
 /// C'tor
@@ -125,3 +126,19 @@ UAuth::ZAPOptions PublisherOptions::getZAPOptions() const noexcept
 {
     return pImpl->mZAPOptions;
 }
+
+/// Sequence numbers
+void PublisherOptions::enableSequenceNumbers() noexcept
+{
+    pImpl->mSequenceNumbers = true;
+}
+
+void PublisherOptions::disableSequenceNumbers() noexcept
+{
+    pImpl->mSequenceNumbers = false;
+}
+
+bool PublisherOptions::sendSequenceNumbers() const noexcept
+{
+    return pImpl->mSequenceNumbers;
+}
@@ -1,6 +1,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <chrono>
 #include <zmq.hpp>
 #include <zmq_addon.hpp>
 #include "umps/messaging/xPublisherXSubscriber/subscriber.hpp"
@@ -14,6 +15,7 @@
 #include "umps/services/connectionInformation/socketDetails/xSubscriber.hpp"
 #include "umps/services/connectionInformation/socketDetails/subscriber.hpp"
 #include "umps/logging/standardOut.hpp"
+#include "private/messageFormats/messageTypeRegistry.hpp"
 
 using namespace UMPS::Messaging::XPublisherXSubscriber;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -27,10 +29,51 @@ public:
                    std::shared_ptr<UMPS::Logging::ILog> logger) :
         mSubscriber(context, logger)
     {
+        if (context == nullptr)
+        {
+            mContext = std::make_shared<UMPS::Messaging::Context> (1);
+        }
+        else
+        {
+            mContext = context;
+        }
+        if (logger == nullptr)
+        {
+            mLogger = std::make_shared<UMPS::Logging::StandardOut> ();
+        }
+        else
+        {
+            mLogger = logger;
+        }
+        auto contextPtr = reinterpret_cast<zmq::context_t *>
+                          (mContext->getContext());
+        mSnapshot = std::make_unique<zmq::socket_t> (*contextPtr,
+                                                     zmq::socket_type::req);
+        // A request that timed out can be retried and its late reply
+        // is discarded
+        mSnapshot->set(zmq::sockopt::req_relaxed, 1);
+        mSnapshot->set(zmq::sockopt::req_correlate, 1);
+        mSnapshot->set(zmq::sockopt::linger, 0);
+    }
+    /// Disconnect from the snapshot
+    void disconnectSnapshot()
+    {
+        if (mHaveSnapshot)
+        {
+            mSnapshot->disconnect(mSnapshotAddress);
+            mHaveSnapshot = false;
+        }
     }
 //private:
     UMPS::Messaging::PublisherSubscriber::Subscriber mSubscriber;
     UCI::SocketDetails::XSubscriber mSocketDetails;
+    std::shared_ptr<UMPS::Messaging::Context> mContext{nullptr};
+    std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
+    std::unique_ptr<zmq::socket_t> mSnapshot{nullptr};
+    ::MessageTypeRegistry mMessageTypes;
+    std::string mSnapshotAddress;
+    std::chrono::milliseconds mTimeOut{-1};
+    bool mHaveSnapshot{false};
 };
 
 /// Constructors
@@ -89,6 +132,7 @@ void Subscriber::initialize(const SubscriberOptions &options)
     sOptions.setReceiveHighWaterMark(options.getReceiveHighWaterMark()); 
     sOptions.setAddress(options.getAddress());
     sOptions.setMessageTypes(options.getMessageTypes());
+    sOptions.setGapCallback(options.getGapCallback());
     pImpl->mSubscriber.initialize(sOptions);
     // Reconstitute the socket details
     auto socketDetails = pImpl->mSubscriber.getSocketDetails();
@@ -97,6 +141,31 @@ void Subscriber::initialize(const SubscriberOptions &options)
     pImpl->mSocketDetails.setConnectOrBind(socketDetails.getConnectOrBind());
     pImpl->mSocketDetails.setMinimumUserPrivileges(
         socketDetails.getMinimumUserPrivileges());
+    // Connect to the proxy's last-value cache
+    pImpl->disconnectSnapshot();
+    pImpl->mMessageTypes = ::MessageTypeRegistry(options.getMessageTypes());
+    pImpl->mTimeOut = options.getReceiveTimeOut();
+    if (options.haveSnapshotAddress())
+    {
+        auto address = options.getSnapshotAddress();
+        auto zapOptions = options.getZAPOptions();
+        zapOptions.setSocketOptions(&*pImpl->mSnapshot);
+        try
+        {
+            pImpl->mLogger->debug("Subscriber connecting to snapshot "
+                                + address);
+            pImpl->mSnapshot->connect(address);
+        }
+        catch (const std::exception &e)
+        {
+            auto errmsg = "Subscriber failed to connect to snapshot " + address
+                        + " with error: " + std::string(e.what());
+            pImpl->mLogger->error(errmsg);
+            throw std::runtime_error(errmsg);
+        }
+        pImpl->mSnapshotAddress = address;
+        pImpl->mHaveSnapshot = true;
+    }
 }
 
 /// Initialized?
@@ -105,10 +174,27 @@ bool Subscriber::isInitialized() const noexcept
     return pImpl->mSubscriber.isInitialized();
 }
 
+/// Gap detection
+uint64_t Subscriber::getNumberOfSequencedMessages() const noexcept
+{
+    return pImpl->mSubscriber.getNumberOfSequencedMessages();
+}
+
+uint64_t Subscriber::getNumberOfMissedMessages() const noexcept
+{
+    return pImpl->mSubscriber.getNumberOfMissedMessages();
+}
+
+uint64_t Subscriber::getNumberOfGaps() const noexcept
+{
+    return pImpl->mSubscriber.getNumberOfGaps();
+}
+
 /// Disconnect from endpoint
 void Subscriber::disconnect()
 {
     pImpl->mSubscriber.disconnect();
+    pImpl->disconnectSnapshot();
 }
 
 /// Receive messages
@@ -116,6 +202,75 @@ std::unique_ptr<UMPS::MessageFormats::IMessage> Subscriber::receive() const
 {
     return pImpl->mSubscriber.receive();
 }
+
+/// Recycle a message
+void Subscriber::recycle(
+    std::unique_ptr<UMPS::MessageFormats::IMessage> &&message) const
+{
+    pImpl->mSubscriber.recycle(std::move(message));
+}
+
+/// Request the last-value cache
+std::vector<std::unique_ptr<UMPS::MessageFormats::IMessage>>
+    Subscriber::requestSnapshot() const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (!pImpl->mHaveSnapshot)
+    {
+        throw std::runtime_error("Snapshot address not set on options");
+    }
+    // Ask for everything this subscriber subscribes to
+    zmq::multipart_t request;
+    for (int id = 0; id < pImpl->mMessageTypes.size(); ++id)
+    {
+        request.addstr(pImpl->mMessageTypes.getMessageType(id));
+    }
+    if (!request.send(*pImpl->mSnapshot))
+    {
+        throw std::runtime_error("Failed to send snapshot request");
+    }
+    zmq::pollitem_t item{pImpl->mSnapshot->handle(), 0, ZMQ_POLLIN, 0};
+    auto timeOut = pImpl->mTimeOut.count() < 0 ?
+                   std::chrono::milliseconds {-1} : pImpl->mTimeOut;
+    zmq::multipart_t reply;
+    if (zmq::poll(&item, 1, timeOut) < 1 ||
+        !reply.recv(*pImpl->mSnapshot, ZMQ_DONTWAIT))
+    {
+        throw std::runtime_error("Snapshot request timed out");
+    }
+    // An empty frame means nothing is cached.  Otherwise, the reply is
+    // the message type and payload of each cached message.
+    std::vector<std::unique_ptr<UMPS::MessageFormats::IMessage>> result;
+    if (reply.size() == 1 && reply[0].size() == 0){return result;}
+    if (reply.size()%2 != 0)
+    {
+        throw std::runtime_error("Snapshot has an odd number of frames");
+    }
+    result.reserve(reply.size()/2);
+    for (size_t i = 0; i < reply.size(); i = i + 2)
+    {
+        auto id = pImpl->mMessageTypes.find(reply[i].to_string_view());
+        // A subscription is a prefix so skip what can't be unpacked
+        if (id < 0){continue;}
+        auto message = pImpl->mMessageTypes.createInstance(id);
+        try
+        {
+            message->fromMessage(static_cast<const char *> (reply[i + 1].data()),
+                                 reply[i + 1].size());
+        }
+        catch (const std::exception &e)
+        {
+            auto errorMsg = "Failed to unpack snapshot message of type: "
+                          + pImpl->mMessageTypes.getMessageType(id)
+                          + " with error: " + std::string(e.what());
+            pImpl->mLogger->error(errorMsg);
+            throw;
+        }
+        result.push_back(std::move(message));
+    }
+    return result;
+}
+
 /// Socket details
 UCI::SocketDetails::XSubscriber Subscriber::getSocketDetails() const
 {
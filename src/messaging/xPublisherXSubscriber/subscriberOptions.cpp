@@ -12,6 +12,7 @@ class SubscriberOptions::SubscriberOptionsImpl
 {
 public:
     UMPS::Messaging::PublisherSubscriber::SubscriberOptions mOptions;
+    std::string mSnapshotAddress;
 };
 
 /// C'tor
@@ -86,6 +87,27 @@ bool SubscriberOptions::haveAddress() const noexcept
     return pImpl->mOptions.haveAddress();
 }
 
+/// Snapshot address
+void SubscriberOptions::setSnapshotAddress(const std::string &address)
+{
+    if (isEmpty(address)){throw std::invalid_argument("Address is empty");}
+    pImpl->mSnapshotAddress = address;
+}
+
+std::string SubscriberOptions::getSnapshotAddress() const
+{
+    if (!haveSnapshotAddress())
+    {
+        throw std::invalid_argument("Snapshot address not set");
+    }
+    return pImpl->mSnapshotAddress;
+}
+
+bool SubscriberOptions::haveSnapshotAddress() const noexcept
+{
+    return !pImpl->mSnapshotAddress.empty();
+}
+
 /// ZAP options
 void SubscriberOptions::setZAPOptions(const UAuth::ZAPOptions &options)
 {
@@ -125,3 +147,18 @@ bool SubscriberOptions::haveMessageTypes() const noexcept
 {
     return pImpl->mOptions.haveMessageTypes();
 }
+
+/// Gap callback
+void SubscriberOptions::setGapCallback(
+    const std::function<void (uint64_t publisher,
+                              std::string_view messageType,
+                              uint64_t nMissed)> &callback)
+{
+    pImpl->mOptions.setGapCallback(callback);
+}
+
+std::function<void (uint64_t, std::string_view, uint64_t)>
+    SubscriberOptions::getGapCallback() const
+{
+    return pImpl->mOptions.getGapCallback();
+}
@@ -52,6 +52,7 @@
 #include "umps/proxyBroadcasts/heartbeat/publisher.hpp"
 #include "umps/proxyBroadcasts/heartbeat/publisherProcessOptions.hpp"
 #include "umps/proxyBroadcasts/heartbeat/publisherProcess.hpp"
+#include "umps/proxyBroadcasts/heartbeat/status.hpp"
 #include "umps/proxyServices/proxy.hpp"
 #include "umps/proxyServices/proxyOptions.hpp"
 #include "umps/proxyServices/command/proxy.hpp"
@@ -1142,6 +1143,18 @@ void addProxyBroadcast(ProgramOptions *options,
     UMPS::ProxyBroadcasts::ProxyOptions proxyOptions;
     proxyOptions.parseInitializationFile(iniFile, proxyBroadcast);
     proxyOptions.setZAPOptions(options->mZAPOptions);
+    // Every module's heartbeat has the same message type so cache the
+    // latest heartbeat from each module
+    if (proxyOptions.haveName() && proxyOptions.getName() == "Heartbeat")
+    {
+        proxyOptions.setLastValueCacheKeyExtractor(
+            [](const std::string_view, const std::string_view message)
+            {
+                UMPS::ProxyBroadcasts::Heartbeat::Status status;
+                status.fromMessage(message.data(), message.size());
+                return status.getModule();
+            });
+    }
     // Lift candidate addresses from proxy options
     std::string proposedFrontendAddress;
     if (proxyOptions.getProxyOptions().haveFrontendAddress())
@@ -1165,6 +1178,21 @@ void addProxyBroadcast(ProgramOptions *options,
     // Save these addresses 
     proxyOptions.setFrontendAddress(frontendAddress);
     proxyOptions.setBackendAddress(backendAddress);
+    // Subscribers request the last-value cache from its own address
+    if (proxyOptions.getProxyOptions().haveLastValueCache())
+    {
+        std::string proposedSnapshotAddress;
+        if (proxyOptions.getProxyOptions().haveSnapshotAddress())
+        {
+            proposedSnapshotAddress
+                = proxyOptions.getProxyOptions().getSnapshotAddress();
+        }
+        auto snapshotAddress = makeNewAddress(proposedSnapshotAddress,
+                                              usedAddresses,
+                                              options,
+                                              connectionType);
+        proxyOptions.setSnapshotAddress(snapshotAddress);
+    }
     options->mProxyBroadcastOptions.push_back(proxyOptions);
 }
 
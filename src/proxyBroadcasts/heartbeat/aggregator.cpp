@@ -0,0 +1,185 @@
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "umps/proxyBroadcasts/heartbeat/aggregator.hpp"
+#include "umps/proxyBroadcasts/heartbeat/subscriber.hpp"
+#include "umps/proxyBroadcasts/heartbeat/status.hpp"
+#include "umps/logging/standardOut.hpp"
+#include "private/proxyBroadcasts/heartbeat/statusTable.hpp"
+
+using namespace UMPS::ProxyBroadcasts::Heartbeat;
+
+class Aggregator::AggregatorImpl
+{
+public:
+    /// @brief C'tor.
+    explicit AggregatorImpl(
+        const std::shared_ptr<UMPS::Logging::ILog> &logger) :
+        mLogger(logger)
+    {
+        if (logger == nullptr)
+        {
+            mLogger = std::make_shared<UMPS::Logging::StandardOut> ();
+        }
+    }
+    /// @brief Destructor
+    ~AggregatorImpl()
+    {
+        stop();
+    }
+    /// @brief Receives heartbeats and checks for modules that went quiet.
+    ///        The subscriber's time out keeps this responsive to stopping.
+    void receiveStatuses()
+    {
+        mLogger->debug("Heartbeat aggregator thread starting...");
+        while (keepRunning())
+        {
+            try
+            {
+                auto status = mSubscriber->receive();
+                if (status != nullptr){mStatusTable->update(*status);}
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Failed to receive status:  Failed with:\n"
+                             + std::string{e.what()});
+            }
+            for (const auto &module : mStatusTable->processDeadlines())
+            {
+                mLogger->warn("Heartbeat from " + module + " is overdue");
+            }
+        }
+        mLogger->debug("Heartbeat aggregator thread exiting...");
+    }
+    /// @brief Starts the receiving thread.
+    void start()
+    {
+        stop();
+        setRunning(true);
+        mReceiveThread = std::thread(&AggregatorImpl::receiveStatuses, this);
+    }
+    /// @brief Stops the receiving thread.
+    void stop()
+    {
+        setRunning(false);
+        if (mReceiveThread.joinable()){mReceiveThread.join();}
+    }
+    /// @result True indicates the thread should keep running
+    [[nodiscard]] bool keepRunning() const
+    {
+        std::lock_guard<std::mutex> lockGuard(mMutex);
+        return mKeepRunning;
+    }
+    /// @brief Toggles this as running or not running
+    void setRunning(const bool running)
+    {
+        std::lock_guard<std::mutex> lockGuard(mMutex);
+        mKeepRunning = running;
+    }
+///private:
+    mutable std::mutex mMutex;
+    std::thread mReceiveThread;
+    std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
+    std::unique_ptr<Subscriber> mSubscriber{nullptr};
+    std::unique_ptr<::StatusTable> mStatusTable{nullptr};
+    bool mKeepRunning{false};
+};
+
+/// C'tor
+Aggregator::Aggregator() :
+    pImpl(std::make_unique<AggregatorImpl> (nullptr))
+{
+}
+
+Aggregator::Aggregator(std::shared_ptr<UMPS::Logging::ILog> &logger) :
+    pImpl(std::make_unique<AggregatorImpl> (logger))
+{
+}
+
+/// Destructor
+Aggregator::~Aggregator() = default;
+
+/// Initialize the class
+void Aggregator::initialize(std::unique_ptr<Subscriber> &&subscriber,
+                            const std::chrono::milliseconds &timeOut)
+{
+    if (subscriber == nullptr || !subscriber->isInitialized())
+    {
+        throw std::invalid_argument("Subscriber not initialized");
+    }
+    auto statusTable = std::make_unique<::StatusTable> (timeOut);
+    stop(); // If this exists then stop it
+    pImpl->mSubscriber = std::move(subscriber);
+    pImpl->mStatusTable = std::move(statusTable);
+}
+
+/// Initialized?
+bool Aggregator::isInitialized() const noexcept
+{
+    return pImpl->mStatusTable != nullptr;
+}
+
+/// Name
+std::string Aggregator::getName() const noexcept
+{
+    return "HeartbeatAggregator";
+}
+
+/// Start
+void Aggregator::start()
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Aggregator not initialized");
+    }
+    pImpl->start();
+}
+
+/// Running?
+bool Aggregator::isRunning() const noexcept
+{
+    return pImpl->keepRunning();
+}
+
+/// Stop
+void Aggregator::stop()
+{
+    pImpl->stop();
+}
+
+/// Update a module's status
+void Aggregator::update(const Status &status)
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Aggregator not initialized");
+    }
+    pImpl->mStatusTable->update(status);
+}
+
+/// The latest statuses
+std::shared_ptr<const std::vector<Status>> Aggregator::getStatuses() const
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Aggregator not initialized");
+    }
+    auto snapshot = pImpl->mStatusTable->getSnapshot();
+    // Shares ownership of the snapshot so nothing is copied
+    return std::shared_ptr<const std::vector<Status>> (snapshot,
+                                                       &snapshot->statuses);
+}
+
+/// Stale modules
+std::vector<std::string> Aggregator::getStaleModules() const
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Aggregator not initialized");
+    }
+    // Catch modules that went quiet since the thread last looked
+    pImpl->mStatusTable->processDeadlines();
+    return pImpl->mStatusTable->getSnapshot()->staleModules;
+}
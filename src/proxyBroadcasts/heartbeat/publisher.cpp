@@ -16,6 +16,75 @@ namespace UCI = UMPS::Services::ConnectionInformation;
 namespace UAuth = UMPS::Authentication;
 namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
 
+namespace
+{
+/// Serializes a status in the binary format so it can be sent without
+/// changing the status' default CBOR serialization.  When sending this
+/// wraps the caller's status without copying it.  Clones and new instances
+/// own their status so they also serialize in the binary format.
+class BinaryStatus : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// Wraps the status.  The status must outlive this.
+    explicit BinaryStatus(const Status &status) :
+        mStatus(&status)
+    {
+    }
+    /// Owns the status.
+    explicit BinaryStatus(std::unique_ptr<Status> &&status) :
+        mOwnedStatus(std::move(status))
+    {
+        mStatus = mOwnedStatus.get();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        clone() const final
+    {
+        return std::make_unique<BinaryStatus>
+               (std::make_unique<Status> (*mStatus));
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createInstance() const noexcept final
+    {
+        return std::make_unique<BinaryStatus> (std::make_unique<Status> ());
+    }
+    [[nodiscard]] std::string toMessage() const final
+    {
+        return mStatus->toBinary();
+    }
+    void serializeInto(std::string *message) const final
+    {
+        mStatus->serializeBinaryInto(message);
+    }
+    void fromMessage(const std::string &message) final
+    {
+        getOwnedStatus()->fromMessage(message);
+    }
+    void fromMessage(const char *data, const size_t length) final
+    {
+        getOwnedStatus()->fromMessage(data, length);
+    }
+    [[nodiscard]] std::string getMessageType() const noexcept final
+    {
+        return mStatus->getMessageType();
+    }
+    [[nodiscard]] std::string getMessageVersion() const noexcept final
+    {
+        return mStatus->getMessageVersion();
+    }
+private:
+    [[nodiscard]] Status *getOwnedStatus() const
+    {
+        if (mOwnedStatus == nullptr)
+        {
+            throw std::runtime_error("Cannot modify a wrapped status");
+        }
+        return mOwnedStatus.get();
+    }
+    std::unique_ptr<Status> mOwnedStatus{nullptr};
+    const Status *mStatus{nullptr};
+};
+}
+
 class Publisher::PublisherImpl
 {
 public:
@@ -99,6 +168,11 @@ Publisher::~Publisher() = default;
 /// Send
 void Publisher::send(const Status &message)
 {
+    if (pImpl->mOptions.useBinaryFormat())
+    {
+        pImpl->mPublisher->send(::BinaryStatus {message});
+        return;
+    }
     pImpl->mPublisher->send(message); 
 }
 
@@ -16,6 +16,7 @@ public:
         mOptions.setTimeOut(std::chrono::milliseconds{1000}); 
     }
     UMPS::Messaging::XPublisherXSubscriber::PublisherOptions mOptions;
+    bool mBinaryFormat{false};
 };
 
 /// C'tor
@@ -119,3 +120,14 @@ std::chrono::milliseconds PublisherOptions::getTimeOut() const noexcept
 {
     return pImpl->mOptions.getTimeOut();
 }
+
+/// Binary format
+void PublisherOptions::setBinaryFormat(const bool binaryFormat) noexcept
+{
+    pImpl->mBinaryFormat = binaryFormat;
+}
+
+bool PublisherOptions::useBinaryFormat() const noexcept
+{
+    return pImpl->mBinaryFormat;
+}
@@ -1,6 +1,9 @@
 #include <mutex>
 #include <thread>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -18,7 +21,8 @@
 #include "umps/services/connectionInformation/requestorOptions.hpp"
 #include "umps/services/connectionInformation/socketDetails/xSubscriber.hpp"
 #include "umps/logging/standardOut.hpp"
-#include "private/threadSafeQueue.hpp"
+#include "private/eventSignal.hpp"
+#include "private/latestValueMap.hpp"
 
 using namespace UMPS::ProxyBroadcasts::Heartbeat;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -47,15 +51,21 @@ public:
         std::lock_guard<std::mutex> lockGuard(mMutex);
         mStatus = status;
     }
-    /// @brief Sends a status message
+    /// @brief Sends a status message.  If the previous status for this
+    ///        module has not yet been published then it is replaced.
     void sendStatus(const Status &status)
     {
-        mStatusQueue.push(status);
+        auto work = status;
+        if (mLatestStatus.set(status.getModule(), std::move(work)))
+        {
+            mLogger->debug("Replaced unpublished status for "
+                         + status.getModule());
+        }
     }
     /// @brief Actually publish the message
     void publishStatus()
     {
-        Status status;
+        std::vector<Status> statuses;
         mLogger->debug("Heartbeat publisher status starting...");
         try
         {
@@ -71,7 +81,12 @@ public:
         }
         while (keepRunning())
         {
-            if (mStatusQueue.wait_until_and_pop(&status))
+            if (!mLatestStatus.wait_until_and_take(&statuses,
+                                                   mPublisherWaitTime))
+            {
+                continue;
+            }
+            for (const auto &status : statuses)
             {
                 try
                 {
@@ -102,29 +117,36 @@ public:
         mLogger->debug("Heartbeat publisher thread exiting...");
     }
     /// @brief Just keep cranking out a message that the module is running.
+    /// @details The status is sent on a fixed schedule of deadlines so the
+    ///          period does not drift.  Between deadlines the thread sleeps
+    ///          until the next deadline or until it is stopped.
     void sendMyStatus()
     {
         mLogger->debug("Heartbeat okay status thread starting...");
         // I'm forcing this to be something large - seconds
-        auto interval = mOptions.getInterval();
-        // To make this seem responsive wake up every 0.1 seconds
-        constexpr std::chrono::milliseconds fineInterval{500};
-        std::chrono::milliseconds waitTime{0};
+        const std::chrono::milliseconds interval{mOptions.getInterval()};
+        auto deadline = std::chrono::steady_clock::now() + interval;
         while (keepRunning())
         {
-            // I should continue to wait.  But not too long incase someone
-            // terminates the program.
-            if (waitTime < interval)
+            auto now = std::chrono::steady_clock::now();
+            if (now < deadline)
             {
-                std::this_thread::sleep_for(fineInterval);
-                waitTime = waitTime + fineInterval;
+                auto waitTime
+                    = std::chrono::ceil<std::chrono::milliseconds>
+                      (deadline - now);
+                mStopSignal.wait(waitTime);
+                continue;
             }
-            else // My turn to do something
+            Status status;
             {
+                std::lock_guard<std::mutex> lockGuard(mMutex);
                 mStatus.setTimeStampToNow();
-                mStatusQueue.push(mStatus);
-                waitTime = std::chrono::milliseconds {0}; // Reset
+                status = mStatus;
             }
+            sendStatus(status);
+            // Skip the deadlines that were missed (e.g., the machine slept)
+            deadline = deadline + interval;
+            if (deadline <= now){deadline = now + interval;}
         }
         mLogger->debug("Heartbeat okay status thread exiting...");
     }
@@ -133,6 +155,7 @@ public:
     {
         stop(); // Make sure everything stopped
         // Indicate this should be running
+        mStopSignal.clear();
         setRunning(true);
         // Return to default status message
         mStatus.setModule(mModule);
@@ -148,6 +171,9 @@ public:
     void stop()
     {
         setRunning(false);
+        // Wake the threads so they notice
+        mStopSignal.signal();
+        mLatestStatus.notify();
         if (mStatusThread.joinable()){mStatusThread.join();}
         if (mPublisherThread.joinable()){mPublisherThread.join();}
     }
@@ -177,7 +203,14 @@ public:
     }
 ///private:
     mutable std::mutex mMutex;
-    ThreadSafeQueue<Status> mStatusQueue;
+    // The user's thread and the status thread set the latest status for a
+    // module and the publisher thread takes and publishes them.  Statuses
+    // that are superseded before they are published are dropped.
+    LatestValueMap<std::string, Status> mLatestStatus;
+    // Wakes the status thread when stopping
+    EventSignal mStopSignal;
+    // The publisher thread checks if it should quit this often
+    const std::chrono::milliseconds mPublisherWaitTime{500};
     Status mStatus;
     std::thread mPublisherThread;
     std::thread mStatusThread;
@@ -1,11 +1,16 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <limits>
+#include <cmath>
+#include <cstdio>
 #include <nlohmann/json.hpp>
 #include <boost/asio/ip/host_name.hpp>
 #include "umps/proxyBroadcasts/heartbeat/status.hpp"
 #include "private/isEmpty.hpp"
+#include "private/messageFormats/cbor.hpp"
 
 #define MESSAGE_TYPE "UMPS::ProxyBroadcasts::Heartbeat::Status"
 #define MESSAGE_VERSION "1.0.0"
@@ -15,38 +20,222 @@ using namespace UMPS::ProxyBroadcasts::Heartbeat;
 namespace
 {
 
-std::string createTimeStamp()
+/// Looking up the host name is a system call so do it once per process
+const std::string &getCachedHostName()
+{
+    static const std::string hostName{boost::asio::ip::host_name()};
+    return hostName;
+}
+
+/// The current UTC time in microseconds since the epoch
+int64_t getNowInMicroSeconds() noexcept
 {
-    typedef std::chrono::duration<int,
-        std::ratio_multiply<std::chrono::hours::period,
-        std::ratio<24> >::type> days;
     auto now = std::chrono::system_clock::now();
-    std::chrono::system_clock::duration tp = now.time_since_epoch();
-    auto d = std::chrono::duration_cast<days>(tp);
-    tp -= d;
-    auto h = std::chrono::duration_cast<std::chrono::hours> (tp);
-    tp -= h;
-    auto m = std::chrono::duration_cast<std::chrono::minutes> (tp);
-    tp -= m;
-    auto s = duration_cast<std::chrono::seconds> (tp);
-    tp -= s;
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds> (tp);
-    tp -= ms;
-    time_t tt = std::chrono::system_clock::to_time_t(now);
-    tm utc_tm = *gmtime(&tt);
+    return std::chrono::duration_cast<std::chrono::microseconds>
+           (now.time_since_epoch()).count();
+}
+
+/// Formats microseconds since the epoch as YYYY-MM-DDTHH:MM:SS.sss
+std::string createTimeStamp(const int64_t timeStamp)
+{
+    const std::chrono::sys_time<std::chrono::microseconds>
+        time{std::chrono::microseconds {timeStamp}};
+    auto day = std::chrono::floor<std::chrono::days> (time);
+    const std::chrono::year_month_day yearMonthDay{day};
+    const std::chrono::hh_mm_ss
+        hms{std::chrono::floor<std::chrono::milliseconds> (time - day)};
     char cDate[44];
     std::fill(cDate, cDate + 44, '\0');
-    sprintf(cDate, "%04d-%02d-%02dT%02d:%02d:%02d.%03d",
-            utc_tm.tm_year + 1900,
-            utc_tm.tm_mon + 1,
-            utc_tm.tm_mday,
-            utc_tm.tm_hour,
-            utc_tm.tm_min,
-            utc_tm.tm_sec,
-            static_cast<int> (ms.count()));
+    snprintf(cDate, 44, "%04d-%02u-%02uT%02d:%02d:%02d.%03d",
+             static_cast<int> (yearMonthDay.year()),
+             static_cast<unsigned int> (yearMonthDay.month()),
+             static_cast<unsigned int> (yearMonthDay.day()),
+             static_cast<int> (hms.hours().count()),
+             static_cast<int> (hms.minutes().count()),
+             static_cast<int> (hms.seconds().count()),
+             static_cast<int> (hms.subseconds().count()));
     return std::string(cDate);
 }
 
+/// Parses YYYY-MM-DDTHH:MM:SS.sss to microseconds since the epoch
+int64_t parseTimeStamp(const std::string &timeStamp)
+{
+    if (isEmpty(timeStamp)){throw std::invalid_argument("Time stamp is empty");}
+    if (static_cast<int> (timeStamp.size()) != 23)
+    {
+        throw std::invalid_argument("Time stamp must be length at least 23");
+    }
+    double sec{0};
+    int year{0}, month{0}, dom{0}, hour{0}, minute{0};
+    sscanf(timeStamp.c_str(), "%04d-%02d-%02dT%02d:%02d:%lf",
+           &year,
+           &month,
+           &dom,
+           &hour,
+           &minute,
+           &sec);
+    int second = static_cast<int> (sec);
+    int milliSecond = static_cast<int> (std::round((sec - second)*1000));
+    if (milliSecond == 1000){milliSecond = milliSecond - 1;}
+    if (month < 1 || month > 12)
+    {
+        throw std::invalid_argument("Month = " + std::to_string(month)
+                                  + " must be in range [1,12]");
+    }
+    if (dom < 1 || dom > 31)
+    {
+        throw std::invalid_argument("Day of month = " + std::to_string(dom)
+                                  + " must be in range [1,31]");
+    }
+    if (hour < 0 || hour > 23)
+    {
+        throw std::invalid_argument("Hour = " + std::to_string(hour)
+                                  + " must be in range [0,23]");
+    }
+    if (minute < 0 || minute > 59)
+    {
+        throw std::invalid_argument("Minute = " + std::to_string(minute)
+                                  + " must be in range [0,59]");
+    }
+    if (second < 0 || second > 59)
+    {
+        throw std::invalid_argument("Second = " + std::to_string(second)
+                                  + " must be in range [0,59]");
+    }
+    if (milliSecond < 0 || milliSecond > 999)
+    {
+        throw std::invalid_argument("Millisecond = "
+                                  + std::to_string(milliSecond)
+                                  + " must be in range [0,999]");
+    }
+    const std::chrono::year_month_day
+        yearMonthDay{std::chrono::year {year},
+                     std::chrono::month {static_cast<unsigned int> (month)},
+                     std::chrono::day {static_cast<unsigned int> (dom)}};
+    if (!yearMonthDay.ok())
+    {
+        throw std::invalid_argument("Invalid date in time stamp "
+                                  + timeStamp);
+    }
+    auto time = std::chrono::sys_days {yearMonthDay}
+              + std::chrono::hours {hour}
+              + std::chrono::minutes {minute}
+              + std::chrono::seconds {second}
+              + std::chrono::milliseconds {milliSecond};
+    return std::chrono::duration_cast<std::chrono::microseconds>
+           (time.time_since_epoch()).count();
+}
+
+/// The opt-in binary format is a fixed 16 byte header followed by the
+/// module and host names.  Integers are little endian.
+///   Byte  0      BINARY_MARKER.  This is never the first byte of CBOR.
+///   Byte  1      BINARY_FORMAT_VERSION
+///   Byte  2      Module status
+///   Byte  3      Reserved
+///   Bytes 4-11   Time stamp in UTC microseconds since the epoch
+///   Bytes 12-13  Length of the module name
+///   Bytes 14-15  Length of the host name
+constexpr uint8_t BINARY_MARKER{0xFF};
+constexpr uint8_t BINARY_FORMAT_VERSION{2};
+constexpr size_t BINARY_HEADER_LENGTH{16};
+
+void writeLittleEndian(const uint64_t value, const int nBytes, char *buffer)
+{
+    for (int i = 0; i < nBytes; ++i)
+    {
+        buffer[i] = static_cast<char> ((value >> (8*i)) & 0xFF);
+    }
+}
+
+uint64_t readLittleEndian(const uint8_t *buffer, const int nBytes)
+{
+    uint64_t value{0};
+    for (int i = 0; i < nBytes; ++i)
+    {
+        value = value | (static_cast<uint64_t> (buffer[i]) << (8*i));
+    }
+    return value;
+}
+
+/// Create the binary message and append it to the message
+void toBinaryMessage(const std::string &module,
+                     const std::string &hostName,
+                     const ModuleStatus moduleStatus,
+                     const int64_t timeStamp,
+                     std::string *message)
+{
+    constexpr size_t maxLength{std::numeric_limits<uint16_t>::max()};
+    if (module.size() > maxLength)
+    {
+        throw std::runtime_error("Module name is too long");
+    }
+    if (hostName.size() > maxLength)
+    {
+        throw std::runtime_error("Host name is too long");
+    }
+    auto offset = message->size();
+    message->resize(offset + BINARY_HEADER_LENGTH);
+    auto header = message->data() + offset;
+    header[0] = static_cast<char> (BINARY_MARKER);
+    header[1] = static_cast<char> (BINARY_FORMAT_VERSION);
+    header[2] = static_cast<char> (moduleStatus);
+    header[3] = 0;
+    writeLittleEndian(static_cast<uint64_t> (timeStamp), 8, header + 4);
+    writeLittleEndian(module.size(), 2, header + 12);
+    writeLittleEndian(hostName.size(), 2, header + 14);
+    message->append(module);
+    message->append(hostName);
+}
+
+/// Unpacks the binary message.  Everything is validated before the status
+/// is modified.
+void fromBinaryMessage(const uint8_t *message, const size_t length,
+                       std::string *module,
+                       std::string *hostName,
+                       ModuleStatus *moduleStatus,
+                       int64_t *timeStamp)
+{
+    if (length < BINARY_HEADER_LENGTH)
+    {
+        throw std::invalid_argument("Message is too short");
+    }
+    if (message[0] != BINARY_MARKER)
+    {
+        throw std::invalid_argument("Message is not a binary status");
+    }
+    if (message[1] != BINARY_FORMAT_VERSION)
+    {
+        throw std::invalid_argument("Unsupported binary status version "
+                                  + std::to_string(message[1]));
+    }
+    auto status = static_cast<int8_t> (message[2]);
+    if (status < static_cast<int8_t> (ModuleStatus::Unknown) ||
+        status > static_cast<int8_t> (ModuleStatus::Died))
+    {
+        throw std::invalid_argument("Invalid module status");
+    }
+    auto moduleLength = static_cast<size_t> (readLittleEndian(message + 12, 2));
+    auto hostNameLength
+        = static_cast<size_t> (readLittleEndian(message + 14, 2));
+    if (length != BINARY_HEADER_LENGTH + moduleLength + hostNameLength)
+    {
+        throw std::invalid_argument("Inconsistent message length");
+    }
+    auto characters = reinterpret_cast<const char *> (message)
+                    + BINARY_HEADER_LENGTH;
+    std::string moduleString{characters, moduleLength};
+    std::string hostNameString{characters + moduleLength, hostNameLength};
+    if (isEmpty(moduleString)){throw std::invalid_argument("Module is empty");}
+    if (isEmpty(hostNameString))
+    {
+        throw std::invalid_argument("The host name is empty");
+    }
+    *module = std::move(moduleString);
+    *hostName = std::move(hostNameString);
+    *moduleStatus = static_cast<ModuleStatus> (status);
+    *timeStamp = static_cast<int64_t> (readLittleEndian(message + 4, 8));
+}
+
 nlohmann::json toJSONObject(const Status &status)
 {
     nlohmann::json obj;
@@ -79,10 +268,81 @@ Status fromJSONMessage(const std::string &message)
     return objectToStatus(obj);
 }
 
-Status fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToStatus(obj);
+/// Create CBOR and append it to the message.  The keys are written in the
+/// same order as nlohmann::json so the bytes match nlohmann::json::to_cbor.
+void toCBORMessage(const Status &status, std::string *message)
+{
+    CBORWriter writer(message);
+    writer.writeMapHeader(6);
+    writer.write("HostName", status.getHostName());
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
+    writer.write("Module", status.getModule());
+    writer.write("ModuleStatus", static_cast<int> (status.getModuleStatus()));
+    writer.write("TimeStamp", status.getTimeStamp());
+}
+
+/// Unpacks the CBOR message directly into the status.  This avoids the
+/// Status constructor which looks up the host name and time.
+void fromCBORMessage(const uint8_t *message, const size_t length,
+                     Status *status)
+{
+    std::string_view module;
+    std::string_view hostName;
+    std::string_view timeStamp;
+    int64_t moduleStatus{0};
+    bool haveModule{false};
+    bool haveHostName{false};
+    bool haveModuleStatus{false};
+    bool haveTimeStamp{false};
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key == "Module")
+                        {
+                            module = reader.readString();
+                            haveModule = true;
+                        }
+                        else if (key == "HostName")
+                        {
+                            hostName = reader.readString();
+                            haveHostName = true;
+                        }
+                        else if (key == "ModuleStatus")
+                        {
+                            moduleStatus = reader.readInteger();
+                            haveModuleStatus = true;
+                        }
+                        else if (key == "TimeStamp")
+                        {
+                            timeStamp = reader.readString();
+                            haveTimeStamp = true;
+                        }
+                        else
+                        {
+                            return false;
+                        }
+                        return true;
+                    });
+    if (!haveModule){throw std::invalid_argument("Module not set");}
+    if (!haveHostName){throw std::invalid_argument("Host name not set");}
+    if (!haveModuleStatus)
+    {
+        throw std::invalid_argument("Module status not set");
+    }
+    if (!haveTimeStamp){throw std::invalid_argument("Time stamp not set");}
+    // Validate everything before modifying the status
+    std::string moduleString{module};
+    std::string hostNameString{hostName};
+    if (isEmpty(moduleString)){throw std::invalid_argument("Module is empty");}
+    if (isEmpty(hostNameString))
+    {
+        throw std::invalid_argument("The host name is empty");
+    }
+    status->setTimeStamp(std::string {timeStamp});
+    status->setModule(moduleString);
+    status->setHostName(hostNameString);
+    status->setModuleStatus(static_cast<ModuleStatus> (moduleStatus));
 }
 
 }
@@ -94,8 +354,9 @@ class Status::StatusImpl
 {
 public:
     std::string mModule = "unknown";
-    std::string mHostName = boost::asio::ip::host_name(); 
-    std::string mTimeStamp = "1970:01:01T00:00:00.000";
+    std::string mHostName = ::getCachedHostName();
+    // UTC microseconds since the epoch
+    int64_t mTimeStamp{0};
     ModuleStatus mStatus = ModuleStatus::Unknown;
 };
 
@@ -196,66 +457,28 @@ std::string Status::getHostName() const noexcept
 /// Time stamp
 void Status::setTimeStampToNow() noexcept
 {
-    setTimeStamp(createTimeStamp());
+    pImpl->mTimeStamp = ::getNowInMicroSeconds();
 }
 
 void Status::setTimeStamp(const std::string &timeStamp)
 {
-    if (isEmpty(timeStamp)){throw std::invalid_argument("Time stamp is empty");}
-    if (static_cast<int> (timeStamp.size()) != 23)
-    {
-        throw std::invalid_argument("Time stamp must be length at least 23");
-    }
-    double sec;
-    int year, month, dom, hour, minute, second, milliSecond;
-    sscanf(timeStamp.c_str(), "%04d-%02d-%02dT%02d:%02d:%lf",
-           &year,
-           &month,
-           &dom,
-           &hour,
-           &minute,
-           &sec);
-    second = static_cast<int> (sec);
-    milliSecond = static_cast<int> (std::round((sec - second)*1000));
-    if (milliSecond == 1000){milliSecond = milliSecond - 1;}
-    if (month < 1 || month > 12)
-    {
-        throw std::invalid_argument("Month = " + std::to_string(month)
-                                  + " must be in range [1,12]");
-    }
-    if (dom < 1 || dom > 31)
-    {
-        throw std::invalid_argument("Day of month = " + std::to_string(dom)
-                                  + " must be in range [1,31]");
-    }
-    if (hour < 0 || hour > 23)
-    {
-        throw std::invalid_argument("Hour = " + std::to_string(hour)
-                                  + " must be in range [0,23]");
-    }
-    if (minute < 0 || minute > 59)
-    {
-        throw std::invalid_argument("Minute = " + std::to_string(minute)
-                                  + " must be in range [0,59]");
-    }
-    if (second < 0 || second > 59)
-    {
-        throw std::invalid_argument("Second = " + std::to_string(second)
-                                  + " must be in range [0,59]");
-    }
-    if (milliSecond < 0 || milliSecond > 999)
-    {
-        throw std::invalid_argument("Millisecond = "
-                                  + std::to_string(milliSecond)
-                                  + " must be in range [0,999]");
-    }
-    pImpl->mTimeStamp = timeStamp;
+    pImpl->mTimeStamp = ::parseTimeStamp(timeStamp);
+}
+
+void Status::setTimeStamp(const std::chrono::microseconds &timeStamp) noexcept
+{
+    pImpl->mTimeStamp = timeStamp.count();
 }
 
 std::string Status::getTimeStamp() const noexcept
 {
-    return pImpl->mTimeStamp;
-} 
+    return ::createTimeStamp(pImpl->mTimeStamp);
+}
+
+std::chrono::microseconds Status::getTimeStampInMicroSeconds() const noexcept
+{
+    return std::chrono::microseconds {pImpl->mTimeStamp};
+}
 
 /// Create JSON
 std::string Status::toJSON(const int nIndent) const
@@ -267,10 +490,9 @@ std::string Status::toJSON(const int nIndent) const
 /// Create CBOR
 std::string Status::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    std::string result;
+    serializeInto(&result);
+    return result;
 }
 
 /// From JSON
@@ -292,7 +514,42 @@ void Status::fromCBOR(const uint8_t *data, const size_t length)
     {   
         throw std::invalid_argument("data is NULL");
     }   
-    *this = fromCBORMessage(data, length);
+    ::fromCBORMessage(data, length, this);
+}
+
+/// Create binary
+std::string Status::toBinary() const
+{
+    std::string result;
+    serializeBinaryInto(&result);
+    return result;
+}
+
+void Status::serializeBinaryInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toBinaryMessage(pImpl->mModule, pImpl->mHostName, pImpl->mStatus,
+                      pImpl->mTimeStamp, message);
+}
+
+/// From binary
+void Status::fromBinary(const std::string &data)
+{
+    fromBinary(reinterpret_cast<const uint8_t *> (data.data()), data.size());
+}
+
+void Status::fromBinary(const uint8_t *data, const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr)
+    {
+        throw std::invalid_argument("data is NULL");
+    }
+    ::fromBinaryMessage(data, length,
+                        &pImpl->mModule,
+                        &pImpl->mHostName,
+                        &pImpl->mStatus,
+                        &pImpl->mTimeStamp);
 }
 
 ///  Convert message
@@ -301,6 +558,12 @@ std::string Status::toMessage() const
     return toCBOR();
 }
 
+void Status::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
+}
+
 void Status::fromMessage(const std::string &message)
 {
     fromMessage(message.data(), message.size());
@@ -309,7 +572,15 @@ void Status::fromMessage(const std::string &message)
 void Status::fromMessage(const char *messageIn, const size_t length)
 {
     auto message = reinterpret_cast<const uint8_t *> (messageIn);
-    fromCBOR(message, length);
+    // Publishers send CBOR unless they opted in to the binary format
+    if (length > 0 && message != nullptr && message[0] == ::BINARY_MARKER)
+    {
+        fromBinary(message, length);
+    }
+    else
+    {
+        fromCBOR(message, length);
+    }
 }
 
 /// Copy this class
@@ -333,42 +604,8 @@ std::unique_ptr<UMPS::MessageFormats::IMessage>
 bool UMPS::ProxyBroadcasts::Heartbeat::operator>(const Status &lhs,
                                                  const Status &rhs)
 {
-    auto t1 = lhs.getTimeStamp();
-    auto t2 = rhs.getTimeStamp(); 
-    double sec1;
-    int year1, month1, dom1, hour1, minute1, second1, milliSecond1;
-    sscanf(t1.c_str(), "%04d-%02d-%02dT%02d:%02d:%lf",
-           &year1,
-           &month1,
-           &dom1,
-           &hour1,
-           &minute1,
-           &sec1);
-    second1 = static_cast<int> (sec1);
-    milliSecond1 = static_cast<int> (std::round((sec1 - second1)*1000));
-    if (milliSecond1 == 1000){milliSecond1 = milliSecond1 - 1;}
-
-    double sec2;
-    int year2, month2, dom2, hour2, minute2, second2, milliSecond2;
-    sscanf(t2.c_str(), "%04d-%02d-%02dT%02d:%02d:%lf",
-           &year2,
-           &month2,
-           &dom2,
-           &hour2,
-           &minute2,
-           &sec2);
-    second2 = static_cast<int> (sec2);
-    milliSecond2 = static_cast<int> (std::round((sec2 - second2)*1000));
-    if (milliSecond2 == 1000){milliSecond2 = milliSecond2 - 1;} 
-
-    if (year1 > year2){return true;}
-    if (month1 > month2){return true;}
-    if (dom1 > dom2){return true;}
-    if (hour1 > hour2){return true;}
-    if (minute1 > minute2){return true;}
-    if (second1 > second2){return true;}
-    if (milliSecond1 > milliSecond2){return true;}
-    return false;
+    return lhs.getTimeStampInMicroSeconds()
+         > rhs.getTimeStampInMicroSeconds();
 }
 
 /// Print out the status
@@ -331,6 +331,13 @@ void Proxy::stop()
     pImpl->stop();
 }
 
+/// Statistics
+std::string Proxy::getStatistics() const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    return pImpl->mProxy->getStatistics();
+}
+
 /// Initialized?
 bool Proxy::isInitialized() const noexcept
 {
@@ -99,6 +99,78 @@ void ProxyOptions::setBackendHighWaterMark(const int highWaterMark)
     pImpl->mProxyOptions.setBackendHighWaterMark(highWaterMark);
 }
 
+/// Topic statistics
+void ProxyOptions::enableTopicStatistics() noexcept
+{
+    pImpl->mProxyOptions.enableTopicStatistics();
+}
+
+void ProxyOptions::disableTopicStatistics() noexcept
+{
+    pImpl->mProxyOptions.disableTopicStatistics();
+}
+
+/// Backend no drop
+void ProxyOptions::enableBackendNoDrop() noexcept
+{
+    pImpl->mProxyOptions.enableBackendNoDrop();
+}
+
+void ProxyOptions::disableBackendNoDrop() noexcept
+{
+    pImpl->mProxyOptions.disableBackendNoDrop();
+}
+
+/// Topic filtering
+void ProxyOptions::enableTopicFiltering() noexcept
+{
+    pImpl->mProxyOptions.enableTopicFiltering();
+}
+
+void ProxyOptions::disableTopicFiltering() noexcept
+{
+    pImpl->mProxyOptions.disableTopicFiltering();
+}
+
+/// Last-value cache
+void ProxyOptions::setLastValueCacheCapacity(const int capacity)
+{
+    pImpl->mProxyOptions.setLastValueCacheCapacity(capacity);
+}
+
+void ProxyOptions::setLastValueCacheMaximumBytes(const int64_t maximumBytes)
+{
+    pImpl->mProxyOptions.setLastValueCacheMaximumBytes(maximumBytes);
+}
+
+void ProxyOptions::setLastValueCacheKeyExtractor(
+    const std::function<std::string (std::string_view messageType,
+                                     std::string_view message)> &keyExtractor)
+{
+    pImpl->mProxyOptions.setLastValueCacheKeyExtractor(keyExtractor);
+}
+
+void ProxyOptions::setSnapshotAddress(const std::string &address)
+{
+    pImpl->mProxyOptions.setSnapshotAddress(address);
+}
+
+/// Federation
+void ProxyOptions::enableFederation() noexcept
+{
+    pImpl->mProxyOptions.enableFederation();
+}
+
+void ProxyOptions::disableFederation() noexcept
+{
+    pImpl->mProxyOptions.disableFederation();
+}
+
+void ProxyOptions::addUpstreamProxy(const std::string &address)
+{
+    pImpl->mProxyOptions.addUpstreamProxy(address);
+}
+
 /// Sets the frontend address
 void ProxyOptions::setFrontendAddress(const std::string &address)
 {
@@ -182,6 +254,53 @@ void ProxyOptions::parseInitializationFile(const std::string &iniFile,
         options.setBackendHighWaterMark(backendHighWaterMark);
     }
 
+    auto collectTopicStatistics
+        = propertyTree.get<bool> (section + ".collectTopicStatistics",
+                                  false);
+    if (collectTopicStatistics){options.enableTopicStatistics();}
+
+    auto backendNoDrop
+        = propertyTree.get<bool> (section + ".backendNoDrop", false);
+    if (backendNoDrop){options.enableBackendNoDrop();}
+
+    auto filterTopics
+        = propertyTree.get<bool> (section + ".filterTopics", false);
+    if (filterTopics){options.enableTopicFiltering();}
+
+    auto lastValueCacheCapacity
+        = propertyTree.get<int> (section + ".lastValueCacheCapacity", 0);
+    options.setLastValueCacheCapacity(lastValueCacheCapacity);
+
+    auto lastValueCacheMaximumBytes
+        = propertyTree.get<int64_t> (
+             section + ".lastValueCacheMaximumBytes",
+             options.getProxyOptions().getLastValueCacheMaximumBytes());
+    options.setLastValueCacheMaximumBytes(lastValueCacheMaximumBytes);
+
+    auto snapshotAddress
+        = propertyTree.get<std::string> (section + ".snapshotAddress", "");
+    if (!snapshotAddress.empty())
+    {
+        options.setSnapshotAddress(snapshotAddress);
+    }
+
+    auto federate = propertyTree.get<bool> (section + ".federate", false);
+    if (federate){options.enableFederation();}
+
+    // A comma separated list of upstream proxies' backend addresses
+    auto upstreamProxies
+        = propertyTree.get<std::string> (section + ".upstreamProxies", "");
+    std::vector<std::string> upstreamAddresses;
+    boost::split(upstreamAddresses, upstreamProxies, boost::is_any_of(","));
+    for (auto &upstreamAddress : upstreamAddresses)
+    {
+        boost::trim(upstreamAddress);
+        if (!upstreamAddress.empty())
+        {
+            options.addUpstreamProxy(upstreamAddress);
+        }
+    }
+
     // Got everything and didn't throw -> copy to this
     *this = std::move(options);
 
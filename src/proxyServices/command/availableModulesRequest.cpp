@@ -18,6 +18,10 @@ nlohmann::json toJSONObject(const AvailableModulesRequest &request)
     obj["MessageType"] = request.getMessageType();
     obj["MessageVersion"] = request.getMessageVersion();
     obj["Identifier"] = request.getIdentifier();
+    if (request.haveSinceVersion())
+    {
+        obj["SinceVersion"] = request.getSinceVersion();
+    }
     return obj;
 }
 
@@ -29,16 +33,19 @@ AvailableModulesRequest objectToModules(const nlohmann::json &obj)
         throw std::invalid_argument("Message has invalid message type");
     }
     request.setIdentifier(obj["Identifier"].get<int64_t> ());
+    if (obj.contains("SinceVersion"))
+    {
+        request.setSinceVersion(obj["SinceVersion"].get<uint64_t> ());
+    }
     return request;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const AvailableModulesRequest &reqeuest)
+/// Create CBOR and append it to the message
+void toCBORMessage(const AvailableModulesRequest &reqeuest,
+                   std::string *message)
 {
     auto obj = toJSONObject(reqeuest);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    nlohmann::json::to_cbor(obj, *message);
 }
 
 AvailableModulesRequest
@@ -54,6 +61,8 @@ class AvailableModulesRequest::AvailableModulesRequestImpl
 {
 public:
     int64_t mIdentifier{0};
+    uint64_t mSinceVersion{0};
+    bool mHaveSinceVersion{false};
 };
 
 /// C'tor
@@ -114,10 +123,39 @@ int64_t AvailableModulesRequest::getIdentifier() const noexcept
     return pImpl->mIdentifier;
 }
 
+/// Since version
+void AvailableModulesRequest::setSinceVersion(const uint64_t version) noexcept
+{
+    pImpl->mSinceVersion = version;
+    pImpl->mHaveSinceVersion = true;
+}
+
+uint64_t AvailableModulesRequest::getSinceVersion() const
+{
+    if (!haveSinceVersion())
+    {
+        throw std::runtime_error("Since version not set");
+    }
+    return pImpl->mSinceVersion;
+}
+
+bool AvailableModulesRequest::haveSinceVersion() const noexcept
+{
+    return pImpl->mHaveSinceVersion;
+}
+
 ///  Convert message
 std::string AvailableModulesRequest::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void AvailableModulesRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void AvailableModulesRequest::fromMessage(const std::string &message)
@@ -44,6 +44,20 @@ nlohmann::json toJSONObject(const AvailableModulesResponse &response)
     {
         obj["Modules"] = nullptr;
     }
+    if (response.getVersion() > 0)
+    {
+        obj["Version"] = response.getVersion();
+    }
+    if (response.isIncremental())
+    {
+        obj["Incremental"] = true;
+        nlohmann::json removedObjects = nlohmann::json::array();
+        for (const auto &m : response.getRemovedModules())
+        {
+            removedObjects.push_back(pack(m));
+        }
+        obj["RemovedModules"] = removedObjects;
+    }
     return obj;
 }
 
@@ -65,16 +79,34 @@ AvailableModulesResponse objectToModules(const nlohmann::json &obj)
         }
         response.setModules(std::move(modules));
     }
+    // Added in later versions
+    if (obj.contains("Version"))
+    {
+        response.setVersion(obj["Version"].get<uint64_t> ());
+    }
+    if (obj.contains("Incremental"))
+    {
+        response.setIncremental(obj["Incremental"].get<bool> ());
+    }
+    if (obj.contains("RemovedModules"))
+    {
+        std::vector<ModuleDetails> modules;
+        modules.reserve(obj["RemovedModules"].size());
+        for (const auto &moduleObject : obj["RemovedModules"])
+        {
+            modules.push_back(unpack(moduleObject));
+        }
+        response.setRemovedModules(modules);
+    }
     return response;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const AvailableModulesResponse &reqeuest)
+/// Create CBOR and append it to the message
+void toCBORMessage(const AvailableModulesResponse &reqeuest,
+                   std::string *message)
 {
     auto obj = toJSONObject(reqeuest);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    nlohmann::json::to_cbor(obj, *message);
 }
 
 AvailableModulesResponse
@@ -90,7 +122,10 @@ class AvailableModulesResponse::AvailableModulesResponseImpl
 {
 public:
     std::vector<ModuleDetails> mDetails;
+    std::vector<ModuleDetails> mRemovedDetails;
     int64_t mIdentifier{0};
+    uint64_t mVersion{0};
+    bool mIncremental{false};
 };
 
 /// C'tor
@@ -151,10 +186,53 @@ int64_t AvailableModulesResponse::getIdentifier() const noexcept
     return pImpl->mIdentifier;
 }
 
+/// Version
+void AvailableModulesResponse::setVersion(const uint64_t version) noexcept
+{
+    pImpl->mVersion = version;
+}
+
+uint64_t AvailableModulesResponse::getVersion() const noexcept
+{
+    return pImpl->mVersion;
+}
+
+/// Incremental
+void AvailableModulesResponse::setIncremental(const bool incremental) noexcept
+{
+    pImpl->mIncremental = incremental;
+}
+
+bool AvailableModulesResponse::isIncremental() const noexcept
+{
+    return pImpl->mIncremental;
+}
+
+/// Removed modules
+void AvailableModulesResponse::setRemovedModules(
+    const std::vector<ModuleDetails> &details)
+{
+    ::checkModuleDetails(details);
+    pImpl->mRemovedDetails = details;
+}
+
+std::vector<ModuleDetails> AvailableModulesResponse::getRemovedModules() const
+{
+    return pImpl->mRemovedDetails;
+}
+
 ///  Convert message
 std::string AvailableModulesResponse::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void AvailableModulesResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void AvailableModulesResponse::fromMessage(const std::string &message)
@@ -6,6 +6,7 @@
 #include <vector>
 #include <mutex>
 #include <thread>
+#include <memory>
 #include <chrono>
 #include <zmq.hpp>
 #include <zmq_addon.hpp>
@@ -35,189 +36,14 @@
 #include "private/messaging/ipcDirectory.hpp"
 #include "private/services/ping.hpp"
 #include "private/services/terminate.hpp"
-#include "private/threadSafeQueue.hpp"
+#include "private/eventSignal.hpp"
+#include "private/ringBuffer.hpp"
+#include "private/proxyServices/command/modulesMap.hpp"
 
 using namespace UMPS::ProxyServices::Command;
 namespace UCI = UMPS::Services::ConnectionInformation;
 namespace UAuth = UMPS::Authentication;
 
-namespace
-{
-
-class Module
-{
-public:
-    Module() = default;
-    Module(const ModuleDetails &details,
-           const std::vector<std::chrono::milliseconds> &pingIntervals) :
-        mPingIntervals(pingIntervals)
-    {
-        if (!details.haveName())
-        {
-            throw std::invalid_argument("Module name not set");
-        }
-        mDetails = details;
-        mJustPinged.resize(pingIntervals.size(), false);
-        // Just registered so there's a semblance of life
-        updateLastResponseToNow();
-    }
-    /// @brief Updates the timing.  
-    void updateLastResponseToNow()
-    {
-        auto now = std::chrono::high_resolution_clock::now();
-        mLastResponse
-            = std::chrono::duration_cast<std::chrono::milliseconds> (
-                 now.time_since_epoch());
-        std::fill(mJustPinged.begin(), mJustPinged.end(), false);
-    }
-    // Module details.
-    ModuleDetails mDetails;
-    // Last time module responded.
-    std::chrono::milliseconds mLastResponse{0};
-    // Last time I pinged the module
-    std::chrono::milliseconds mLastPing{0};
-    // The ping intervals
-    std::vector<std::chrono::milliseconds> mPingIntervals;
-    // True indicates the module was just pinged
-    std::vector<bool> mJustPinged;
-};
-
-/// @brief Thread-safe map between addresses and modules.
-///        Technically, both the worker address and module are unique but
-///        it proves to be slightly simpler to make the worker address the
-///        key in the map.
-class ModulesMap
-{
-public:
-    /// @brief Utility to verify that input worker address and module
-    ///        details are valid.
-    void checkAndThrow(const std::pair<std::string, ::Module> &item)
-    {
-        if (!item.second.mDetails.haveName())
-        {
-            throw std::invalid_argument("Module name not set");
-        }
-        if (contains(item.first))
-        {
-            throw std::invalid_argument("Worker already exists");
-        }
-        if (contains(item.second))
-        {
-            throw std::invalid_argument("Module already exists");
-        }
-   }
-    void insert(std::pair<std::string, ::Module> &&item)
-    {
-        checkAndThrow(item);
-        std::scoped_lock lock(mMutex);
-        mModules.insert(std::move(item));
-    }
-    void insert(const std::pair<std::string, ::Module> &item)
-    {
-        checkAndThrow(item);
-        std::scoped_lock lock(mMutex);
-        mModules.insert(item);
-    }
-    [[nodiscard]] bool empty() const noexcept
-    {
-        std::scoped_lock lock(mMutex);
-        return mModules.empty();
-    }
-    /// @result The backend's address corresponding to this module.
-    /// @note If the address is empty then it was not found.
-    [[nodiscard]]
-    std::string getAddress(const std::string &moduleName,
-                           const uint16_t instance) const noexcept
-    {
-        std::scoped_lock lock(mMutex);
-        for (const auto &m : mModules)
-        {
-            if (m.second.mDetails.haveName())
-            {
-                if (moduleName == m.second.mDetails.getName() &&
-                    instance == m.second.mDetails.getInstance())
-                {
-                    return m.first;
-                }
-            }
-        }
-        return "";
-    }
-    /// @result True indicates the module is in the map.
-    [[nodiscard]] bool contains(const ::Module &module) const noexcept
-    {
-         return contains(module.mDetails);
-    }
-    /// @result True indicates the module is in the map.
-    [[nodiscard]] bool contains(const ModuleDetails &details) const noexcept
-    {
-        std::string moduleName{""};
-        if (details.haveName())
-        {
-            moduleName = details.getName();
-        }
-        auto instance = details.getInstance();
-        std::scoped_lock lock(mMutex);
-        for (const auto &m : mModules)
-        {
-            auto instanceCompare = m.second.mDetails.getInstance();
-            if (instance == instanceCompare)
-            {
-                std::string moduleNameCompare{""};
-                if (m.second.mDetails.haveName())
-                {
-                    moduleNameCompare = m.second.mDetails.getName(); 
-                }
-                if (moduleName == moduleNameCompare)
-                {
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-    /// @brief Updates the last ping time for the module at this address.
-    void updateLastResponseToNow(const std::string &address)
-    {
-        std::scoped_lock lock(mMutex);
-        auto idx = mModules.find(address);
-        if (idx != mModules.end()){idx->second.updateLastResponseToNow();}
-    } 
-    /// @result True indicates the worker address is in the map.
-    [[nodiscard]] bool contains(const std::string &workerAddress) const noexcept
-    {
-        std::scoped_lock lock(mMutex);
-        return mModules.contains(workerAddress);
-    }
-    /// @brief Removes a module corresponding to the ZMQ address.
-    void erase(const std::string &workerAddress)
-    {
-        if (workerAddress.empty())
-        {
-            throw std::invalid_argument("Worker address is empty");
-        }
-        if (!contains(workerAddress)){return;} // Nothing to do, doesn't exist
-        std::scoped_lock lock(mMutex);
-        mModules.erase(workerAddress);
-    }
-    /// @result A list of modules.
-    [[nodiscard]] std::vector<ModuleDetails> toVector() const noexcept
-    {
-        std::vector<ModuleDetails> result;
-        std::scoped_lock lock(mMutex);
-        result.reserve(mModules.size());
-        for (const auto &m : mModules)
-        {
-            result.push_back(m.second.mDetails);
-        }
-        return result;
-    }
-    mutable std::mutex mMutex;
-    std::map<std::string, ::Module> mModules;
-};
-
-}
-
 ///--------------------------------------------------------------------------///
 ///                                 Implementation                           ///
 ///--------------------------------------------------------------------------///
@@ -233,6 +59,7 @@ public:
         if (context == nullptr)
         {
             mContext = std::make_shared<UMPS::Messaging::Context> (1);
+            mOwnContexts = true;
         }
         else
         {
@@ -256,18 +83,7 @@ public:
         {
             mAuthenticator = authenticator;
         }
-        // Now make the sockets
-        auto contextPtr
-            = reinterpret_cast<zmq::context_t *> (mContext->getContext());
-        mFrontend = std::make_unique<zmq::socket_t> (*contextPtr,
-                                                     zmq::socket_type::router);
-        mFrontend->set(zmq::sockopt::router_mandatory, 1);
-        mBackend = std::make_shared<zmq::socket_t> (*contextPtr,
-                                                    zmq::socket_type::router);
-        // Create the authenticator service
-        mAuthenticatorService
-            = std::make_unique<UAuth::Service>
-              (mContext, mLogger, mAuthenticator);
+        createSockets();
     }
     /// @brief C'tor for asymmetric authentication
     ProxyImpl(
@@ -278,6 +94,10 @@ public:
         const std::shared_ptr<UAuth::IAuthenticator> &backendAuthenticator)
     {
         // Handle context
+        if (frontendContext == nullptr && backendContext == nullptr)
+        {
+            mOwnContexts = true;
+        }
         if (frontendContext == nullptr)
         {
             mFrontendContext = std::make_shared<UMPS::Messaging::Context> (1);
@@ -330,7 +150,32 @@ public:
         assert(mFrontendAuthenticator != nullptr);
         assert(mBackendAuthenticator  != nullptr);
 #endif
-        // Now make the sockets
+        createSockets();
+    }
+    /// @brief Destructor
+    ~ProxyImpl()
+    {
+        stop();
+    }
+    /// @brief Makes the frontend and backend sockets and the authenticator
+    ///        services in the current contexts.
+    void createSockets()
+    {
+        if (mSymmetricAuthentication)
+        {
+            auto contextPtr
+                = reinterpret_cast<zmq::context_t *> (mContext->getContext());
+            mFrontend = std::make_unique<zmq::socket_t>
+                        (*contextPtr, zmq::socket_type::router);
+            mFrontend->set(zmq::sockopt::router_mandatory, 1);
+            mBackend = std::make_shared<zmq::socket_t>
+                       (*contextPtr, zmq::socket_type::router);
+            // Create the authenticator service
+            mAuthenticatorService
+                = std::make_unique<UAuth::Service>
+                  (mContext, mLogger, mAuthenticator);
+            return;
+        }
         auto contextPtr = reinterpret_cast<zmq::context_t *>
                           (mFrontendContext->getContext());
         mFrontend = std::make_unique<zmq::socket_t> (*contextPtr,
@@ -352,10 +197,39 @@ public:
                mLogger,
                mBackendAuthenticator);
     }
-    /// @brief Destructor
-    ~ProxyImpl()
+    /// @brief ZeroMQ spreads the connections to a bound socket over its
+    ///        context's I/O threads.  Those threads do the TCP, framing, and
+    ///        CURVE work for each client so, when the proxy owns its
+    ///        contexts, they are remade with the requested number of I/O
+    ///        threads.  This must happen before the sockets are bound.
+    void setNumberOfInputOutputThreads(const int nThreads)
     {
-        stop();
+        if (nThreads == mInputOutputThreads){return;}
+        if (!mOwnContexts)
+        {
+            mLogger->warn("Number of I/O threads set by provided context");
+            return;
+        }
+        mLogger->debug("Remaking proxy contexts with "
+                     + std::to_string(nThreads) + " I/O threads");
+        mFrontend.reset();
+        mBackend.reset();
+        mAuthenticatorService.reset();
+        mFrontendAuthenticatorService.reset();
+        mBackendAuthenticatorService.reset();
+        if (mSymmetricAuthentication)
+        {
+            mContext = std::make_shared<UMPS::Messaging::Context> (nThreads);
+        }
+        else
+        {
+            mFrontendContext
+                = std::make_shared<UMPS::Messaging::Context> (nThreads);
+            mBackendContext
+                = std::make_shared<UMPS::Messaging::Context> (nThreads);
+        }
+        createSockets();
+        mInputOutputThreads = nThreads;
     }
     /// @brief Bind the frontend
     void bindFrontend()
@@ -459,174 +333,254 @@ public:
             mHaveBackend = false;
         }
     }
-    /// @brief This thread periodically loops through the connected modules
-    ///        and see who appears to be alive.
+    /// @brief This thread periodically checks the modules whose next ping
+    ///        or time out is due and sees who appears to be alive.
     void runModulePinger()
     {
-        std::pair<std::string, PingResponse> pingResponses;
-        std::queue<std::string> killQueue;
+        std::pair<std::string, ::PingResponse> pingResponse;
+        std::vector<std::string> pingAddresses;
+        std::vector<std::pair<std::string, ModuleDetails>> expiredModules;
         while (isRunning())
         {
             // Process responses in my queue
-            bool moreWork{true};
-            while (moreWork)
+            while (mPingResponses.try_pop(&pingResponse))
             {
-                auto workItem = mPingResponses.try_pop();
-                if (workItem != nullptr)
-                {
-                    // Find this item
-                    auto workerAddress = workItem->first;
-                    // Update the ping request time
-                    mModulesMap.updateLastResponseToNow(workerAddress);
-                }
-                else
-                {
-                    moreWork = false;
-                }
+                // Update the ping request time
+                mModulesMap.updateLastResponseToNow(pingResponse.first);
             }
-            // If I haven't heard from you in awhile then you get a ping
+            // If I haven't heard from you in awhile then you get a ping.
+            // Expired modules are removed from the module list.
             ::PingRequest pingRequest;
             auto now = pingRequest.getTime();
-            for (auto &m : mModulesMap.mModules)
+            pingAddresses.clear();
+            expiredModules.clear();
+            mModulesMap.processDeadlines(now, &pingAddresses, &expiredModules);
+            bool haveWork = !pingAddresses.empty() || !expiredModules.empty();
+            for (const auto &pingAddress : pingAddresses)
             {
-                auto dt = now - m.second.mLastResponse;
-                // Expired - remove it from the module list
-                if (dt > mModuleTimeOutInterval)
+                if (!mPingRequests.try_push(std::pair{pingAddress,
+                                                      pingRequest}))
                 {
-                    ::TerminateRequest terminateRequest;
-                    mTerminateRequests.push(std::pair{m.first,
-                                                      terminateRequest});
-                    killQueue.push(m.first);
-                    mLogger->warn("No response from: "
-                                + m.second.mDetails.getName()
-                                + ".  Removing it from list.");
+                    mLogger->warn("Ping request queue full; skipping ping");
                 }
-                else // Time for a ping?
+            }
+            for (const auto &expiredModule : expiredModules)
+            {
+                ::TerminateRequest terminateRequest;
+                if (!mTerminateRequests.try_push(
+                        std::pair{expiredModule.first, terminateRequest}))
                 {
-                    // Hunt for first available ping time
-                    for (size_t i = 0; i < m.second.mPingIntervals.size(); ++i)
-                    {
-                        if (dt > m.second.mPingIntervals[i] &&
-                            !m.second.mJustPinged[i])
-                        {
-                            m.second.mJustPinged[i] = true;
-                            mPingRequests.push(std::pair{m.first, pingRequest});
-                            break;
-                        }
-                    }
+                    mLogger->warn("Terminate request queue full");
                 }
+                mLogger->warn("No response from: "
+                            + expiredModule.second.getName()
+                            + ".  Removing it from list.");
             }
-            // Evict terminated modules
-            while (!killQueue.empty())
+            // Let the proxy thread know there's work once per batch
+            if (haveWork){mPollerWakeUp.signal();}
+            // My life is hard.  Time for a nap (unless I'm being stopped).
+            mPingerWakeUp.wait(mTimerResolution);
+        }
+    }
+    /// @brief Handles a client's request.
+    /// @param[in,out] messagesReceived  The request from the frontend.  The
+    ///                                  payload may be moved into the result.
+    /// @param[out] toBackend  True indicates the result should be sent to the
+    ///                        backend.  Otherwise, it is a reply to the client
+    ///                        that should be sent to the frontend.
+    /// @result The message to send.  This is empty if there is nothing to
+    ///         send.
+    [[nodiscard]]
+    zmq::multipart_t __processFrontendRequest(zmq::multipart_t &messagesReceived,
+                                              bool *toBackend)
+    {
+        *toBackend = false;
+        UMPS::MessageFormats::Failure failureMessage;
+        std::string clientAddress;
+        try
+        {
+            // Get client address and message type
+            clientAddress = messagesReceived.at(0).to_string();
+            auto messageType = messagesReceived.at(2).to_string();
+            // Handle an available request message
+            AvailableModulesRequest availableModulesRequest;
+            if (messageType == availableModulesRequest.getMessageType())
             {
-                mModulesMap.erase(killQueue.front());
-                killQueue.pop();
+                mLogger->debug("Handling available modules request...");
+                const auto payload
+                    = static_cast<const char *>
+                      (messagesReceived.at(3).data());
+                availableModulesRequest.fromMessage(
+                    payload, messagesReceived.at(3).size());
+                AvailableModulesResponse availableModulesResponse;
+
+                zmq::multipart_t response;
+                response.addstr(clientAddress);
+                response.addstr("");
+                response.addstr(availableModulesResponse.getMessageType());
+                response.addstr(
+                    __getAvailableModulesMessage(availableModulesRequest));
+                return response;
             }
-            // My life is hard.  Time for a nap.
-            std::this_thread::sleep_for(std::chrono::milliseconds {100});
+            if (messagesReceived.size() != 6)
+            {
+                throw std::runtime_error(
+                   "Expecting request message of length 6.  Received: "
+                 + std::to_string(messagesReceived.size()));
+            }
+            // Which module do they want to talk to?
+            mLogger->debug("Propagating message to backend...");
+            auto moduleName = messagesReceived.at(3).to_string();
+            auto sInstance  = messagesReceived.at(4).to_string();
+            auto instance = static_cast<uint16_t> (std::stoi(sInstance));
+            // Router-router combinations are tricky.  We need to
+            // appropriately handle the routing by hand.  Details
+            // are in https://zguide.zeromq.org/docs/chapter3/
+            auto workerAddress = mModulesMap.getAddress(moduleName, instance);
+            if (!workerAddress.empty())
+            {
+                zmq::multipart_t moduleRequest;
+                moduleRequest.addstr(workerAddress);
+                // Ignore this so result shows up on backend
+                // as expected:
+                // Frame 1: Client
+                // Frame 2: Empty
+                // Frame 3: Message
+                //moduleRequest.addstr("");
+                moduleRequest.addstr(clientAddress);
+                moduleRequest.addstr("");
+                moduleRequest.addstr(messageType);
+                moduleRequest.push_back(std::move(messagesReceived.at(5)));
+                *toBackend = true;
+                return moduleRequest;
+            }
+            // Handle invalid request
+            failureMessage.setDetails("Unknown Module: " + moduleName
+                                    + ", Instance: " + sInstance);
+        }
+        catch (const zmq::error_t &e)
+        {
+            auto errorMsg = "Frontend to backend proxy error.  "
+                          + std::string("ZeroMQ failed with:\n")
+                          + std::string(e.what())
+                          + " Error Code = " + std::to_string(e.num());
+            mLogger->error(errorMsg);
+            failureMessage.setDetails("ZeroMQ proxy error");
+        }
+        catch (const std::exception &e)
+        {
+            auto errorMsg = "Frontend to backend proxy std error: "
+                          + std::string(e.what());
+            mLogger->error(errorMsg);
+            failureMessage.setDetails("Internal proxy error");
+        }
+        // Send an error message to the client if possible
+        zmq::multipart_t errorMessage;
+        if (!clientAddress.empty())
+        {
+            errorMessage.addstr(clientAddress);
+            errorMessage.addstr("");
+            errorMessage.addstr(failureMessage.getMessageType());
+            errorMessage.addstr(failureMessage.toMessage());
+        }
+        return errorMessage;
+    }
+    /// @result The serialized response to an available modules request.
+    /// @note Incremental requests are answered from the registry's change
+    ///       log.  The full list of modules is serialized once per registry
+    ///       version and request identifier.
+    [[nodiscard]] std::string __getAvailableModulesMessage(
+        const AvailableModulesRequest &request)
+    {
+        AvailableModulesResponse response;
+        response.setIdentifier(request.getIdentifier());
+        if (request.haveSinceVersion())
+        {
+            std::vector<ModuleDetails> added;
+            std::vector<ModuleDetails> removed;
+            uint64_t version{0};
+            if (mModulesMap.getChangesSince(request.getSinceVersion(),
+                                            &added, &removed, &version))
+            {
+                response.setModules(std::move(added));
+                response.setRemovedModules(removed);
+                response.setVersion(version);
+                response.setIncremental(true);
+                return response.toMessage();
+            }
+        }
+        auto snapshot = mModulesMap.getSnapshot();
+        auto &cache = mAvailableModulesCache;
+        if (!cache.message.empty() &&
+            cache.version == snapshot->version &&
+            cache.identifier == request.getIdentifier())
+        {
+            return cache.message;
+        }
+        response.setModules(snapshot->modules);
+        response.setVersion(snapshot->version);
+        cache.version = snapshot->version;
+        cache.identifier = request.getIdentifier();
+        cache.message = response.toMessage();
+        return cache.message;
+    }
+    /// @brief Sends the result of __processFrontendRequest.
+    void __sendProcessedRequest(zmq::multipart_t &&message,
+                                const bool toBackend)
+    {
+        if (message.empty()){return;}
+        try
+        {
+            if (toBackend)
+            {
+                message.send(*mBackend);
+            }
+            else
+            {
+                message.send(*mFrontend);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to send message to "
+                         + std::string {toBackend ? "backend" : "frontend"}
+                         + ".  Failed with: " + e.what());
         }
     }
     /// @brief This is the main function that is the connects the clients
     ///        connected to the frontend and modules connected to the backend.
+    /// @details ZeroMQ sockets cannot be shared between threads so this
+    ///          thread services the frontend and backend.  The per-connection
+    ///          work is done by the contexts' I/O threads.
     void runPoller()
     {
-        // Poll setup
-        constexpr size_t nPollItems = 2;
-        zmq::pollitem_t items[] =
+        // Poll setup.  The third item is the wake up signal from the module
+        // status thread and stop() so the poller can block until there is
+        // work instead of periodically timing out to check the queues.
+        std::vector<zmq::pollitem_t> items
         {
             {mFrontend->handle(), 0, ZMQ_POLLIN, 0},
-            {mBackend->handle(),  0, ZMQ_POLLIN, 0}
+            {mBackend->handle(),  0, ZMQ_POLLIN, 0},
+            {nullptr, mPollerWakeUp.getFileDescriptor(), ZMQ_POLLIN, 0}
         };
         // Run
-        UMPS::MessageFormats::Failure failureMessage;
-        AvailableModulesRequest availableModulesRequest;
+        std::pair<std::string, ::PingRequest> pingRequest;
+        std::pair<std::string, ::TerminateRequest> terminateRequest;
         while (isRunning())
         {
-            zmq::poll(&items[0], nPollItems, mPollTimeOut); 
+            zmq::poll(items.data(), items.size(), mPollTimeOut);
+            // Clear the signal before draining so a push that races the
+            // drain re-signals the next poll
+            if (items[2].revents & ZMQ_POLLIN){mPollerWakeUp.clear();}
             //----------------------------------------------------------------//
             //                     Message From Frontend                      //
             //----------------------------------------------------------------//
             if (items[0].revents & ZMQ_POLLIN)
             {
                 zmq::multipart_t messagesReceived;
-                std::string clientAddress;
-                bool lSendError{false};
                 try
                 {
                     messagesReceived.recv(*mFrontend);
-                    // Get client address and message type
-                    clientAddress = messagesReceived.at(0).to_string();
-                    auto messageType = messagesReceived.at(2).to_string();
-                    // Handle an available request message
-                    if (messageType == availableModulesRequest.getMessageType())
-                    {
-                        mLogger->debug("Handling available modules request...");
-                        const auto payload
-                            = static_cast<const char *>
-                              (messagesReceived.at(3).data());
-                        availableModulesRequest.fromMessage(
-                            payload, messagesReceived.at(3).size());
-                        AvailableModulesResponse availableModulesResponse;
-
-                        availableModulesResponse.setModules(
-                            mModulesMap.toVector());
-                        availableModulesResponse.setIdentifier(
-                            availableModulesRequest.getIdentifier());
-
-                        zmq::multipart_t response;
-                        response.addstr(clientAddress);
-                        response.addstr("");
-                        response.addstr(
-                            availableModulesResponse.getMessageType());
-                        response.addstr(availableModulesResponse.toMessage());
-                        response.send(*mFrontend);
-                    }
-                    else
-                    {
-                        if (messagesReceived.size() != 6)
-                        {
-                            throw std::runtime_error(
-                            "Expecting request message of length 6.  Received: "
-                          + std::to_string(messagesReceived.size()));
-                        }
-                        // Which module do they want to talk to?
-                        mLogger->debug("Propagating message to backend...");
-                        auto moduleName = messagesReceived.at(3).to_string();
-                        auto sInstance  = messagesReceived.at(4).to_string();
-                        auto instance
-                            = static_cast<uint16_t> (std::stoi(sInstance));
-                        // Router-router combinations are tricky.  We need to
-                        // appropriately handle the routing by hand.  Details
-                        // are in https://zguide.zeromq.org/docs/chapter3/
-                        auto workerAddress = mModulesMap.getAddress(moduleName,
-                                                                    instance);
-                        if (!workerAddress.empty())
-                        {
-                            zmq::multipart_t moduleRequest;
-                            moduleRequest.addstr(workerAddress);
-                            // Ignore this so result shows up on backend
-                            // as expected:
-                            // Frame 1: Client
-                            // Frame 2: Empty
-                            // Frame 3: Message
-                            //moduleRequest.addstr("");
-                            moduleRequest.addstr(clientAddress);
-                            moduleRequest.addstr("");
-                            moduleRequest.addstr(messageType);
-                            moduleRequest.push_back(
-                                std::move(messagesReceived.at(5)));
-                            moduleRequest.send(*mBackend);
-                        }
-                        else
-                        {
-                            // Handle invalid request
-                            failureMessage.setDetails("Unknown Module: "
-                                                    + moduleName 
-                                                    + ", Instance: "
-                                                    + sInstance);
-                            lSendError = true;
-                        }
-                    }
                 }
                 catch (const zmq::error_t &e)
                 {
@@ -635,35 +589,13 @@ public:
                                   + std::string(e.what())
                                   + " Error Code = " + std::to_string(e.num());
                     mLogger->error(errorMsg);
-                    failureMessage.setDetails("ZeroMQ proxy error");
-                    lSendError = true;
                 }
-                catch (const std::exception &e) 
+                if (!messagesReceived.empty())
                 {
-                    auto errorMsg = "Frontend to backend proxy std error: "
-                                  + std::string(e.what());
-                    mLogger->error(errorMsg);
-                    failureMessage.setDetails("Internal proxy error");
-                    lSendError = true;
-                }
-                // Send an error message to the client if possible
-                if (lSendError && !clientAddress.empty())
-                {
-                    zmq::multipart_t errorMessage;
-                    errorMessage.addstr(clientAddress);
-                    errorMessage.addstr("");
-                    errorMessage.addstr(failureMessage.getMessageType());
-                    errorMessage.addstr(failureMessage.toMessage());
-                    try
-                    {
-                        errorMessage.send(*mFrontend); 
-                    }
-                    catch (const std::exception &e)
-                    {
-                        mLogger->error("Failed to send error message to: "
-                                     + clientAddress 
-                                     + ".  Failed with: " + e.what());
-                    }
+                    bool toBackend{false};
+                    auto result = __processFrontendRequest(messagesReceived,
+                                                           &toBackend);
+                    __sendProcessedRequest(std::move(result), toBackend);
                 }
             }
             //----------------------------------------------------------------//
@@ -693,36 +625,18 @@ public:
             //----------------------------------------------------------------//
             //                      Send Ping Requests                        //
             //----------------------------------------------------------------//
-            bool sendPingRequests{true};
-            while (sendPingRequests)
+            while (mPingRequests.try_pop(&pingRequest))
             {
-                auto workItem = mPingRequests.try_pop();
-                if (workItem != nullptr)
-                {
-                    __sendPingRequestToServer(workItem->first,
-                                              workItem->second);
-                }
-                else
-                {
-                    sendPingRequests = false;
-                }
+                __sendPingRequestToServer(pingRequest.first,
+                                          pingRequest.second);
             }
             //----------------------------------------------------------------//
             //                        Send Terminate Requests                 //
             //----------------------------------------------------------------//
-            bool sendTerminateRequests{true};
-            while (sendTerminateRequests)
+            while (mTerminateRequests.try_pop(&terminateRequest))
             {
-                auto workItem = mTerminateRequests.try_pop();
-                if (workItem != nullptr)
-                {
-                    __sendTerminateRequestToServer(workItem->first,
-                                                   workItem->second);
-                }
-                else
-                {
-                    sendTerminateRequests = false;
-                }
+                __sendTerminateRequestToServer(terminateRequest.first,
+                                               terminateRequest.second);
             }
         } // while isRunning()
         // Give other threads a chance to quit
@@ -732,9 +646,9 @@ public:
         {
             ::TerminateRequest privateTerminateRequest;
             mLogger->debug("Evicting modules...");
-            for (const auto &m : mModulesMap.mModules)
+            for (const auto &workerAddress : mModulesMap.getWorkerAddresses())
             {
-                __sendTerminateRequestToServer(m.first,
+                __sendTerminateRequestToServer(workerAddress,
                                                privateTerminateRequest);
             }
             // Wait for other threads to process
@@ -742,9 +656,9 @@ public:
             bool waitForMoreResponses{true};
             while (waitForMoreResponses)
             {
-                // It can take a bit for a module to shut down
-                zmq::poll(&items[0], nPollItems,
-                          std::chrono::milliseconds {5000}); //mPollTimeOut);
+                // It can take a bit for a module to shut down.  Only the
+                // backend is of interest now.
+                zmq::poll(&items[1], 1, std::chrono::milliseconds {5000});
                 if (items[1].revents & ZMQ_POLLIN)
                 {
                     try
@@ -774,10 +688,9 @@ public:
             }
         }
         // Warn about maybe who didn't deregister
-        for (const auto &m : mModulesMap.mModules)
+        for (const auto &details : mModulesMap.toVector())
         {
-            mLogger->warn(m.second.mDetails.getName()
-                        + " may still be running"); 
+            mLogger->warn(details.getName() + " may still be running"); 
         }
     } // End function
     /// @brief Sends a ping message to the backend.
@@ -838,7 +751,12 @@ public:
             mLogger->error("Failed to deserialize ping from " + workerAddress);
             return;
         }
-        mPingResponses.push(std::pair{workerAddress, pingResponse});
+        if (!mPingResponses.try_push(std::pair{workerAddress,
+                                               std::move(pingResponse)}))
+        {
+            mLogger->warn("Ping response queue full; dropping response from "
+                        + workerAddress);
+        }
     }
     /// @brief Private function to handle a terminate request.
     void __handleTerminateResponse(const zmq::multipart_t &messagesReceived)
@@ -870,7 +788,8 @@ public:
                 mLogger->info("Registering: " + workerAddress);
                 mModulesMap.insert(std::pair{workerAddress,
                                              ::Module(moduleDetails,
-                                             mOptions.getPingIntervals())});
+                                                      mPingIntervals,
+                                                      mModuleTimeOutInterval)});
             } 
             else
             {
@@ -1048,8 +967,16 @@ public:
     /// @brief Note whether the proxy was started / stopped.
     void setRunning(const bool running)
     {
-        std::scoped_lock lock(mMutex);
-        mRunning = running;
+        {
+            std::scoped_lock lock(mMutex);
+            mRunning = running;
+        }
+        // Wake the threads so they notice the change
+        if (!running)
+        {
+            mPollerWakeUp.signal();
+            mPingerWakeUp.signal();
+        }
     }
     /// @brief True indicates the proxy is running or not.
     bool isRunning() const
@@ -1088,14 +1015,28 @@ public:
     std::chrono::milliseconds mModuleTimeOutInterval;
     // The registered modules
     ::ModulesMap mModulesMap;
+    // The serialized list of every module for a registry version.  This is
+    // only used by the proxy thread.
+    struct CachedAvailableModules
+    {
+        std::string message;
+        uint64_t version{0};
+        int64_t identifier{0};
+    };
+    CachedAvailableModules mAvailableModulesCache;
+    // The maximum number of messages in each queue between the proxy
+    // thread and the module status thread
+    static constexpr size_t QUEUE_CAPACITY{8192};
     // Queue: ping responses (from proxy thread for module status thread)
-    ::ThreadSafeQueue<std::pair<std::string, ::PingResponse>> mPingResponses;
+    ::SPSCRingBuffer<std::pair<std::string, ::PingResponse>>
+        mPingResponses{QUEUE_CAPACITY};
     // Queue: ping requests (from module status thread to proxy thread to send)
-    ::ThreadSafeQueue<std::pair<std::string, ::PingRequest>> mPingRequests;
+    ::SPSCRingBuffer<std::pair<std::string, ::PingRequest>>
+        mPingRequests{QUEUE_CAPACITY};
     // Queue: terminate requests (from module status thread to proxy
     //        thread to send)
-    ::ThreadSafeQueue<std::pair<std::string, ::TerminateRequest>>
-        mTerminateRequests;
+    ::SPSCRingBuffer<std::pair<std::string, ::TerminateRequest>>
+        mTerminateRequests{QUEUE_CAPACITY};
     ProxyOptions mOptions;
     UCI::Details mConnectionDetails;
     std::string mFrontendAddress;
@@ -1109,12 +1050,22 @@ public:
     std::thread mModuleStatusThread;
     std::vector<std::chrono::milliseconds>
         mPingIntervals{std::chrono::milliseconds {10000}};
-    std::chrono::milliseconds mPollTimeOut{10};
+    // Wakes the proxy thread when there are queued requests or on stop
+    ::EventSignal mPollerWakeUp;
+    // Wakes the module status thread on stop
+    ::EventSignal mPingerWakeUp;
+    // The proxy thread blocks until a socket or the wake up is readable
+    std::chrono::milliseconds mPollTimeOut{-1};
+    std::chrono::milliseconds mTimerResolution{100};
+    // The number of I/O threads in the contexts made by the proxy
+    int mInputOutputThreads{1};
     bool mHaveBackend{false};
     bool mHaveFrontend{false};
     bool mRunning{false};
     bool mInitialized{false};
     bool mSymmetricAuthentication{true};
+    // True indicates the proxy made its contexts
+    bool mOwnContexts{false};
 };
 
 /// C'tor
@@ -1164,10 +1115,18 @@ void Proxy::initialize(const ProxyOptions &options)
     pImpl->mPingIntervals = options.getPingIntervals();
     pImpl->mModuleTimeOutInterval = pImpl->mPingIntervals.back()
                                   + std::chrono::milliseconds{100};
+    pImpl->mTimerResolution = options.getTimerResolution();
     pImpl->mInitialized = false;
     // Disconnect from old connections
     pImpl->disconnectFrontend();
     pImpl->disconnectBackend();
+    // Spread the client connections over the I/O threads
+    auto nThreads = options.getNumberOfInputOutputThreads();
+    if (nThreads != pImpl->mInputOutputThreads)
+    {
+        pImpl->stop();
+        pImpl->setNumberOfInputOutputThreads(nThreads);
+    }
     // Create the ZAP options
     auto zapOptions = pImpl->mOptions.getZAPOptions();
     zapOptions.setSocketOptions(&*pImpl->mFrontend);
@@ -19,11 +19,13 @@ public:
         std::chrono::milliseconds  {30000}, // 30s
         std::chrono::milliseconds  {60000}  // 60s
     };
+    std::chrono::milliseconds mTimerResolution{100};
     UAuth::ZAPOptions mZAPOptions;
     std::string mFrontendAddress;
     std::string mBackendAddress;
     int mBackendHighWaterMark{0};
     int mFrontendHighWaterMark{0};
+    int mNumberOfInputOutputThreads{1};
 };
 
 /// C'tor
@@ -187,6 +189,38 @@ std::vector<std::chrono::milliseconds>
     return pImpl->mPingIntervals;
 }
 
+/// Timer resolution
+void ProxyOptions::setTimerResolution(
+    const std::chrono::milliseconds &resolution)
+{
+    if (resolution.count() <= 0)
+    {
+        throw std::invalid_argument("Timer resolution must be positive");
+    }
+    pImpl->mTimerResolution = resolution;
+}
+
+std::chrono::milliseconds ProxyOptions::getTimerResolution() const noexcept
+{
+    return pImpl->mTimerResolution;
+}
+
+/// Number of I/O threads
+void ProxyOptions::setNumberOfInputOutputThreads(const int nThreads)
+{
+    if (nThreads < 1)
+    {
+        throw std::invalid_argument(
+            "Number of I/O threads must be positive");
+    }
+    pImpl->mNumberOfInputOutputThreads = nThreads;
+}
+
+int ProxyOptions::getNumberOfInputOutputThreads() const noexcept
+{
+    return pImpl->mNumberOfInputOutputThreads;
+}
+
 /// Read the proxy optoins from an ini file
 void ProxyOptions::parseInitializationFile(const std::string &iniFile,
                                            const std::string &section)
@@ -257,6 +291,17 @@ void ProxyOptions::parseInitializationFile(const std::string &iniFile,
         pingIntervals.push_back(std::chrono::milliseconds {pingInterval}); 
     }
     if (!pingIntervals.empty()){options.setPingIntervals(pingIntervals);}
+    // Timer resolution
+    auto timerResolution
+        = propertyTree.get<int> (section + ".timerResolution",
+                                 static_cast<int> (
+                                    options.getTimerResolution().count()));
+    options.setTimerResolution(std::chrono::milliseconds {timerResolution});
+    // Number of I/O threads
+    auto nThreads
+        = propertyTree.get<int> (section + ".numberOfInputOutputThreads",
+                                 options.getNumberOfInputOutputThreads());
+    options.setNumberOfInputOutputThreads(nThreads);
     // Got everything and didn't throw -> copy to this
     *this = std::move(options);
 }
@@ -33,13 +33,11 @@ RegistrationRequest objectToRequest(const nlohmann::json &obj)
     return request;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const RegistrationRequest &request)
+/// Create CBOR and append it to the message
+void toCBORMessage(const RegistrationRequest &request, std::string *message)
 {
     auto obj = toJSONObject(request);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    nlohmann::json::to_cbor(obj, *message);
 }
 
 RegistrationRequest fromCBORMessage(const uint8_t *message, const size_t length)
@@ -143,7 +141,15 @@ RegistrationType RegistrationRequest::getRegistrationType() const noexcept
 /// Convert message
 std::string RegistrationRequest::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void RegistrationRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void RegistrationRequest::fromMessage(const std::string &message)
@@ -31,13 +31,11 @@ RegistrationResponse objectToResponse(const nlohmann::json &obj)
     return response;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const RegistrationResponse &response)
+/// Create CBOR and append it to the message
+void toCBORMessage(const RegistrationResponse &response, std::string *message)
 {
     auto obj = toJSONObject(response);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    nlohmann::json::to_cbor(obj, *message);
 }   
 
 RegistrationResponse fromCBORMessage(const uint8_t *message, const size_t length)
@@ -126,7 +124,15 @@ bool RegistrationResponse::haveReturnCode() const noexcept
 ///  Convert message
 std::string RegistrationResponse::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void RegistrationResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void RegistrationResponse::fromMessage(const std::string &message)
@@ -1,5 +1,8 @@
 #include <iostream>
+#include <sstream>
 #include <thread>
+#include <vector>
+#include <algorithm>
 #include <utility>
 #include "umps/proxyServices/command/replier.hpp"
 #include "umps/proxyServices/command/replierOptions.hpp"
@@ -40,10 +43,124 @@ public:
         mMessageFormats.add(registrationResponse);
         
     }
+    /// @result The callback's response to the request.  If the callback
+    ///         throws then this is a failure message.
+    /// @note With workers this is called concurrently.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        processRequest(const std::string &messageType,
+                       const void *messageContents,
+                       const size_t messageSize)
+    {
+        std::unique_ptr<UMPS::MessageFormats::IMessage> response{nullptr};
+        try
+        {
+            response = mCallback(messageType, messageContents, messageSize);
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Error in callback/serialization: "
+                         + std::string{e.what()});
+            // The user's callbacks should not fail.  But, just
+            // in case, send something back.
+            UMPS::MessageFormats::Failure failureMessage;
+            failureMessage.setDetails("Error in callback");
+            response = failureMessage.clone();
+        }
+        return response;
+    }
+    /// @brief Sends a reply to the client at the return address.
+    void sendReply(const std::string &returnAddress,
+                   const UMPS::MessageFormats::IMessage &response)
+    {
+        try
+        {
+            zmq::multipart_t reply;
+            reply.addstr(returnAddress);
+            reply.addstr("");
+            reply.addstr(response.getMessageType());
+            reply.addstr(response.toMessage());
+            reply.send(*mSocket);
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to send reply. Failed with: "
+                         + std::string{e.what()});
+        }
+    }
+    /// @brief Worker thread.  The workers are REP sockets behind a DEALER
+    ///        so each reply carries the return address of its request.
+    ///        Requests arrive as [return address, type, contents] and
+    ///        replies leave as [return address, type, contents] or, if the
+    ///        callback returned nothing, [return address].
+    void runWorker(const std::string &workersAddress)
+    {
+        auto contextPtr
+            = reinterpret_cast<zmq::context_t *> (mContext->getContext());
+        zmq::socket_t worker(*contextPtr, zmq::socket_type::rep);
+        worker.set(zmq::sockopt::linger, 0);
+        worker.connect(workersAddress);
+        std::array<zmq::pollitem_t, 1> pollItems
+        {
+             {{worker.handle(), 0, ZMQ_POLLIN, 0}}
+        };
+        auto pollingTimeOut = mOptions.getOptions().getPollingTimeOut();
+        while (isRunning())
+        {
+            zmq::poll(pollItems.data(), pollItems.size(), pollingTimeOut);
+            if (!(pollItems[0].revents & ZMQ_POLLIN)){continue;}
+            zmq::multipart_t request(worker);
+            zmq::multipart_t reply;
+            if (request.size() != 3)
+            {
+                mLogger->error("Replier worker only handles 3-part messages");
+                reply.addstr(request.empty() ? "" : request.at(0).to_string());
+                reply.send(worker);
+                continue;
+            }
+            // Keep the address in case the response can't be serialized
+            auto returnAddress = request.at(0).to_string();
+            reply.push_back(std::move(request.at(0)));
+            auto messageType = request.at(1).to_string();
+            auto response = processRequest(messageType,
+                                           request.at(2).data(),
+                                           request.at(2).size());
+            if (response != nullptr)
+            {
+                try
+                {
+                    reply.addstr(response->getMessageType());
+                    reply.addstr(response->toMessage());
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("Failed to serialize response: "
+                                 + std::string{e.what()});
+                    UMPS::MessageFormats::Failure failureMessage;
+                    failureMessage.setDetails("Failed to serialize response");
+                    reply.clear();
+                    reply.addstr(returnAddress);
+                    reply.addstr(failureMessage.getMessageType());
+                    reply.addstr(failureMessage.toMessage());
+                }
+            }
+            reply.send(worker);
+        }
+    }
+    /// Creates a unique inproc address for the workers
+    [[nodiscard]] std::string makeWorkersAddress() const
+    {
+        std::ostringstream address;
+        address << "inproc://umps.proxyServices.command.replier.workers."
+                << static_cast<const void *> (this);
+        return address.str();
+    }
     /// @brief This performs the polling loop that will:
     ///        1.  Wait for messages from the client.
     ///        2.  Call the callback to process the message.
     ///        3.  Return the result of the callback to the client.
+    /// @details If there are workers then ping and terminate requests are
+    ///          still handled here but other requests are dealt to the
+    ///          workers and their replies are forwarded when they arrive.
     void poll() override
     {   
         if (!mHaveCallback)
@@ -51,6 +168,36 @@ public:
             throw std::runtime_error("Callback not set for poll");
         }
         auto pollingTimeOut = mOptions.getOptions().getPollingTimeOut();
+        // Start the workers
+        const auto nWorkers = mOptions.getNumberOfWorkers();
+        const auto maximumInFlight
+            = mOptions.getMaximumNumberOfRequestsInFlight();
+        int nInFlight{0};
+        std::unique_ptr<zmq::socket_t> workers{nullptr};
+        std::vector<std::thread> workerThreads;
+        if (nWorkers > 0)
+        {
+            auto workersAddress = makeWorkersAddress();
+            auto contextPtr
+                = reinterpret_cast<zmq::context_t *> (mContext->getContext());
+            workers = std::make_unique<zmq::socket_t>
+                      (*contextPtr, zmq::socket_type::dealer);
+            workers->set(zmq::sockopt::linger, 0);
+            // The in-flight limit bounds the queue
+            workers->set(zmq::sockopt::sndhwm, 0);
+            workers->set(zmq::sockopt::rcvhwm, 0);
+            workers->bind(workersAddress);
+            mLogger->debug("Starting " + std::to_string(nWorkers)
+                         + " replier workers");
+            workerThreads.reserve(nWorkers);
+            for (int i = 0; i < nWorkers; ++i)
+            {
+                workerThreads.push_back(std::thread(&ReplierImpl::runWorker,
+                                                    this, workersAddress));
+            }
+        }
+        UMPS::MessageFormats::Failure busyMessage;
+        busyMessage.setDetails("Replier busy; too many requests in flight");
         ::PingRequest privatePingRequest;
         ::PingResponse privatePingResponse;
         ::TerminateRequest privateTerminateRequest;
@@ -63,13 +210,42 @@ public:
         while (isRunning())
         {
             // Poll
-            std::array<zmq::pollitem_t, 1> pollItems
-            {
-                 {{mSocket->handle(), 0, ZMQ_POLLIN, 0}}
-            };
+            std::array<zmq::pollitem_t, 2> pollItems
+            {{
+                 {mSocket->handle(), 0, ZMQ_POLLIN, 0},
+                 {workers ? workers->handle() : nullptr, -1, ZMQ_POLLIN, 0}
+            }};
             zmq::poll(pollItems.data(),
-                      pollItems.size(),
+                      workers ? 2 : 1,
                       pollingTimeOut);
+            // Forward the workers' replies
+            if (workers && (pollItems[1].revents & ZMQ_POLLIN))
+            {
+                zmq::multipart_t workerReply(*workers);
+                nInFlight = std::max(0, nInFlight - 1);
+                // Empty delimiter, return address, [type, contents]
+                if (workerReply.size() == 4)
+                {
+                    // Swap the order of the delimiter and return address
+                    workerReply.pop();
+                    auto returnAddress = workerReply.popstr();
+                    workerReply.pushstr("");
+                    workerReply.pushstr(returnAddress);
+                    try
+                    {
+                        workerReply.send(*mSocket);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        mLogger->error("Failed to send reply. Failed with: "
+                                     + std::string{e.what()});
+                    }
+                }
+                else
+                {
+                    mLogger->error("Response is NULL check calllback");
+                }
+            }
             // Got something
             if (pollItems[0].revents & ZMQ_POLLIN)
             {
@@ -167,43 +343,43 @@ public:
                            + std::string{e.what()});
                     }
                 }
-                else
+                else if (workers)
                 {
-                    std::unique_ptr<UMPS::MessageFormats::IMessage>
-                        response{nullptr};
+                    // Shed load rather than let the backlog grow
+                    if (nInFlight >= maximumInFlight)
+                    {
+                        mLogger->warn("Too many requests in flight; "
+                                    + std::string {"rejecting request"});
+                        sendReply(returnAddress, busyMessage);
+                        continue;
+                    }
                     try
                     {
-                        response = mCallback(messageType,
-                                             messageContents,
-                                             messageSize);
+                        zmq::multipart_t workerRequest;
+                        workerRequest.addstr(""); // Delimiter for REP
+                        workerRequest.push_back(
+                            std::move(messagesReceived.at(0)));
+                        workerRequest.push_back(
+                            std::move(messagesReceived.at(2)));
+                        workerRequest.push_back(
+                            std::move(messagesReceived.at(3)));
+                        workerRequest.send(*workers);
+                        nInFlight = nInFlight + 1;
                     }
-                    catch (const std::exception &e) 
+                    catch (const std::exception &e)
                     {
-                        mLogger->error("Error in callback/serialization: "
+                        mLogger->error("Failed to send request to workers: "
                                      + std::string{e.what()});
-                        // The user's callbacks should not fail.  But, just
-                        // in case, send something back.
-                        UMPS::MessageFormats::Failure failureMessage;
-                        failureMessage.setDetails("Error in callback");
-                        response = failureMessage.clone();
                     }
+                }
+                else
+                {
+                    auto response = processRequest(messageType,
+                                                   messageContents,
+                                                   messageSize);
                     if (response != nullptr)
                     {
-                        try
-                        {
-                            zmq::multipart_t reply;
-                            reply.addstr(returnAddress);
-                            reply.addstr("");
-                            reply.addstr(response->getMessageType());
-                            reply.addstr(response->toMessage());
-                            reply.send(*mSocket);
-                        }
-                        catch (const std::exception &e)
-                        {
-                            mLogger->error(
-                               "Failed to send reply. Failed with: "
-                              + std::string{e.what()});
-                        }
+                        sendReply(returnAddress, *response);
                     }
                     else
                     {
@@ -212,6 +388,10 @@ public:
                 }
             }  // End check on poll
         } // End loop
+        for (auto &workerThread : workerThreads)
+        {
+            if (workerThread.joinable()){workerThread.join();}
+        }
         mLogger->debug("Reply poll loop finished");
     }
     /// Register the replier
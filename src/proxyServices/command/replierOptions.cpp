@@ -25,6 +25,8 @@ public:
     }
     URouterDealer::ReplyOptions mOptions;
     ModuleDetails mDetails;
+    int mWorkers{0};
+    int mMaximumInFlight{64};
     bool mHaveDetails{false};
 };
 
@@ -183,3 +185,35 @@ std::chrono::milliseconds ReplierOptions::getPollingTimeOut() const noexcept
 {
     return pImpl->mOptions.getPollingTimeOut();
 }
+
+/// Number of workers
+void ReplierOptions::setNumberOfWorkers(const int nWorkers)
+{
+    if (nWorkers < 0)
+    {
+        throw std::invalid_argument("Number of workers cannot be negative");
+    }
+    pImpl->mWorkers = nWorkers;
+}
+
+int ReplierOptions::getNumberOfWorkers() const noexcept
+{
+    return pImpl->mWorkers;
+}
+
+/// Maximum number of requests in flight
+void ReplierOptions::setMaximumNumberOfRequestsInFlight(
+    const int maximumInFlight)
+{
+    if (maximumInFlight < 1)
+    {
+        throw std::invalid_argument(
+            "Maximum number of requests in flight must be positive");
+    }
+    pImpl->mMaximumInFlight = maximumInFlight;
+}
+
+int ReplierOptions::getMaximumNumberOfRequestsInFlight() const noexcept
+{
+    return pImpl->mMaximumInFlight;
+}
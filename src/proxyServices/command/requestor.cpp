@@ -179,6 +179,29 @@ std::unique_ptr<AvailableModulesResponse>
     return result;
 }
 
+std::unique_ptr<AvailableModulesResponse>
+    Requestor::getAvailableModules(const uint64_t sinceVersion) const
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Requestor not initialized");
+    }
+    std::unique_ptr<AvailableModulesResponse> result{nullptr};
+    AvailableModulesRequest requestMessage;
+    requestMessage.setSinceVersion(sinceVersion);
+    auto message = pImpl->request(requestMessage);
+    if (message != nullptr)
+    {
+        result = UMF::static_unique_pointer_cast<AvailableModulesResponse>
+                 (std::move(message));
+    }
+    else
+    {
+        pImpl->mLogger->warn("Request timed out");
+    }
+    return result;
+}
+
 /// Commands
 std::unique_ptr<UCommand::AvailableCommandsResponse>
     Requestor::getCommands(const std::string &moduleName,
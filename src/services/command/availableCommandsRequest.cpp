@@ -1,8 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/availableCommandsRequest.hpp"
+#include "private/messageFormats/cbor.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::AvailableCommandsRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -12,38 +12,21 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const AvailableCommandsRequest &request)
+/// Create CBOR and append it to the message
+void toCBORMessage(const AvailableCommandsRequest &,
+                   std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = request.getMessageType();
-    obj["MessageVersion"] = request.getMessageVersion();
-    return obj;
-}
-
-AvailableCommandsRequest objectToCommands(const nlohmann::json &obj)
-{
-    AvailableCommandsRequest request;
-    if (obj["MessageType"] != request.getMessageType())
-    {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    return request;
-}
-
-/// Create CBOR
-std::string toCBORMessage(const AvailableCommandsRequest &reqeuest)
-{
-    auto obj = toJSONObject(reqeuest);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    CBORWriter writer(message);
+    writer.writeMapHeader(2);
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
 AvailableCommandsRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToCommands(obj);
+    readCBORMessage(message, length, MESSAGE_TYPE);
+    return AvailableCommandsRequest {};
 }
 
 }
@@ -103,7 +86,15 @@ AvailableCommandsRequest::~AvailableCommandsRequest() = default;
 ///  Convert message
 std::string AvailableCommandsRequest::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void AvailableCommandsRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void AvailableCommandsRequest::fromMessage(const std::string &message)
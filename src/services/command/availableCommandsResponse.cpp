@@ -1,8 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/availableCommandsResponse.hpp"
+#include "private/messageFormats/cbor.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::AvailableCommandsResponse"
 #define MESSAGE_VERSION "1.0.0"
@@ -12,43 +12,34 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const AvailableCommandsResponse &response)
+/// Create CBOR and append it to the message
+void toCBORMessage(const AvailableCommandsResponse &response,
+                   std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = response.getMessageType();
-    obj["MessageVersion"] = response.getMessageVersion();
-    obj["Commands"] = response.getCommands();
-    return obj;
-}
-
-AvailableCommandsResponse objectToCommands(const nlohmann::json &obj)
-{
-    AvailableCommandsResponse response;
-    if (obj["MessageType"] != response.getMessageType())
-    {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    if (!obj["Commands"].is_null())
-    {
-        response.setCommands(obj["Commands"]);
-    }
-    return response;
-}
-
-/// Create CBOR
-std::string toCBORMessage(const AvailableCommandsResponse &reqeuest)
-{
-    auto obj = toJSONObject(reqeuest);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    CBORWriter writer(message);
+    writer.writeMapHeader(3);
+    writer.write("Commands", response.getCommands());
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
 AvailableCommandsResponse
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToCommands(obj);
+    AvailableCommandsResponse response;
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key != "Commands"){return false;}
+                        // Older messages may not have set the commands
+                        if (!reader.readNull())
+                        {
+                            response.setCommands(
+                                std::string {reader.readString()});
+                        }
+                        return true;
+                    });
+    return response;
 }
 
 }
@@ -121,7 +112,15 @@ std::string AvailableCommandsResponse::getCommands() const noexcept
 ///  Convert message
 std::string AvailableCommandsResponse::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void AvailableCommandsResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void AvailableCommandsResponse::fromMessage(const std::string &message)
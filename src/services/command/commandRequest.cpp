@@ -1,6 +1,6 @@
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/commandRequest.hpp"
+#include "private/messageFormats/cbor.hpp"
 #include "private/isEmpty.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::CommandRequest"
@@ -11,41 +11,33 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const CommandRequest &request)
+/// Create CBOR and append it to the message
+void toCBORMessage(const CommandRequest &request, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = request.getMessageType();
-    obj["MessageVersion"] = request.getMessageVersion();
-    obj["Command"] = request.getCommand(); 
-    return obj;
+    CBORWriter writer(message);
+    writer.writeMapHeader(3);
+    writer.write("Command", request.getCommand());
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
-CommandRequest objectToCommands(const nlohmann::json &obj)
+CommandRequest fromCBORMessage(const uint8_t *message, const size_t length)
 {
     CommandRequest request;
-    if (obj["MessageType"] != request.getMessageType())
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key != "Command"){return false;}
+                        request.setCommand(std::string {reader.readString()});
+                        return true;
+                    });
+    if (!request.haveCommand())
     {
-        throw std::invalid_argument("Message has invalid message type");
+        throw std::invalid_argument("Command not set");
     }
-    request.setCommand(obj["Command"]);
     return request;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const CommandRequest &request)
-{
-    auto obj = toJSONObject(request);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
-}
-
-CommandRequest fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToCommands(obj);
-}
-
 }
 
 class CommandRequest::CommandRequestImpl
@@ -100,7 +92,15 @@ CommandRequest::~CommandRequest() = default;
 ///  Convert message
 std::string CommandRequest::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void CommandRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void CommandRequest::fromMessage(const std::string &message)
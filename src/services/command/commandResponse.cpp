@@ -1,6 +1,6 @@
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/commandResponse.hpp"
+#include "private/messageFormats/cbor.hpp"
 #include "private/isEmpty.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::CommandResponse"
@@ -11,45 +11,49 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const CommandResponse &response)
+/// Create CBOR and append it to the message
+void toCBORMessage(const CommandResponse &response, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = response.getMessageType();
-    obj["MessageVersion"] = response.getMessageVersion();
-    obj["Response"] = response.getResponse();
-    obj["ReturnCode"] = static_cast<int> (response.getReturnCode());
-    return obj;
+    CBORWriter writer(message);
+    writer.writeMapHeader(4);
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
+    writer.write("Response", response.getResponse());
+    writer.write("ReturnCode", static_cast<int> (response.getReturnCode()));
 }
 
-CommandResponse objectToCommands(const nlohmann::json &obj)
+CommandResponse fromCBORMessage(const uint8_t *message, const size_t length)
 {
     CommandResponse response;
-    if (obj["MessageType"] != response.getMessageType())
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key == "Response")
+                        {
+                            response.setResponse(
+                                std::string {reader.readString()});
+                            return true;
+                        }
+                        if (key == "ReturnCode")
+                        {
+                            response.setReturnCode(
+                                static_cast<CommandResponse::ReturnCode>
+                                (reader.readInteger()));
+                            return true;
+                        }
+                        return false;
+                    });
+    if (!response.haveResponse())
+    {
+        throw std::invalid_argument("Response not set");
+    }
+    if (!response.haveReturnCode())
     {
-        throw std::invalid_argument("Message has invalid message type");
+        throw std::invalid_argument("Return code not set");
     }
-    response.setResponse(obj["Response"]);
-    response.setReturnCode(
-        static_cast<CommandResponse::ReturnCode> (
-            obj["ReturnCode"].get<int> ()));
     return response;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const CommandResponse &response)
-{
-    auto obj = toJSONObject(response);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
-}
-
-CommandResponse fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToCommands(obj);
-}
-
 }
 
 class CommandResponse::CommandResponseImpl
@@ -107,7 +111,15 @@ CommandResponse::~CommandResponse() = default;
 ///  Convert message
 std::string CommandResponse::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void CommandResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void CommandResponse::fromMessage(const std::string &message)
@@ -1,6 +1,6 @@
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/terminateRequest.hpp"
+#include "private/messageFormats/cbor.hpp"
 #include "private/isEmpty.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::TerminateRequest"
@@ -11,37 +11,19 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const TerminateRequest &request)
+/// Create CBOR and append it to the message
+void toCBORMessage(const TerminateRequest &, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = request.getMessageType();
-    obj["MessageVersion"] = request.getMessageVersion();
-    return obj;
-}
-
-TerminateRequest objectToCommands(const nlohmann::json &obj)
-{
-    TerminateRequest request;
-    if (obj["MessageType"] != request.getMessageType())
-    {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    return request;
-}
-
-/// Create CBOR
-std::string toCBORMessage(const TerminateRequest &request)
-{
-    auto obj = toJSONObject(request);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    CBORWriter writer(message);
+    writer.writeMapHeader(2);
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
 }
 
 TerminateRequest fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToCommands(obj);
+    readCBORMessage(message, length, MESSAGE_TYPE);
+    return TerminateRequest {};
 }
 
 }
@@ -98,7 +80,15 @@ TerminateRequest::~TerminateRequest() = default;
 ///  Convert message
 std::string TerminateRequest::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void TerminateRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void TerminateRequest::fromMessage(const std::string &message)
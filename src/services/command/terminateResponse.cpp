@@ -1,8 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
 #include "umps/services/command/terminateResponse.hpp"
+#include "private/messageFormats/cbor.hpp"
 #include "private/isEmpty.hpp"
 
 #define MESSAGE_TYPE "UMPS::Services::Command::TerminateResponse"
@@ -13,42 +13,35 @@ using namespace UMPS::Services::Command;
 namespace
 {
 
-nlohmann::json toJSONObject(const TerminateResponse &response)
+/// Create CBOR and append it to the message
+void toCBORMessage(const TerminateResponse &response, std::string *message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = response.getMessageType();
-    obj["MessageVersion"] = response.getMessageVersion();
-    obj["ReturnCode"] = static_cast<int> (response.getReturnCode());
-    return obj;
+    CBORWriter writer(message);
+    writer.writeMapHeader(3);
+    writer.write("MessageType", MESSAGE_TYPE);
+    writer.write("MessageVersion", MESSAGE_VERSION);
+    writer.write("ReturnCode", static_cast<int> (response.getReturnCode()));
 }
 
-TerminateResponse objectToTerminates(const nlohmann::json &obj)
+TerminateResponse fromCBORMessage(const uint8_t *message, const size_t length)
 {
     TerminateResponse response;
-    if (obj["MessageType"] != response.getMessageType())
+    readCBORMessage(message, length, MESSAGE_TYPE,
+                    [&](const std::string_view key, CBORReader &reader)
+                    {
+                        if (key != "ReturnCode"){return false;}
+                        response.setReturnCode(
+                            static_cast<TerminateResponse::ReturnCode>
+                            (reader.readInteger()));
+                        return true;
+                    });
+    if (!response.haveReturnCode())
     {
-        throw std::invalid_argument("Message has invalid message type");
+        throw std::invalid_argument("Return code not set");
     }
-    response.setReturnCode(
-        static_cast<TerminateResponse::ReturnCode> (obj["ReturnCode"]));
     return response;
 }
 
-/// Create CBOR
-std::string toCBORMessage(const TerminateResponse &response)
-{
-    auto obj = toJSONObject(response);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
-}
-
-TerminateResponse fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToTerminates(obj);
-}
-
 }
 
 class TerminateResponse::TerminateResponseImpl
@@ -106,7 +99,15 @@ TerminateResponse::~TerminateResponse() = default;
 ///  Convert message
 std::string TerminateResponse::toMessage() const
 {
-    return toCBORMessage(*this);
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void TerminateResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    ::toCBORMessage(*this, message);
 }
 
 void TerminateResponse::fromMessage(const std::string &message)
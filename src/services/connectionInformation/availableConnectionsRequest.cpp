@@ -129,6 +129,13 @@ std::string AvailableConnectionsRequest::toMessage() const
     return toCBOR();
 }
 
+void AvailableConnectionsRequest::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    auto obj = toJSONObject(*this);
+    nlohmann::json::to_cbor(obj, *message);
+}
+
 
 void AvailableConnectionsRequest::fromMessage(const std::string &message)
 {
@@ -177,8 +184,7 @@ std::string AvailableConnectionsRequest::toJSON(const int nIndent) const
 /// Create CBOR
 std::string AvailableConnectionsRequest::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    std::string result;
+    serializeInto(&result);
+    return result;
 }
@@ -642,6 +642,13 @@ std::string AvailableConnectionsResponse::toMessage() const
     return toCBOR();
 }
 
+void AvailableConnectionsResponse::serializeInto(std::string *message) const
+{
+    if (message == nullptr){throw std::invalid_argument("Message is NULL");}
+    auto obj = toJSONObject(*this);
+    nlohmann::json::to_cbor(obj, *message);
+}
+
 void AvailableConnectionsResponse::setDetails(
     const std::vector<Details> &details)
 {
@@ -721,8 +728,7 @@ std::string AvailableConnectionsResponse::toJSON(const int nIndent) const
 /// Create CBOR
 std::string AvailableConnectionsResponse::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result; 
+    std::string result;
+    serializeInto(&result);
+    return result;
 }
@@ -2,6 +2,9 @@
 #include <string>
 #include <chrono>
 #include <utility>
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include <boost/asio.hpp>
 #include "umps/proxyBroadcasts/heartbeat/publisherOptions.hpp"
 #include "umps/proxyBroadcasts/heartbeat/subscriberOptions.hpp"
@@ -9,6 +12,8 @@
 #include "umps/messaging/publisherSubscriber/subscriberOptions.hpp"
 #include "umps/authentication/zapOptions.hpp"
 #include "umps/messageFormats/messages.hpp"
+#include "private/latestValueMap.hpp"
+#include "private/proxyBroadcasts/heartbeat/statusTable.hpp"
 #include <gtest/gtest.h>
 
 namespace
@@ -58,6 +63,7 @@ TEST(BroadcastHeartbeat, PublisherOptions)
     std::chrono::milliseconds oneSecond{1000};
     EXPECT_EQ(options.getHighWaterMark(), 8192);
     EXPECT_EQ(options.getTimeOut(), oneSecond);
+    EXPECT_FALSE(options.useBinaryFormat());
     EXPECT_EQ(options.getZAPOptions().getSecurityLevel(),
               UAuth::SecurityLevel::Grasslands);
     // Test facade
@@ -70,11 +76,13 @@ TEST(BroadcastHeartbeat, PublisherOptions)
     EXPECT_NO_THROW(options.setHighWaterMark(hwm));
     options.setTimeOut(twoSeconds);
     EXPECT_NO_THROW(options.setZAPOptions(zapOptions));
+    options.setBinaryFormat(true);
 
     PublisherOptions optionsCopy(options);
     EXPECT_EQ(optionsCopy.getAddress(), frontEnd);
     EXPECT_EQ(optionsCopy.getTimeOut(), twoSeconds);
     EXPECT_EQ(optionsCopy.getHighWaterMark(), hwm);
+    EXPECT_TRUE(optionsCopy.useBinaryFormat());
     EXPECT_EQ(optionsCopy.getZAPOptions().getSecurityLevel(),
               zapOptions.getSecurityLevel());
 }
@@ -93,7 +101,10 @@ TEST(BroadcastHeartbeat, Status)
     EXPECT_NO_THROW(status.setHostName(hostName));
     EXPECT_NO_THROW(status.setTimeStamp(timeStamp));
 
+    // The default message format is CBOR
     auto message = status.toMessage();
+    EXPECT_EQ(message, status.toCBOR());
+    EXPECT_EQ(status.getMessageVersion(), "1.0.0");
     Status statusCopy;
     EXPECT_NO_THROW(statusCopy.fromMessage(message)); //message.data(), message.size());
 
@@ -101,6 +112,36 @@ TEST(BroadcastHeartbeat, Status)
     EXPECT_EQ(statusCopy.getModuleStatus(), moduleStatus);
     EXPECT_EQ(statusCopy.getHostName(), hostName);
     EXPECT_EQ(statusCopy.getTimeStamp(), timeStamp);
+    EXPECT_EQ(statusCopy.getTimeStampInMicroSeconds(),
+              std::chrono::microseconds {1667260862300000});
+
+    // Binary format keeps the microseconds
+    const std::chrono::microseconds microSeconds{1667260862300123};
+    status.setTimeStamp(microSeconds);
+    EXPECT_EQ(status.getTimeStamp(), timeStamp);
+    EXPECT_NO_THROW(statusCopy.fromBinary(status.toBinary()));
+    EXPECT_EQ(statusCopy.getModule(), module);
+    EXPECT_EQ(statusCopy.getModuleStatus(), moduleStatus);
+    EXPECT_EQ(statusCopy.getHostName(), hostName);
+    EXPECT_EQ(statusCopy.getTimeStampInMicroSeconds(), microSeconds);
+    auto binary = status.toBinary();
+    std::string buffer{"prefix"};
+    status.serializeBinaryInto(&buffer);
+    EXPECT_EQ(buffer, "prefix" + binary);
+    EXPECT_THROW(statusCopy.fromBinary(binary.substr(0, binary.size() - 1)),
+                 std::invalid_argument);
+
+    // Messages from publishers that opted in to the binary format decode
+    Status binaryCopy;
+    EXPECT_NO_THROW(binaryCopy.fromMessage(status.toBinary()));
+    EXPECT_EQ(binaryCopy.getModule(), module);
+    EXPECT_EQ(binaryCopy.getHostName(), hostName);
+    EXPECT_EQ(binaryCopy.getTimeStampInMicroSeconds(), microSeconds);
+
+    Status later(status);
+    later.setTimeStamp(microSeconds + std::chrono::microseconds {1});
+    EXPECT_TRUE(later > status);
+    EXPECT_FALSE(status > later);
     
     // Check defaults
     status.clear();
@@ -108,4 +149,134 @@ TEST(BroadcastHeartbeat, Status)
     EXPECT_EQ(status.getHostName(), referenceHostName);
 }
 
+TEST(BroadcastHeartbeat, LatestStatus)
+{
+    // Flood the publisher's latest-status slots from several modules while
+    // a slow consumer publishes.  At most one status per module is held.
+    constexpr int nModules{4};
+    constexpr int nUpdates{50000};
+    LatestValueMap<std::string, Status> latestStatus;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < nModules; ++i)
+    {
+        producers.push_back(std::thread([&latestStatus, i]()
+        {
+            Status status;
+            status.setModule("module" + std::to_string(i));
+            status.setModuleStatus(ModuleStatus::Alive);
+            for (int j = 0; j < nUpdates; ++j)
+            {
+                if (j == nUpdates - 1)
+                {
+                    status.setModuleStatus(ModuleStatus::Disconnected);
+                }
+                auto work = status;
+                latestStatus.set(status.getModule(), std::move(work));
+            }
+        }));
+    }
+    std::vector<Status> statuses;
+    size_t maxSize{0};
+    int nPublished{0};
+    for (int k = 0; k < 50; ++k)
+    {
+        maxSize = std::max(maxSize, latestStatus.size());
+        if (latestStatus.take(&statuses))
+        {
+            nPublished = nPublished + static_cast<int> (statuses.size());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds {1});
+    }
+    for (auto &producer : producers){producer.join();}
+    maxSize = std::max(maxSize, latestStatus.size());
+    EXPECT_LE(maxSize, static_cast<size_t> (nModules));
+    EXPECT_LT(nPublished, nModules*nUpdates);
+    // The newest status for every module survives
+    EXPECT_TRUE(latestStatus.wait_until_and_take(
+        &statuses, std::chrono::milliseconds {10}));
+    EXPECT_EQ(statuses.size(), static_cast<size_t> (nModules));
+    for (const auto &status : statuses)
+    {
+        EXPECT_EQ(status.getModuleStatus(), ModuleStatus::Disconnected);
+    }
+    EXPECT_TRUE(latestStatus.empty());
+}
+
+TEST(BroadcastHeartbeat, StatusTable)
+{
+    const std::chrono::milliseconds timeOut{1000};
+    EXPECT_THROW(::StatusTable table(std::chrono::milliseconds {0}),
+                 std::invalid_argument);
+    ::StatusTable table(timeOut);
+    auto t0 = ::StatusTable::Clock::now();
+    constexpr int nModules{100};
+    for (int i = 0; i < nModules; ++i)
+    {
+        Status status;
+        status.setModule("module" + std::to_string(i));
+        status.setModuleStatus(ModuleStatus::Alive);
+        table.update(status, t0);
+    }
+    EXPECT_EQ(table.size(), nModules);
+    EXPECT_EQ(table.getNumberOfDeadlines(), nModules);
+    EXPECT_EQ(table.getTimeToNextDeadline(t0), timeOut);
+    // Repeated heartbeats don't grow the table or the deadlines
+    auto t1 = t0 + std::chrono::milliseconds {500};
+    for (int j = 0; j < 10; ++j)
+    {
+        for (int i = 0; i < nModules; ++i)
+        {
+            if (i == 0){continue;} // module0 goes quiet
+            Status status;
+            status.setModule("module" + std::to_string(i));
+            status.setModuleStatus(i == 1 ? ModuleStatus::Disconnected :
+                                            ModuleStatus::Alive);
+            table.update(status, t1);
+        }
+    }
+    EXPECT_EQ(table.size(), nModules);
+    EXPECT_EQ(table.getNumberOfDeadlines(), nModules);
+    auto snapshot = table.getSnapshot();
+    EXPECT_EQ(snapshot->statuses.size(), nModules);
+    EXPECT_TRUE(snapshot->staleModules.empty());
+    EXPECT_EQ(snapshot.get(), table.getSnapshot().get());
+    // Nothing is stale before the deadline
+    EXPECT_TRUE(table.processDeadlines(t0 + timeOut
+                                     - std::chrono::milliseconds {1}).empty());
+    // Only the module that stopped sending heartbeats is stale.  The module
+    // that disconnected isn't expected to check in.
+    auto stale = table.processDeadlines(t0 + timeOut);
+    ASSERT_EQ(stale.size(), 1);
+    EXPECT_EQ(stale[0], "module0");
+    snapshot = table.getSnapshot();
+    ASSERT_EQ(snapshot->staleModules.size(), 1);
+    EXPECT_EQ(snapshot->staleModules[0], "module0");
+    EXPECT_EQ(table.getNumberOfDeadlines(), nModules - 2);
+    EXPECT_EQ(table.getTimeToNextDeadline(t0 + timeOut),
+              std::chrono::milliseconds {500});
+    stale = table.processDeadlines(t1 + timeOut);
+    EXPECT_EQ(stale.size(), nModules - 2);
+    // A heartbeat revives the module
+    Status status;
+    status.setModule("module0");
+    status.setModuleStatus(ModuleStatus::Alive);
+    table.update(status, t1 + timeOut);
+    snapshot = table.getSnapshot();
+    EXPECT_EQ(snapshot->staleModules.size(), nModules - 2);
+    EXPECT_TRUE(std::find(snapshot->staleModules.begin(),
+                          snapshot->staleModules.end(),
+                          "module0") == snapshot->staleModules.end());
+    // A repeated status, e.g., from a last-value cache, isn't a heartbeat
+    Status repeat;
+    repeat.setModule("module2");
+    repeat.setModuleStatus(ModuleStatus::Alive);
+    repeat.setTimeStamp(std::chrono::microseconds {0});
+    table.update(repeat, t1 + timeOut);
+    snapshot = table.getSnapshot();
+    EXPECT_EQ(snapshot->staleModules.size(), nModules - 2);
+    EXPECT_TRUE(std::find(snapshot->staleModules.begin(),
+                          snapshot->staleModules.end(),
+                          "module2") != snapshot->staleModules.end());
+}
+
 }
@@ -1,5 +1,9 @@
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
 #include <thread>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
 #include <sodium/crypto_pwhash.h>
 #include "umps/authentication/certificate/keys.hpp"
 #include "umps/authentication/certificate/userNameAndPassword.hpp"
@@ -406,5 +410,110 @@ TEST(Messaging, Authenticator)
     t1.join();
 }
 
+/// Opens many PLAIN (Woodhouse) clients at once and returns the time it
+/// takes for all of them to complete their handshakes and make a round trip.
+double timeWoodhouseHandshakes(const std::string &usersTable,
+                               const std::vector<UAuth::Certificate::UserNameAndPassword> &credentials,
+                               const int nWorkers)
+{
+    auto context = std::make_shared<UMPS::Messaging::Context> (1);
+    auto contextPtr = reinterpret_cast<zmq::context_t *>
+                      (context->getContext());
+    UMPS::Logging::StandardOut logger;
+    logger.setLevel(UMPS::Logging::Level::Error);
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> (logger);
+    // A fresh authenticator so no verified credentials are cached
+    auto sqlite3Authenticator
+        = std::make_shared<UAuth::SQLite3Authenticator> (loggerPtr);
+    sqlite3Authenticator->openUsersTable(usersTable, false);
+    std::shared_ptr<UAuth::IAuthenticator> authenticator = sqlite3Authenticator;
+    UAuth::Service auth(context, loggerPtr, authenticator);
+    EXPECT_THROW(auth.setNumberOfWorkers(0), std::invalid_argument);
+    EXPECT_NO_THROW(auth.setNumberOfWorkers(nWorkers));
+    EXPECT_EQ(auth.getNumberOfWorkers(), nWorkers);
+    std::thread authThread(&UAuth::Service::start, &auth);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    // The server
+    UAuth::ZAPOptions serverOptions;
+    serverOptions.setWoodhouseServer();
+    zmq::socket_t server(*contextPtr, zmq::socket_type::router);
+    serverOptions.setSocketOptions(&server);
+    server.set(zmq::sockopt::linger, 0);
+    server.bind("tcp://127.0.0.1:5557");
+    // The clients all connect at once
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<zmq::socket_t> clients;
+    for (const auto &credential : credentials)
+    {
+        UAuth::ZAPOptions clientOptions;
+        clientOptions.setWoodhouseClient(credential);
+        zmq::socket_t client(*contextPtr, zmq::socket_type::dealer);
+        clientOptions.setSocketOptions(&client);
+        client.set(zmq::sockopt::linger, 0);
+        client.connect("tcp://127.0.0.1:5557");
+        client.send(zmq::str_buffer("ping"), zmq::send_flags::none);
+        clients.push_back(std::move(client));
+    }
+    // A message only arrives once its client's handshake succeeds
+    server.set(zmq::sockopt::rcvtimeo, 30000);
+    int nAuthenticated = 0;
+    for (int i = 0; i < static_cast<int> (credentials.size()); ++i)
+    {
+        zmq::multipart_t request;
+        if (!request.recv(server)){break;}
+        request.send(server);
+        nAuthenticated = nAuthenticated + 1;
+    }
+    for (auto &client : clients)
+    {
+        client.set(zmq::sockopt::rcvtimeo, 30000);
+        zmq::message_t reply;
+        EXPECT_TRUE(client.recv(reply));
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(nAuthenticated, static_cast<int> (credentials.size()));
+    for (auto &client : clients){client.close();}
+    server.close();
+    auth.stop();
+    authThread.join();
+    std::chrono::duration<double> elapsed = endTime - startTime;
+    return elapsed.count();
+}
+
+TEST(Messaging, AuthenticatorWorkers)
+{
+    const std::string usersTable = "tables/handshakeUsers.sqlite3";
+    std::remove(usersTable.c_str());
+    // Each client is a different user so every handshake hashes a password
+    const int nClients = 8;
+    std::vector<UAuth::Certificate::UserNameAndPassword> credentials;
+    {
+    UAuth::SQLite3Authenticator auth;
+    EXPECT_NO_THROW(auth.openUsersTable(usersTable, true));
+    for (int i = 0; i < nClients; ++i)
+    {
+        UAuth::Certificate::UserNameAndPassword plainText;
+        plainText.setUserName("user" + std::to_string(i));
+        plainText.setPassword("password" + std::to_string(i));
+        UAuth::User user;
+        user.setName(plainText.getUserName());
+        user.setEmail(plainText.getUserName() + "@domain.com");
+        user.setHashedPassword(plainText.getHashedPassword(
+            UAuth::Certificate::HashLevel::Interactive));
+        user.setPrivileges(UAuth::UserPrivileges::ReadOnly);
+        EXPECT_NO_THROW(auth.addUser(user));
+        credentials.push_back(plainText);
+    }
+    }
+    auto serialTime = timeWoodhouseHandshakes(usersTable, credentials, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    auto parallelTime = timeWoodhouseHandshakes(usersTable, credentials, 4);
+    std::cout << nClients << " PLAIN handshakes took " << serialTime
+              << " s with 1 ZAP worker and " << parallelTime
+              << " s with 4 ZAP workers" << std::endl;
+    std::remove(usersTable.c_str());
+}
+
 
 }
@@ -0,0 +1,119 @@
+#include <string>
+#include <chrono>
+#include <map>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "umps/logging/standardOut.hpp"
+#include "umps/messaging/xPublisherXSubscriber/proxy.hpp"
+#include "umps/messaging/xPublisherXSubscriber/proxyOptions.hpp"
+#include "umps/proxyBroadcasts/heartbeat/publisher.hpp"
+#include "umps/proxyBroadcasts/heartbeat/publisherOptions.hpp"
+#include "umps/proxyBroadcasts/heartbeat/publisherProcess.hpp"
+#include "umps/proxyBroadcasts/heartbeat/publisherProcessOptions.hpp"
+#include "umps/proxyBroadcasts/heartbeat/subscriber.hpp"
+#include "umps/proxyBroadcasts/heartbeat/subscriberOptions.hpp"
+#include "umps/proxyBroadcasts/heartbeat/status.hpp"
+#include <gtest/gtest.h>
+namespace
+{
+
+const std::string frontendAddress = "tcp://127.0.0.1:5572";
+const std::string backendAddress = "tcp://127.0.0.1:5573";
+namespace XPubXSub = UMPS::Messaging::XPublisherXSubscriber;
+namespace UHB = UMPS::ProxyBroadcasts::Heartbeat;
+
+TEST(BroadcastHeartbeat, PublisherProcessSendsLatestStatus)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    constexpr int nModules{2};
+    constexpr int nUpdates{20000};
+    XPubXSub::ProxyOptions proxyOptions;
+    proxyOptions.setFrontendAddress(frontendAddress);
+    proxyOptions.setBackendAddress(backendAddress);
+    XPubXSub::Proxy proxy(loggerPtr);
+    proxy.initialize(proxyOptions);
+    std::thread proxyThread(&XPubXSub::Proxy::start, &proxy);
+    std::this_thread::sleep_for(std::chrono::milliseconds {200});
+    // Collect everything published on the flooded modules.  Nothing may be
+    // dropped on the way so the high water marks are infinite.
+    std::map<std::string, std::vector<UHB::Status>> received;
+    UHB::SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(backendAddress);
+    subscriberOptions.setHighWaterMark(0);
+    subscriberOptions.setTimeOut(std::chrono::milliseconds {100});
+    UHB::Subscriber subscriber;
+    subscriber.initialize(subscriberOptions);
+    std::atomic<bool> keepReceiving{true};
+    std::thread subscriberThread([&]()
+    {
+        while (keepReceiving)
+        {
+            auto status = subscriber.receive();
+            if (status == nullptr){continue;}
+            if (status->getModule().starts_with("flood"))
+            {
+                received[status->getModule()].push_back(*status);
+            }
+        }
+    });
+    // The process only sends its own status once a minute
+    UHB::PublisherOptions publisherOptions;
+    publisherOptions.setAddress(frontendAddress);
+    publisherOptions.setHighWaterMark(0);
+    auto publisher = std::make_unique<UHB::Publisher> (loggerPtr);
+    publisher->initialize(publisherOptions);
+    UHB::PublisherProcessOptions processOptions;
+    processOptions.setName("floodTest");
+    processOptions.setInterval(std::chrono::seconds {60});
+    UHB::PublisherProcess process(loggerPtr);
+    process.initialize(processOptions, std::move(publisher));
+    process.start();
+    // Several modules flood the process through the public interface.  The
+    // time stamp is the update's sequence number.
+    std::vector<std::thread> producers;
+    for (int i = 0; i < nModules; ++i)
+    {
+        producers.push_back(std::thread([&process, i]()
+        {
+            UHB::Status status;
+            status.setModule("flood" + std::to_string(i));
+            status.setModuleStatus(UHB::ModuleStatus::Alive);
+            for (int j = 1; j <= nUpdates; ++j)
+            {
+                if (j == nUpdates)
+                {
+                    status.setModuleStatus(UHB::ModuleStatus::Disconnected);
+                }
+                status.setTimeStamp(std::chrono::microseconds {j});
+                process.sendStatus(status);
+            }
+        }));
+    }
+    for (auto &producer : producers){producer.join();}
+    std::this_thread::sleep_for(std::chrono::seconds {1});
+    process.stop();
+    keepReceiving = false;
+    subscriberThread.join();
+    proxy.stop();
+    proxyThread.join();
+    // Superseded statuses were never published and the newest status for
+    // each module always was
+    ASSERT_EQ(received.size(), static_cast<size_t> (nModules));
+    for (const auto &[module, statuses] : received)
+    {
+        ASSERT_FALSE(statuses.empty());
+        EXPECT_LT(statuses.size(), static_cast<size_t> (nUpdates)) << module;
+        for (size_t k = 1; k < statuses.size(); ++k)
+        {
+            EXPECT_TRUE(statuses[k] > statuses[k - 1]) << module;
+        }
+        EXPECT_EQ(statuses.back().getTimeStampInMicroSeconds(),
+                  std::chrono::microseconds {nUpdates});
+        EXPECT_EQ(statuses.back().getModuleStatus(),
+                  UHB::ModuleStatus::Disconnected);
+    }
+}
+
+}
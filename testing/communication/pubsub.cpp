@@ -10,8 +10,10 @@
 #include "umps/messaging/publisherSubscriber/subscriber.hpp"
 #include "umps/messaging/publisherSubscriber/subscriberOptions.hpp"
 #include "umps/messaging/context.hpp"
+#include "umps/messaging/messageView.hpp"
 #include "umps/messageFormats/messages.hpp"
 #include "umps/messageFormats/text.hpp"
+#include "umps/messageFormats/failure.hpp"
 #include "umps/messageFormats/staticUniquePointerCast.hpp"
 #include <gtest/gtest.h>
 namespace
@@ -19,6 +21,12 @@ namespace
 
 const std::string serverHost = "tcp://*:5555"; 
 const std::string localHost  = "tcp://127.0.0.1:5555";
+const std::string reuseServerHost = "tcp://*:5556";
+const std::string reuseLocalHost  = "tcp://127.0.0.1:5556";
+const std::string batchServerHost = "tcp://*:5557";
+const std::string batchLocalHost  = "tcp://127.0.0.1:5557";
+const std::string sequenceServerHost = "tcp://*:5568";
+const std::string sequenceLocalHost  = "tcp://127.0.0.1:5568";
 //const std::string localHost = "inproc://a"; //{"inproc://#1"};
 //const std::string localHost = "ipc://*";
 using namespace UMPS::Messaging::PublisherSubscriber;
@@ -194,4 +202,170 @@ auto context = std::make_shared<UMPS::Messaging::Context> (1);
 */
 }
 
+TEST(Messaging, PubSubReceiveIntoMessage)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    UMPS::MessageFormats::Messages messageTypes;
+    std::unique_ptr<UMPS::MessageFormats::IMessage> textMessageType
+        = std::make_unique<UMPS::MessageFormats::Text> ();
+    messageTypes.add(textMessageType);
+
+    SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(reuseLocalHost);
+    subscriberOptions.setMessageTypes(messageTypes);
+    subscriberOptions.setReceiveTimeOut(std::chrono::milliseconds {1000});
+    Subscriber subscriber(loggerPtr);
+    subscriber.initialize(subscriberOptions);
+    EXPECT_TRUE(subscriber.isInitialized());
+
+    PublisherOptions publisherOptions;
+    publisherOptions.setAddress(reuseServerHost);
+    Publisher publisher(loggerPtr);
+    publisher.initialize(publisherOptions);
+    EXPECT_TRUE(publisher.isInitialized());
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    const int nMessages{5};
+    for (int i = 0; i < nMessages; ++i)
+    {
+        UMPS::MessageFormats::Text text;
+        text.setContents("Message " + std::to_string(i));
+        publisher.send(text);
+    }
+    // Unpack into the same message
+    UMPS::MessageFormats::Text received;
+    for (int i = 0; i < nMessages - 1; ++i)
+    {
+        EXPECT_TRUE(subscriber.receive(&received));
+        EXPECT_EQ(received.getContents(), "Message " + std::to_string(i));
+    }
+    // Look at the frames directly
+    auto view = subscriber.receiveView();
+    EXPECT_FALSE(view.empty());
+    EXPECT_EQ(view.getMessageType(), received.getMessageType());
+    received.fromMessage(view.data(), view.size());
+    EXPECT_EQ(received.getContents(),
+              "Message " + std::to_string(nMessages - 1));
+    // Nothing left so this should time out
+    EXPECT_FALSE(subscriber.receive(&received));
+    EXPECT_TRUE(subscriber.receiveView().empty());
+    // Message types that were not subscribed to are rejected
+    UMPS::MessageFormats::Failure failure;
+    EXPECT_THROW(static_cast<void> (subscriber.receive(&failure)),
+                 std::invalid_argument);
+}
+
+TEST(Messaging, PubSubSendBatch)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    UMPS::MessageFormats::Messages messageTypes;
+    std::unique_ptr<UMPS::MessageFormats::IMessage> textMessageType
+        = std::make_unique<UMPS::MessageFormats::Text> ();
+    std::unique_ptr<UMPS::MessageFormats::IMessage> failureMessageType
+        = std::make_unique<UMPS::MessageFormats::Failure> ();
+    messageTypes.add(textMessageType);
+    messageTypes.add(failureMessageType);
+
+    SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(batchLocalHost);
+    subscriberOptions.setMessageTypes(messageTypes);
+    subscriberOptions.setReceiveTimeOut(std::chrono::milliseconds {1000});
+    Subscriber subscriber(loggerPtr);
+    subscriber.initialize(subscriberOptions);
+
+    PublisherOptions publisherOptions;
+    publisherOptions.setAddress(batchServerHost);
+    Publisher publisher(loggerPtr);
+    publisher.initialize(publisherOptions);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    // Interleave message types
+    const int nMessages{10};
+    std::vector<UMPS::MessageFormats::Text> texts(nMessages);
+    UMPS::MessageFormats::Failure failure;
+    failure.setDetails("Failure in batch");
+    std::vector<const UMPS::MessageFormats::IMessage *> batch;
+    for (int i = 0; i < nMessages; ++i)
+    {
+        texts[i].setContents("Batch message " + std::to_string(i));
+        batch.push_back(&texts[i]);
+        if (i == nMessages/2){batch.push_back(&failure);}
+    }
+    // A bad message means nothing is sent
+    std::vector<const UMPS::MessageFormats::IMessage *> badBatch{&texts[0],
+                                                                 nullptr};
+    EXPECT_THROW(publisher.sendBatch(badBatch), std::invalid_argument);
+    EXPECT_NO_THROW(publisher.sendBatch(batch));
+    for (const auto &expectedMessage : batch)
+    {
+        auto message = subscriber.receive();
+        ASSERT_TRUE(message != nullptr);
+        EXPECT_EQ(message->getMessageType(),
+                  expectedMessage->getMessageType());
+        EXPECT_EQ(message->toMessage(), expectedMessage->toMessage());
+    }
+    EXPECT_TRUE(subscriber.receiveView().empty());
+}
+
+TEST(Messaging, PubSubSequenceNumbers)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    UMPS::MessageFormats::Messages messageTypes;
+    std::unique_ptr<UMPS::MessageFormats::IMessage> textMessageType
+        = std::make_unique<UMPS::MessageFormats::Text> ();
+    messageTypes.add(textMessageType);
+
+    uint64_t nMissedInCallback{0};
+    SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(sequenceLocalHost);
+    subscriberOptions.setMessageTypes(messageTypes);
+    subscriberOptions.setReceiveTimeOut(std::chrono::milliseconds {1000});
+    subscriberOptions.setGapCallback(
+        [&nMissedInCallback](const uint64_t, const std::string_view,
+                             const uint64_t nMissed)
+        {
+            nMissedInCallback = nMissedInCallback + nMissed;
+        });
+    Subscriber subscriber(loggerPtr);
+    subscriber.initialize(subscriberOptions);
+
+    PublisherOptions publisherOptions;
+    publisherOptions.setAddress(sequenceServerHost);
+    publisherOptions.enableSequenceNumbers();
+    Publisher publisher(loggerPtr);
+    publisher.initialize(publisherOptions);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    // Single sends and batches share the numbering
+    const int nMessages{10};
+    std::vector<UMPS::MessageFormats::Text> texts(nMessages);
+    std::vector<const UMPS::MessageFormats::IMessage *> batch;
+    for (int i = 0; i < nMessages; ++i)
+    {
+        texts[i].setContents("Sequenced message " + std::to_string(i));
+        if (i < nMessages/2)
+        {
+            publisher.send(texts[i]);
+        }
+        else
+        {
+            batch.push_back(&texts[i]);
+        }
+    }
+    publisher.sendBatch(batch);
+    for (int i = 0; i < nMessages; ++i)
+    {
+        auto message = subscriber.receive();
+        ASSERT_TRUE(message != nullptr);
+        EXPECT_EQ(message->toMessage(), texts[i].toMessage());
+    }
+    EXPECT_EQ(subscriber.getNumberOfSequencedMessages(), nMessages);
+    EXPECT_EQ(subscriber.getNumberOfMissedMessages(), 0);
+    EXPECT_EQ(subscriber.getNumberOfGaps(), 0);
+    EXPECT_EQ(nMissedInCallback, 0);
+}
+
 }
@@ -2,6 +2,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <map>
+#include <vector>
 #include "umps/services/command/availableCommandsRequest.hpp"
 #include "umps/services/command/availableCommandsResponse.hpp"
 #include "umps/proxyServices/command/availableModulesResponse.hpp"
@@ -13,6 +15,8 @@
 #include "umps/proxyServices/command/replierOptions.hpp"
 #include "umps/services/command/terminateRequest.hpp"
 #include "umps/services/command/terminateResponse.hpp"
+#include "umps/services/command/commandRequest.hpp"
+#include "umps/services/command/commandResponse.hpp"
 #include "umps/proxyServices/command/moduleDetails.hpp"
 #include "umps/messaging/context.hpp"
 #include "umps/messageFormats/text.hpp"
@@ -22,6 +26,10 @@
 #define FRONTEND "tcp://127.0.0.1:5000"
 #define BACKEND  "tcp://127.0.0.1:5001"
 #define MODULE_NAME "TestModule"
+#define ORDERED_FRONTEND "tcp://127.0.0.1:5002"
+#define ORDERED_BACKEND  "tcp://127.0.0.1:5003"
+#define BUSY_FRONTEND "tcp://127.0.0.1:5004"
+#define BUSY_BACKEND  "tcp://127.0.0.1:5005"
 
 namespace
 {
@@ -46,6 +54,40 @@ public:
 };
 */
 
+/// A response that can't be serialized
+class UnserializableResponse : public UMPS::MessageFormats::IMessage
+{
+public:
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        clone() const final
+    {
+        return std::make_unique<UnserializableResponse> ();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createInstance() const noexcept final
+    {
+        return std::make_unique<UnserializableResponse> ();
+    }
+    [[nodiscard]] std::string toMessage() const final
+    {
+        throw std::runtime_error("Cannot serialize");
+    }
+    void fromMessage(const std::string &) final
+    {
+    }
+    void fromMessage(const char *, const size_t) final
+    {
+    }
+    [[nodiscard]] std::string getMessageType() const noexcept final
+    {
+        return "UnserializableResponse";
+    }
+    [[nodiscard]] std::string getMessageVersion() const noexcept final
+    {
+        return "1.0.0";
+    }
+};
+
 class ResponderProcess
 {
 public:
@@ -276,4 +318,225 @@ TEST(ProxyServicesCommand, Command)
     proxyThread.join();
 }
 
+TEST(ProxyServicesCommand, CommandOrderingWithInputOutputThreads)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    constexpr int nClients{3};
+    constexpr int nCommands{20};
+    const std::string moduleName{"ordered_module"};
+    // The proxy spreads its connections over several I/O threads
+    ProxyOptions proxyOptions;
+    proxyOptions.setFrontendAddress(ORDERED_FRONTEND);
+    proxyOptions.setBackendAddress(ORDERED_BACKEND);
+    proxyOptions.setNumberOfInputOutputThreads(4);
+    Proxy proxy(loggerPtr);
+    proxy.initialize(proxyOptions);
+    proxy.start();
+    // The module checks that each client's commands arrive in order.
+    // Commands are "client sequence".
+    std::mutex mutex;
+    std::map<int, int> lastSequence;
+    int nOutOfOrder{0};
+    int nReceived{0};
+    ModuleDetails details;
+    details.setName(moduleName);
+    ReplierOptions replierOptions;
+    replierOptions.setModuleDetails(details);
+    replierOptions.setAddress(ORDERED_BACKEND);
+    replierOptions.setCallback(
+        [&](const std::string &messageType, const void *data,
+            const size_t length)
+        -> std::unique_ptr<UMPS::MessageFormats::IMessage>
+        {
+            UMPS::Services::Command::CommandRequest request;
+            if (messageType != request.getMessageType())
+            {
+                auto text = std::make_unique<UMPS::MessageFormats::Text> ();
+                text->setContents("Unhandled");
+                return text;
+            }
+            request.fromMessage(static_cast<const char *> (data), length);
+            auto command = request.getCommand();
+            auto space = command.find(' ');
+            auto client = std::stoi(command.substr(0, space));
+            auto sequence = std::stoi(command.substr(space + 1));
+            {
+            std::scoped_lock lock(mutex);
+            auto idx = lastSequence.find(client);
+            auto expected = idx == lastSequence.end() ? 0 : idx->second + 1;
+            if (sequence != expected){nOutOfOrder = nOutOfOrder + 1;}
+            lastSequence[client] = sequence;
+            nReceived = nReceived + 1;
+            }
+            UMPS::Services::Command::CommandResponse response;
+            response.setResponse(command);
+            return response.clone();
+        });
+    Replier replier(loggerPtr);
+    replier.initialize(replierOptions);
+    replier.start();
+    // Let the module register
+    std::this_thread::sleep_for(std::chrono::milliseconds {500});
+
+    std::vector<int> nMatched(nClients, 0);
+    auto runClient = [&](const int client)
+    {
+        RequestorOptions requestorOptions;
+        requestorOptions.setAddress(ORDERED_FRONTEND);
+        Requestor requestor(loggerPtr);
+        requestor.initialize(requestorOptions);
+        for (int i = 0; i < nCommands; ++i)
+        {
+            UMPS::Services::Command::CommandRequest request;
+            request.setCommand(std::to_string(client) + " "
+                             + std::to_string(i));
+            auto response = requestor.issueCommand(moduleName, request);
+            if (response != nullptr &&
+                response->getResponse() == request.getCommand())
+            {
+                nMatched[client] = nMatched[client] + 1;
+            }
+        }
+    };
+    std::vector<std::thread> clients;
+    for (int client = 0; client < nClients; ++client)
+    {
+        clients.push_back(std::thread(runClient, client));
+    }
+    for (auto &client : clients){client.join();}
+    replier.stop();
+    proxy.stop();
+
+    for (int client = 0; client < nClients; ++client)
+    {
+        EXPECT_EQ(nMatched[client], nCommands);
+    }
+    EXPECT_EQ(nReceived, nClients*nCommands);
+    EXPECT_EQ(nOutOfOrder, 0);
+}
+
+TEST(ProxyServicesCommand, ReplierWorkers)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    const std::string moduleName{"busy_module"};
+    const std::chrono::milliseconds slowCommandDuration{1000};
+    // Modules that don't answer pings for 200 ms are evicted
+    ProxyOptions proxyOptions;
+    proxyOptions.setFrontendAddress(BUSY_FRONTEND);
+    proxyOptions.setBackendAddress(BUSY_BACKEND);
+    proxyOptions.setPingIntervals({std::chrono::milliseconds {50},
+                                   std::chrono::milliseconds {100}});
+    proxyOptions.setTimerResolution(std::chrono::milliseconds {10});
+    Proxy proxy(loggerPtr);
+    proxy.initialize(proxyOptions);
+    proxy.start();
+    // One worker and one request in flight
+    ModuleDetails details;
+    details.setName(moduleName);
+    ReplierOptions replierOptions;
+    replierOptions.setModuleDetails(details);
+    replierOptions.setAddress(BUSY_BACKEND);
+    replierOptions.setNumberOfWorkers(1);
+    replierOptions.setMaximumNumberOfRequestsInFlight(1);
+    replierOptions.setCallback(
+        [&](const std::string &messageType, const void *data,
+            const size_t length)
+        -> std::unique_ptr<UMPS::MessageFormats::IMessage>
+        {
+            UMPS::Services::Command::CommandRequest request;
+            if (messageType != request.getMessageType())
+            {
+                auto text = std::make_unique<UMPS::MessageFormats::Text> ();
+                text->setContents("Unhandled");
+                return text;
+            }
+            request.fromMessage(static_cast<const char *> (data), length);
+            auto command = request.getCommand();
+            if (command == "slow")
+            {
+                std::this_thread::sleep_for(slowCommandDuration);
+            }
+            else if (command == "unserializable")
+            {
+                return std::make_unique<UnserializableResponse> ();
+            }
+            UMPS::Services::Command::CommandResponse response;
+            response.setResponse(command);
+            return response.clone();
+        });
+    Replier replier(loggerPtr);
+    replier.initialize(replierOptions);
+    replier.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds {500});
+
+    auto makeRequestor = [&]()
+    {
+        RequestorOptions requestorOptions;
+        requestorOptions.setAddress(BUSY_FRONTEND);
+        requestorOptions.setReceiveTimeOut(std::chrono::seconds {5});
+        auto requestor = std::make_unique<Requestor> (loggerPtr);
+        requestor->initialize(requestorOptions);
+        return requestor;
+    };
+    auto issue = [](Requestor &requestor, const std::string &command)
+    {
+        UMPS::Services::Command::CommandRequest request;
+        request.setCommand(command);
+        return requestor.issueCommand("busy_module", request);
+    };
+    // Occupy the only worker
+    std::string slowResponse;
+    std::thread slowClient([&]()
+    {
+        auto requestor = makeRequestor();
+        auto response = issue(*requestor, "slow");
+        if (response){slowResponse = response->getResponse();}
+    });
+    std::this_thread::sleep_for(slowCommandDuration/4);
+    // The in-flight limit is hit so this is rejected immediately
+    auto requestor = makeRequestor();
+    std::string busyError;
+    try
+    {
+        static_cast<void> (issue(*requestor, "fast"));
+    }
+    catch (const std::exception &e)
+    {
+        busyError = e.what();
+    }
+    EXPECT_NE(busyError.find("busy"), std::string::npos) << busyError;
+    slowClient.join();
+    EXPECT_EQ(slowResponse, "slow");
+    // Pings were answered while the callback was busy so the module was
+    // not evicted
+    auto modules = requestor->getAvailableModules();
+    ASSERT_TRUE(modules != nullptr);
+    bool registered{false};
+    for (const auto &module : modules->getModules())
+    {
+        if (module.getName() == moduleName){registered = true;}
+    }
+    EXPECT_TRUE(registered);
+    auto fastResponse = issue(*requestor, "fast");
+    ASSERT_TRUE(fastResponse != nullptr);
+    EXPECT_EQ(fastResponse->getResponse(), "fast");
+    // A response that can't be serialized still gets a reply
+    std::string serializationError;
+    try
+    {
+        static_cast<void> (issue(*requestor, "unserializable"));
+    }
+    catch (const std::exception &e)
+    {
+        serializationError = e.what();
+    }
+    EXPECT_NE(serializationError.find("serialize"), std::string::npos)
+        << serializationError;
+
+    replier.stop();
+    proxy.stop();
+}
+
 }
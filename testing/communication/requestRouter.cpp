@@ -2,12 +2,15 @@
 #include <functional>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
 #include "umps/messaging/requestRouter/router.hpp"
 #include "umps/messaging/requestRouter/routerOptions.hpp"
 #include "umps/messaging/requestRouter/request.hpp"
 #include "umps/messaging/requestRouter/requestOptions.hpp"
-#include "umps/proxyServices/incrementer/incrementRequest.hpp"
-#include "umps/proxyServices/incrementer/incrementResponse.hpp"
+#include "umps/messageFormats/text.hpp"
+#include "umps/messageFormats/failure.hpp"
 #include "umps/logging/standardOut.hpp"
 #include "umps/messageFormats/staticUniquePointerCast.hpp"
 #include <gtest/gtest.h>
@@ -16,11 +19,14 @@ namespace
 
 namespace UMF = UMPS::MessageFormats;
 
-const std::string serverHost = "tcp://*:5555"; 
-const std::string localHost  = "tcp://127.0.0.1:5555";
+const std::string serverHost = "tcp://*:5571";
+const std::string localHost  = "tcp://127.0.0.1:5571";
+const std::string workersServerHost = "tcp://*:5570";
+const std::string workersLocalHost  = "tcp://127.0.0.1:5570";
 int nMessages = 10;
 int nThreads = 2;
 
+/// Echoes text requests
 class ProcessData
 {
 public:
@@ -28,67 +34,32 @@ public:
         process(const std::string &messageType,
                 const void *messageContents, const size_t length)
     {
-        UMPS::ProxyServices::Incrementer::IncrementRequest request;
-        auto response
-            = std::make_unique<UMPS::ProxyServices::Incrementer::IncrementResponse> ();
-        //std::cout << "Checking: " << messageType << " " << request.getMessageType() << std::endl;
-        if (messageType == request.getMessageType())
+        UMF::Text request;
+        if (messageType != request.getMessageType())
         {
-            request.fromMessage(
-                reinterpret_cast<const char *> (messageContents), length);
-            response->setIdentifier(request.getIdentifier());
-            //std::cout << "Unpacking: " << request.getIdentifier() << std::endl;
-            response->setValue(request.getIdentifier());
-            response->setReturnCode(
-                UMPS::ProxyServices::Incrementer::ReturnCode::SUCCESS);
-            nResponses = nResponses + 1;
-        }
-        else
-        {
-            response->setReturnCode(
-                UMPS::ProxyServices::Incrementer::ReturnCode::NO_ITEM);
+            throw std::invalid_argument("Unhandled message type: "
+                                      + messageType);
         }
+        request.fromMessage(
+            reinterpret_cast<const char *> (messageContents), length);
+        auto response = std::make_unique<UMF::Text> ();
+        response->setContents(request.getContents());
+        nResponses = nResponses + 1;
         return response;
-    } 
+    }
     int getNumberOfResponses() const
     {
         return nResponses;
     }
 private:
-    int nResponses = 0;
+    std::atomic<int> nResponses{0};
 };
 
-/*
-std::unique_ptr<UMPS::MessageFormats::IMessage>
-    process(const std::string &messageType,
-            const uint8_t *messageContents, const size_t length)
-{
-    UMPS::Services::Incrementer::Request request;
-    auto response = std::make_unique<UMPS::ProxyServices::Incrementer::Response> ();
-    std::cout << "Checking: " << messageType << " " << request.getMessageType() << std::endl;
-    if (messageType == request.getMessageType())
-    {
-        request.fromCBOR(messageContents, length);
-        response->setIdentifier(request.getIdentifier());
-        std::cout << "Unpacking: " << request.getIdentifier() << std::endl;
-        response->setValue(request.getIdentifier());
-        response->setReturnCode(
-            UMPS::ProxyServices::Incrementer::ReturnCode::SUCCESS);
-    }
-    else
-    {
-        response->setReturnCode(
-            UMPS::ProxyServices::Incrementer::ReturnCode::NO_ITEM);
-    }
-    return response; 
-}
-*/
-
 void server()
 {
     // Make a logger
     UMPS::Logging::StandardOut logger;
-    logger.setLevel(UMPS::Logging::Level::INFO); 
+    logger.setLevel(UMPS::Logging::Level::INFO);
     std::shared_ptr<UMPS::Logging::ILog> loggerPtr
         = std::make_shared<UMPS::Logging::StandardOut> (logger);
     ProcessData pStruct;
@@ -100,23 +71,8 @@ void server()
                               std::placeholders::_1,
                               std::placeholders::_2,
                               std::placeholders::_3));
-    std::unique_ptr<UMPS::MessageFormats::IMessage> messageSubscriptionType
-        = std::make_unique<UMPS::ProxyServices::Incrementer::IncrementRequest> ();
-    //routerOptions.addMessageFormat(messageSubscriptionType);
-
     UMPS::Messaging::RequestRouter::Router server(loggerPtr);
     server.initialize(routerOptions);
-/*
-    server.bind(serverHost);
-    server.setCallback(std::bind(&ProcessData::process,
-                                 &pStruct, //process,
-                                 std::placeholders::_1,
-                                 std::placeholders::_2,
-                                 std::placeholders::_3));
-    std::unique_ptr<UMPS::MessageFormats::IMessage> messageSubscriptionType
-        = std::make_unique<UMPS::ProxyServices::Incrementer::Request> ();
-    server.addMessageType(messageSubscriptionType);
-*/
     // Launch the server
     std::thread t1(&UMPS::Messaging::RequestRouter::Router::start,
                    &server);
@@ -142,39 +98,28 @@ void client(int base)
         = std::make_shared<UMPS::Logging::StandardOut> (logger);
 
     UMPS::Messaging::RequestRouter::RequestOptions requestOptions;
-    UMPS::ProxyServices::Incrementer::IncrementRequest request;
     std::unique_ptr<UMPS::MessageFormats::IMessage> responseType
-        = std::make_unique<UMPS::ProxyServices::Incrementer::IncrementResponse> (); 
+        = std::make_unique<UMF::Text> ();
     requestOptions.setAddress(localHost);
     requestOptions.addMessageFormat(responseType);
-/*
-    client.setResponse(responseType);
-*/
 
- 
     UMPS::Messaging::RequestRouter::Request client(loggerPtr);
     client.initialize(requestOptions);
-    
-    request.setItem("Test");
-    //client.connect(localHost);
     EXPECT_TRUE(client.isInitialized());
+    UMF::Text request;
     for (int i = 0; i < nMessages; ++i)
     {
-        request.setIdentifier(base + i);
+        request.setContents(std::to_string(base + i));
         auto message = client.request(request);
+        ASSERT_TRUE(message != nullptr);
         auto response
-        = UMF::static_unique_pointer_cast<UMPS::ProxyServices::Incrementer::IncrementResponse>
-          (std::move(message));
-        EXPECT_EQ(request.getIdentifier(), response->getIdentifier());
-        //std::cout << request.getIdentifier() << " " << response->getIdentifier() << std::endl;//Identifier() << std::endl;
+            = UMF::static_unique_pointer_cast<UMF::Text> (std::move(message));
+        EXPECT_EQ(request.getContents(), response->getContents());
     }
 }
 
 TEST(Messaging, RequestRouter)
 {
-    //std::shared_ptr<void *> context = std::make_shared<void *> (zmq_ctx_new()); //zmq::context_t context{1};    
-    UMPS::Logging::StandardOut logger;
-    logger.setLevel(UMPS::Logging::Level::DEBUG);
     auto serverThread  = std::thread(server);
     auto clientThread1 = std::thread(client, 100);
     auto clientThread2 = std::thread(client, 200);
@@ -184,4 +129,100 @@ TEST(Messaging, RequestRouter)
     clientThread2.join();
 }
 
+TEST(Messaging, RequestRouterWorkers)
+{
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> ();
+    constexpr int nWorkers{4};
+    const std::chrono::milliseconds processingTime{250};
+    // Each request takes a while so they must be processed concurrently
+    // to finish in time.  A request to fail makes the callback throw.
+    std::atomic<int> nActive{0};
+    std::atomic<int> maxActive{0};
+    UMPS::Messaging::RequestRouter::RouterOptions routerOptions;
+    routerOptions.setAddress(workersServerHost);
+    routerOptions.setNumberOfWorkers(nWorkers);
+    routerOptions.setCallback(
+        [&](const std::string &messageType, const void *contents,
+            const size_t length)
+        {
+            UMF::Text request;
+            if (messageType != request.getMessageType())
+            {
+                throw std::invalid_argument("Unhandled message type");
+            }
+            request.fromMessage(static_cast<const char *> (contents), length);
+            auto active = nActive.fetch_add(1) + 1;
+            auto previousMax = maxActive.load();
+            while (active > previousMax &&
+                   !maxActive.compare_exchange_weak(previousMax, active))
+            {
+            }
+            std::this_thread::sleep_for(processingTime);
+            nActive.fetch_sub(1);
+            if (request.getContents() == "fail")
+            {
+                throw std::runtime_error("Asked to fail");
+            }
+            std::unique_ptr<UMPS::MessageFormats::IMessage> response
+                = std::make_unique<UMF::Text> (request);
+            return response;
+        });
+    UMPS::Messaging::RequestRouter::Router server(loggerPtr);
+    server.initialize(routerOptions);
+    std::thread serverThread(&UMPS::Messaging::RequestRouter::Router::start,
+                             &server);
+    std::this_thread::sleep_for(std::chrono::milliseconds {100});
+
+    // Each reply must be routed back to the client that made the request
+    std::vector<std::string> requests{"1", "2", "3", "fail"};
+    std::vector<std::string> replies(requests.size());
+    auto runClient = [&](const size_t index)
+    {
+        UMPS::Messaging::RequestRouter::RequestOptions requestOptions;
+        std::unique_ptr<UMPS::MessageFormats::IMessage> textType
+            = std::make_unique<UMF::Text> ();
+        std::unique_ptr<UMPS::MessageFormats::IMessage> failureType
+            = std::make_unique<UMF::Failure> ();
+        requestOptions.setAddress(workersLocalHost);
+        requestOptions.addMessageFormat(textType);
+        requestOptions.addMessageFormat(failureType);
+        requestOptions.setTimeOut(std::chrono::seconds {5});
+        UMPS::Messaging::RequestRouter::Request client(loggerPtr);
+        client.initialize(requestOptions);
+        UMF::Text request;
+        request.setContents(requests.at(index));
+        auto message = client.request(request);
+        if (message == nullptr)
+        {
+            replies.at(index) = "timed out";
+        }
+        else if (message->getMessageType() == UMF::Failure {}.getMessageType())
+        {
+            replies.at(index) = "fail";
+        }
+        else
+        {
+            replies.at(index) = UMF::static_unique_pointer_cast<UMF::Text>
+                                (std::move(message))->getContents();
+        }
+    };
+    std::vector<std::thread> clients;
+    auto startTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        clients.push_back(std::thread(runClient, i));
+    }
+    for (auto &client : clients){client.join();}
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    server.stop();
+    serverThread.join();
+
+    // The callback's failure was returned to the right client
+    EXPECT_EQ(replies, requests);
+    // The requests were processed concurrently
+    EXPECT_GT(maxActive.load(), 1);
+    EXPECT_LT(duration, static_cast<int> (requests.size())*processingTime);
+}
+
 }
@@ -6,6 +6,7 @@
 #include "umps/logging/standardOut.hpp"
 #include "umps/messaging/routerDealer/proxy.hpp"
 #include "umps/messaging/routerDealer/proxyOptions.hpp"
+#include "umps/messaging/routerDealer/asynchronousRequest.hpp"
 #include "umps/messaging/routerDealer/request.hpp"
 #include "umps/messaging/routerDealer/requestOptions.hpp"
 #include "umps/messaging/routerDealer/reply.hpp"
@@ -119,6 +120,67 @@ void client(int id)
     }   
 }
 
+void asynchronousClient()
+{
+    UMPS::Logging::StandardOut logger;
+    logger.setLevel(UMPS::Logging::Level::Info);
+    std::shared_ptr<UMPS::Logging::ILog> loggerPtr
+        = std::make_shared<UMPS::Logging::StandardOut> (logger);
+    UMPS::MessageFormats::Text text;
+    RequestOptions options;
+    options.setAddress(frontendAddress);
+    auto messageType = text.createInstance();
+    UMPS::MessageFormats::Messages messageFormats;
+    messageFormats.add(messageType);
+    options.setMessageFormats(messageFormats);
+    options.setMaximumNumberOfOutstandingRequests(nMessages);
+    AsynchronousRequest client(loggerPtr);
+    EXPECT_NO_THROW(client.initialize(options));
+    EXPECT_TRUE(client.isInitialized());
+    // Deal with the slow joiner problem
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // Pipeline the requests with futures
+    std::vector<std::future<std::unique_ptr<UMF::IMessage>>> futures;
+    for (int i = 0; i < nMessages; ++i)
+    {
+        text.setContents(std::to_string(i) + " ");
+        futures.push_back(client.request(text));
+    }
+    // Pipeline the requests with callbacks
+    std::vector<std::promise<std::string>> callbackResponses(nMessages);
+    for (int i = 0; i < nMessages; ++i)
+    {
+        text.setContents(std::to_string(nMessages + i) + " ");
+        auto *promise = &callbackResponses[i];
+        client.request(text,
+                       [promise](std::unique_ptr<UMF::IMessage> &&message)
+                       {
+                           auto response
+                               = UMF::static_unique_pointer_cast
+                                 <UMPS::MessageFormats::Text>
+                                 (std::move(message));
+                           promise->set_value(response == nullptr ?
+                                              "" : response->getContents());
+                       });
+    }
+    // Responses must be matched to their requests
+    for (int i = 0; i < nMessages; ++i)
+    {
+        auto response
+            = UMF::static_unique_pointer_cast<UMPS::MessageFormats::Text>
+              (futures[i].get());
+        ASSERT_TRUE(response != nullptr);
+        EXPECT_EQ(response->getContents(), std::to_string(i) + "  handled");
+    }
+    for (int i = 0; i < nMessages; ++i)
+    {
+        EXPECT_EQ(callbackResponses[i].get_future().get(),
+                  std::to_string(nMessages + i) + "  handled");
+    }
+    EXPECT_EQ(client.getNumberOfOutstandingRequests(), 0);
+    client.disconnect();
+}
+
 void server()
 {
     // Make a logger
@@ -174,4 +236,18 @@ TEST(Messaging, RouterDealer)
     clientThread2.join();
 }
 
+TEST(Messaging, RouterDealerAsynchronousRequest)
+{
+    auto proxyThread = std::thread(proxy);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    auto serverThread = std::thread(server);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    // A single pipelined client makes as many requests (2*nMessages) as the
+    // nThreads = 2 blocking clients combined so the server knows when to stop
+    auto clientThread = std::thread(asynchronousClient);
+    proxyThread.join();
+    serverThread.join();
+    clientThread.join();
+}
+
 }
@@ -3,7 +3,10 @@
 #include <chrono>
 #include <vector>
 #include <thread>
+#include <tuple>
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
+#include <nlohmann/json.hpp>
 #include "umps/logging/standardOut.hpp"
 #include "umps/messaging/xPublisherXSubscriber/subscriber.hpp"
 #include "umps/messaging/xPublisherXSubscriber/subscriberOptions.hpp"
@@ -14,6 +17,7 @@
 #include "umps/authentication/zapOptions.hpp"
 #include "umps/messageFormats/messages.hpp"
 #include "umps/messageFormats/text.hpp"
+#include "umps/messageFormats/failure.hpp"
 #include "umps/messageFormats/staticUniquePointerCast.hpp"
 #include <gtest/gtest.h>
 namespace
@@ -164,4 +168,378 @@ TEST(Messaging, xPubxSubWithProxy)
     publisherThread.join();
 }
 
+// Faces internal network (pub) and external network (sub) for filtering
+const std::string filteringFrontendAddress = "tcp://127.0.0.1:5557";
+const std::string filteringBackendAddress = "tcp://127.0.0.1:5558";
+
+void filteringPublisher()
+{
+    XPubXSub::PublisherOptions options;
+    options.setAddress(filteringFrontendAddress);
+    XPubXSub::Publisher publisher;
+    EXPECT_NO_THROW(publisher.initialize(options));
+    // Deal with the slow joiner problem
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    UMPS::MessageFormats::Text text;
+    UMPS::MessageFormats::Failure failure;
+    for (int i = 0; i < 10; ++i)
+    {
+        text.setContents(std::to_string(idBase + i));
+        publisher.send(text);
+        failure.setDetails(std::to_string(idBase + i));
+        publisher.send(failure);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    publisher.disconnect();
+}
+
+void filteringSubscriber(std::unique_ptr<UMF::IMessage> messageType)
+{
+    UMF::Messages messageTypes;
+    auto expectedType = messageType->getMessageType();
+    messageTypes.add(messageType);
+    XPubXSub::SubscriberOptions options;
+    options.setAddress(filteringBackendAddress);
+    options.setMessageTypes(messageTypes);
+    options.setReceiveTimeOut(std::chrono::milliseconds {2000});
+    XPubXSub::Subscriber subscriber;
+    subscriber.initialize(options);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto message = subscriber.receive();
+        ASSERT_TRUE(message != nullptr);
+        EXPECT_EQ(message->getMessageType(), expectedType);
+        if (expectedType == UMF::Text().getMessageType())
+        {
+            auto text = UMF::static_unique_pointer_cast<UMF::Text>
+                        (std::move(message));
+            EXPECT_EQ(text->getContents(), std::to_string(idBase + i));
+        }
+        else
+        {
+            auto failure = UMF::static_unique_pointer_cast<UMF::Failure>
+                           (std::move(message));
+            EXPECT_EQ(failure->getDetails(), std::to_string(idBase + i));
+        }
+    }
+    subscriber.disconnect();
+}
+
+TEST(Messaging, xPubxSubWithTopicFilteringProxy)
+{
+    XPubXSub::ProxyOptions options;
+    options.setFrontendAddress(filteringFrontendAddress);
+    options.setBackendAddress(filteringBackendAddress);
+    options.enableTopicFiltering();
+    options.enableTopicStatistics();
+    XPubXSub::Proxy proxy;
+    proxy.initialize(options);
+    std::thread proxyThread(&XPubXSub::Proxy::start, &proxy);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    // Subscribers on disjoint topics.  Two want text and one wants failures.
+    auto textSubscriber1 = std::thread(filteringSubscriber,
+                                       std::make_unique<UMF::Text> ());
+    auto textSubscriber2 = std::thread(filteringSubscriber,
+                                       std::make_unique<UMF::Text> ());
+    auto failureSubscriber = std::thread(filteringSubscriber,
+                                         std::make_unique<UMF::Failure> ());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto publisherThread = std::thread(filteringPublisher);
+    publisherThread.join();
+    textSubscriber1.join();
+    textSubscriber2.join();
+    failureSubscriber.join();
+    // Each message type was forwarded once and seen by its subscribers
+    auto statistics = nlohmann::json::parse(proxy.getStatistics());
+    for (const auto &topic : statistics["Topics"])
+    {
+        auto name = topic["Topic"].get<std::string> ();
+        if (name == UMF::Text().getMessageType() ||
+            name == UMF::Failure().getMessageType())
+        {
+            EXPECT_EQ(topic["Messages"].get<uint64_t> (), 10);
+            EXPECT_EQ(topic["Drops"].get<uint64_t> (), 0);
+        }
+    }
+    proxy.stop();
+    proxyThread.join();
+}
+
+// A diamond of federated proxies with a loop back to the root:
+//   publisher -> A -> B, C -> D -> subscriber and D -> A
+const std::string federationRootFrontendAddress = "tcp://127.0.0.1:5560";
+const std::string federationRootBackendAddress = "tcp://127.0.0.1:5561";
+const std::string federationLeafBackendAddress = "tcp://127.0.0.1:5567";
+
+void federatedSubscriber(const std::string &address)
+{
+    UMF::Messages messageTypes;
+    std::unique_ptr<UMF::IMessage> textType = std::make_unique<UMF::Text> ();
+    messageTypes.add(textType);
+    XPubXSub::SubscriberOptions options;
+    options.setAddress(address);
+    options.setMessageTypes(messageTypes);
+    options.setReceiveTimeOut(std::chrono::milliseconds {2000});
+    XPubXSub::Subscriber subscriber;
+    subscriber.initialize(options);
+    // Each message arrives once even though there are two paths from A to D
+    // and a path from D back to A
+    std::vector<bool> received(10, false);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto message = subscriber.receive();
+        ASSERT_TRUE(message != nullptr);
+        auto text = UMF::static_unique_pointer_cast<UMF::Text>
+                    (std::move(message));
+        auto index = std::stoi(text->getContents()) - static_cast<int> (idBase);
+        ASSERT_TRUE(index >= 0 && index < 10);
+        EXPECT_FALSE(received[index]);
+        received[index] = true;
+    }
+    EXPECT_TRUE(subscriber.receive() == nullptr);
+    subscriber.disconnect();
+}
+
+void federatedPublisher()
+{
+    XPubXSub::PublisherOptions options;
+    options.setAddress(federationRootFrontendAddress);
+    XPubXSub::Publisher publisher;
+    EXPECT_NO_THROW(publisher.initialize(options));
+    // Deal with the slow joiner problem
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    UMPS::MessageFormats::Text text;
+    for (int i = 0; i < 10; ++i)
+    {
+        text.setContents(std::to_string(idBase + i));
+        publisher.send(text);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    publisher.disconnect();
+}
+
+TEST(Messaging, xPubxSubFederatedProxies)
+{
+    // Frontend, backend, and upstream proxies of A, B, C, and D
+    const std::vector<std::tuple<std::string, std::string,
+                                 std::vector<std::string>>> topology
+    {
+        {federationRootFrontendAddress, federationRootBackendAddress,
+         {federationLeafBackendAddress}},
+        {"tcp://127.0.0.1:5562", "tcp://127.0.0.1:5563",
+         {federationRootBackendAddress}},
+        {"tcp://127.0.0.1:5564", "tcp://127.0.0.1:5565",
+         {federationRootBackendAddress}},
+        {"tcp://127.0.0.1:5566", federationLeafBackendAddress,
+         {"tcp://127.0.0.1:5563", "tcp://127.0.0.1:5565"}}
+    };
+    std::vector<std::unique_ptr<XPubXSub::Proxy>> proxies;
+    std::vector<std::thread> proxyThreads;
+    for (const auto &[frontend, backend, upstreamProxies] : topology)
+    {
+        XPubXSub::ProxyOptions options;
+        options.setFrontendAddress(frontend);
+        options.setBackendAddress(backend);
+        options.enableFederation();
+        for (const auto &upstreamProxy : upstreamProxies)
+        {
+            options.addUpstreamProxy(upstreamProxy);
+        }
+        auto proxy = std::make_unique<XPubXSub::Proxy> ();
+        proxy->initialize(options);
+        proxyThreads.push_back(std::thread(&XPubXSub::Proxy::start,
+                                           &*proxy));
+        proxies.push_back(std::move(proxy));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    auto leafSubscriber = std::thread(federatedSubscriber,
+                                      federationLeafBackendAddress);
+    auto rootSubscriber = std::thread(federatedSubscriber,
+                                      federationRootBackendAddress);
+    // Let the subscriptions propagate through the proxies
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    auto publisherThread = std::thread(federatedPublisher);
+    publisherThread.join();
+    leafSubscriber.join();
+    rootSubscriber.join();
+    for (auto &proxy : proxies){proxy->stop();}
+    for (auto &proxyThread : proxyThreads){proxyThread.join();}
+}
+
+// Two federated proxies that are each other's upstream proxy:
+//   publisher -> A <-> B
+const std::string loopAFrontendAddress = "tcp://127.0.0.1:5577";
+const std::string loopABackendAddress = "tcp://127.0.0.1:5578";
+const std::string loopBFrontendAddress = "tcp://127.0.0.1:5579";
+const std::string loopBBackendAddress = "tcp://127.0.0.1:5580";
+
+TEST(Messaging, xPubxSubFederatedLoopUnsubscribes)
+{
+    const std::vector<std::tuple<std::string, std::string, std::string>>
+        topology
+    {
+        {loopAFrontendAddress, loopABackendAddress, loopBBackendAddress},
+        {loopBFrontendAddress, loopBBackendAddress, loopABackendAddress}
+    };
+    std::vector<std::unique_ptr<XPubXSub::Proxy>> proxies;
+    std::vector<std::thread> proxyThreads;
+    for (const auto &[frontend, backend, upstreamProxy] : topology)
+    {
+        XPubXSub::ProxyOptions options;
+        options.setFrontendAddress(frontend);
+        options.setBackendAddress(backend);
+        options.addUpstreamProxy(upstreamProxy);
+        auto proxy = std::make_unique<XPubXSub::Proxy> ();
+        // Upstream proxies only understand federated proxies
+        EXPECT_THROW(proxy->initialize(options), std::invalid_argument);
+        options.enableFederation();
+        proxy->initialize(options);
+        proxyThreads.push_back(std::thread(&XPubXSub::Proxy::start,
+                                           &*proxy));
+        proxies.push_back(std::move(proxy));
+    }
+    // The publisher is an xPub so it can see the subscriptions
+    zmq::context_t context{1};
+    zmq::socket_t publisher{context, zmq::socket_type::xpub};
+    publisher.set(zmq::sockopt::rcvtimeo, 2000);
+    publisher.set(zmq::sockopt::linger, 0);
+    publisher.connect(loopAFrontendAddress);
+    auto waitForSubscription = [&publisher](const std::string &expected)
+    {
+        zmq::message_t subscription;
+        while (publisher.recv(subscription))
+        {
+            if (subscription.to_string() == expected){return true;}
+        }
+        return false;
+    };
+    const std::string messageType{UMF::Text().getMessageType()};
+    // B subscribes to everything on A
+    EXPECT_TRUE(waitForSubscription(std::string {"\x01"}));
+    // A subscriber on A and on B
+    auto subscriberOptions = [](const std::string &address)
+    {
+        UMF::Messages messageTypes;
+        std::unique_ptr<UMF::IMessage> textType
+            = std::make_unique<UMF::Text> ();
+        messageTypes.add(textType);
+        XPubXSub::SubscriberOptions options;
+        options.setAddress(address);
+        options.setMessageTypes(messageTypes);
+        options.setReceiveTimeOut(std::chrono::milliseconds {2000});
+        return options;
+    };
+    XPubXSub::Subscriber subscriberA;
+    subscriberA.initialize(subscriberOptions(loopABackendAddress));
+    EXPECT_TRUE(waitForSubscription("\x01" + messageType));
+    XPubXSub::Subscriber subscriberB;
+    subscriberB.initialize(subscriberOptions(loopBBackendAddress));
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    // What is published on A reaches both subscribers once
+    UMF::Text text;
+    text.setContents(std::to_string(idBase));
+    zmq::multipart_t message;
+    message.addstr(messageType);
+    message.addstr(text.toMessage());
+    message.send(publisher);
+    for (auto *subscriber : {&subscriberA, &subscriberB})
+    {
+        auto received = subscriber->receive();
+        ASSERT_TRUE(received != nullptr);
+        auto receivedText = UMF::static_unique_pointer_cast<UMF::Text>
+                            (std::move(received));
+        EXPECT_EQ(receivedText->getContents(), std::to_string(idBase));
+        EXPECT_TRUE(subscriber->receive() == nullptr);
+    }
+    // The loop can't keep A's last subscriber's subscription alive
+    subscriberA.disconnect();
+    EXPECT_TRUE(waitForSubscription(std::string(1, '\0') + messageType));
+    subscriberB.disconnect();
+    publisher.close();
+    for (auto &proxy : proxies){proxy->stop();}
+    for (auto &proxyThread : proxyThreads){proxyThread.join();}
+}
+
+// The last-value cache is served from a separate snapshot address
+const std::string cacheFrontendAddress = "tcp://127.0.0.1:5574";
+const std::string cacheBackendAddress = "tcp://127.0.0.1:5575";
+const std::string cacheSnapshotAddress = "tcp://127.0.0.1:5576";
+
+XPubXSub::SubscriberOptions makeCacheSubscriberOptions()
+{
+    UMF::Messages messageTypes;
+    std::unique_ptr<UMF::IMessage> textType = std::make_unique<UMF::Text> ();
+    messageTypes.add(textType);
+    XPubXSub::SubscriberOptions options;
+    options.setAddress(cacheBackendAddress);
+    options.setMessageTypes(messageTypes);
+    options.setReceiveTimeOut(std::chrono::milliseconds {500});
+    return options;
+}
+
+TEST(Messaging, xPubxSubLastValueCacheSnapshot)
+{
+    XPubXSub::ProxyOptions options;
+    options.setFrontendAddress(cacheFrontendAddress);
+    options.setBackendAddress(cacheBackendAddress);
+    options.setLastValueCacheCapacity(16);
+    XPubXSub::Proxy proxy;
+    // The cache needs a snapshot address and every topic
+    EXPECT_THROW(proxy.initialize(options), std::invalid_argument);
+    options.setSnapshotAddress(cacheSnapshotAddress);
+    auto filteringOptions = options;
+    filteringOptions.enableTopicFiltering();
+    EXPECT_THROW(proxy.initialize(filteringOptions), std::invalid_argument);
+    proxy.initialize(options);
+    std::thread proxyThread(&XPubXSub::Proxy::start, &proxy);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    // This subscriber is there from the start
+    XPubXSub::Subscriber earlySubscriber;
+    earlySubscriber.initialize(makeCacheSubscriberOptions());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    XPubXSub::PublisherOptions publisherOptions;
+    publisherOptions.setAddress(cacheFrontendAddress);
+    XPubXSub::Publisher publisher;
+    publisher.initialize(publisherOptions);
+    // Deal with the slow joiner problem
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    for (int i = 0; i < 10; ++i)
+    {
+        UMF::Text text;
+        text.setContents(std::to_string(idBase + i));
+        publisher.send(text);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        auto message = earlySubscriber.receive();
+        ASSERT_TRUE(message != nullptr);
+        auto text = UMF::static_unique_pointer_cast<UMF::Text>
+                    (std::move(message));
+        EXPECT_EQ(text->getContents(), std::to_string(idBase + i));
+    }
+    // Late subscribers ask for the latest text
+    for (int k = 0; k < 2; ++k)
+    {
+        auto lateOptions = makeCacheSubscriberOptions();
+        lateOptions.setSnapshotAddress(cacheSnapshotAddress);
+        XPubXSub::Subscriber lateSubscriber;
+        lateSubscriber.initialize(lateOptions);
+        auto snapshot = lateSubscriber.requestSnapshot();
+        ASSERT_EQ(snapshot.size(), 1);
+        auto text = UMF::static_unique_pointer_cast<UMF::Text>
+                    (std::move(snapshot[0]));
+        EXPECT_EQ(text->getContents(), std::to_string(idBase + 9));
+        lateSubscriber.disconnect();
+    }
+    // Without a snapshot address the subscriber can't ask
+    EXPECT_THROW(earlySubscriber.requestSnapshot(), std::runtime_error);
+    // The existing subscriber never sees the snapshots
+    EXPECT_TRUE(earlySubscriber.receive() == nullptr);
+    earlySubscriber.disconnect();
+    publisher.disconnect();
+    proxy.stop();
+    proxyThread.join();
+}
+
 }
@@ -27,5 +27,21 @@ TEST(FailureTest, Failure)
     EXPECT_EQ(failureCopy.getDetails(), details); 
 }
 
+TEST(FailureTest, SerializeInto)
+{
+    Failure failure;
+    failure.setDetails("A reused buffer");
+    // Appends to whatever is in the buffer
+    const std::string prefix{"prefix"};
+    std::string buffer{prefix};
+    EXPECT_NO_THROW(failure.serializeInto(&buffer));
+    EXPECT_EQ(buffer, prefix + failure.toMessage());
+    EXPECT_THROW(failure.serializeInto(nullptr), std::invalid_argument);
+
+    Failure failureCopy;
+    failureCopy.fromMessage(buffer.data() + prefix.size(),
+                            buffer.size() - prefix.size());
+    EXPECT_EQ(failureCopy.getDetails(), "A reused buffer");
 }
 
+}
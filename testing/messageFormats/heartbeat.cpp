@@ -5,6 +5,7 @@
 #include <limits>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/host_name.hpp>
+#include <nlohmann/json.hpp>
 #include "umps/proxyBroadcasts/heartbeat/status.hpp"
 #include <gtest/gtest.h>
 namespace
@@ -79,4 +80,46 @@ TEST(HeartbeatTest, Status)
     EXPECT_FALSE(status > statusCopy);
 }
 
+TEST(HeartbeatTest, CBORWireFormat)
+{
+    Status status;
+    status.setModule("heartbeatTest");
+    status.setHostName("localhost");
+    status.setModuleStatus(ModuleStatus::Died);
+    status.setTimeStamp("2021-10-11T21:36:42.090");
+    // The streaming encoder must produce exactly what nlohmann produces
+    nlohmann::json obj;
+    obj["MessageType"] = MESSAGE_TYPE;
+    obj["MessageVersion"] = status.getMessageVersion();
+    obj["Module"] = "heartbeatTest";
+    obj["HostName"] = "localhost";
+    obj["ModuleStatus"] = static_cast<int> (ModuleStatus::Died);
+    obj["TimeStamp"] = "2021-10-11T21:36:42.090";
+    std::string reference;
+    nlohmann::json::to_cbor(obj, reference);
+    EXPECT_EQ(status.toMessage(), reference);
+    // and unpack messages produced by nlohmann
+    obj["Module"] = std::string(300, 'm');
+    auto cbor = nlohmann::json::to_cbor(obj);
+    Status statusCopy;
+    EXPECT_NO_THROW(statusCopy.fromCBOR(cbor.data(), cbor.size()));
+    EXPECT_EQ(statusCopy.getModule(),       std::string(300, 'm'));
+    EXPECT_EQ(statusCopy.getHostName(),     "localhost");
+    EXPECT_EQ(statusCopy.getTimeStamp(),    "2021-10-11T21:36:42.090");
+    EXPECT_EQ(statusCopy.getModuleStatus(), ModuleStatus::Died);
+    // Malformed messages are rejected and leave the status untouched
+    EXPECT_THROW(statusCopy.fromCBOR(cbor.data(), cbor.size() - 1),
+                 std::invalid_argument);
+    obj["TimeStamp"] = "not a time";
+    cbor = nlohmann::json::to_cbor(obj);
+    EXPECT_THROW(statusCopy.fromCBOR(cbor.data(), cbor.size()),
+                 std::invalid_argument);
+    EXPECT_EQ(statusCopy.getTimeStamp(),    "2021-10-11T21:36:42.090");
+    obj.erase("Module");
+    obj["TimeStamp"] = "2021-10-11T21:36:42.090";
+    cbor = nlohmann::json::to_cbor(obj);
+    EXPECT_THROW(statusCopy.fromCBOR(cbor.data(), cbor.size()),
+                 std::invalid_argument);
+}
+
 }
@@ -5,6 +5,7 @@
 #include <limits>
 #include "umps/messageFormats/messages.hpp"
 #include "umps/messageFormats/message.hpp"
+#include "private/messageFormats/messageTypeRegistry.hpp"
 #include <gtest/gtest.h>
 namespace
 {
@@ -149,4 +150,44 @@ TEST(Messages, Messages)
     EXPECT_EQ(messages.size(), 0);
 }
 
+TEST(Messages, MessageTypeRegistry)
+{
+    Messages messages;
+    std::unique_ptr<IMessage> m1p = std::make_unique<Message1> ();
+    std::unique_ptr<IMessage> m2p = std::make_unique<Message2> ();
+    std::unique_ptr<IMessage> m3p = std::make_unique<Message3> ();
+    messages.add(m1p);
+    messages.add(m2p);
+    messages.add(m3p);
+
+    MessageTypeRegistry registry(messages);
+    EXPECT_EQ(registry.size(), 3);
+    for (const auto &messageType : {"Message1", "Message2", "Message3"})
+    {
+        auto id = registry.find(std::string_view {messageType});
+        ASSERT_TRUE(id >= 0);
+        EXPECT_EQ(registry.getMessageType(id), messageType);
+        EXPECT_EQ(registry.createInstance(id)->getMessageType(), messageType);
+    }
+    EXPECT_EQ(registry.find(Message2 {}),
+              registry.find(std::string_view {"Message2"}));
+    EXPECT_FALSE(registry.contains("Message"));
+    EXPECT_FALSE(registry.contains("Message12"));
+    EXPECT_FALSE(MessageTypeRegistry {}.contains("Message1"));
+
+    // Released messages are reused
+    MessagePool pool;
+    pool.reset(registry);
+    auto id = registry.find(std::string_view {"Message3"});
+    auto message = pool.acquire(id);
+    auto address = message.get();
+    pool.release(std::move(message));
+    EXPECT_EQ(message, nullptr);
+    message = pool.acquire(id);
+    EXPECT_EQ(message.get(), address);
+    EXPECT_EQ(message->getMessageType(), "Message3");
+    message = pool.acquire(id);
+    EXPECT_NE(message.get(), address);
+}
+
 }
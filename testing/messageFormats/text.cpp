@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <nlohmann/json.hpp>
 #include "umps/messageFormats/text.hpp"
 #include <gtest/gtest.h>
 namespace
@@ -27,4 +28,59 @@ TEST(TextTest, Text)
     EXPECT_EQ(textCopy.getContents(), contents); 
 }
 
+TEST(TextTest, SerializeInto)
+{
+    Text text;
+    text.setContents("A reused buffer");
+    // Appends to whatever is in the buffer
+    const std::string prefix{"prefix"};
+    std::string buffer{prefix};
+    EXPECT_NO_THROW(text.serializeInto(&buffer));
+    EXPECT_EQ(buffer, prefix + text.toMessage());
+    EXPECT_THROW(text.serializeInto(nullptr), std::invalid_argument);
+
+    Text textCopy;
+    textCopy.fromMessage(buffer.data() + prefix.size(),
+                         buffer.size() - prefix.size());
+    EXPECT_EQ(textCopy.getContents(), "A reused buffer");
+}
+
+TEST(TextTest, CBORWireFormat)
+{
+    // Exercise the 1, 2, and 4 byte string length headers
+    for (const size_t length : {0, 23, 24, 255, 256, 65535, 65536})
+    {
+        Text text;
+        text.setContents(std::string(length, 'a'));
+        nlohmann::json obj;
+        obj["MessageType"] = MESSAGE_TYPE;
+        obj["MessageVersion"] = text.getMessageVersion();
+        obj["Contents"] = text.getContents();
+        auto reference = nlohmann::json::to_cbor(obj);
+        auto message = text.toMessage();
+        EXPECT_EQ(message, std::string(reference.begin(), reference.end()));
+        Text textCopy;
+        EXPECT_NO_THROW(textCopy.fromMessage(
+            reinterpret_cast<const char *> (reference.data()),
+            reference.size()));
+        EXPECT_EQ(textCopy.getContents(), text.getContents());
+    }
+    // Unknown keys are skipped
+    nlohmann::json obj;
+    obj["MessageType"] = MESSAGE_TYPE;
+    obj["Contents"] = "contents";
+    obj["Extra"] = {1, -2, 3.5, "four", nullptr, {{"five", true}}};
+    auto cbor = nlohmann::json::to_cbor(obj);
+    Text text;
+    EXPECT_NO_THROW(text.fromMessage(reinterpret_cast<const char *>
+                                     (cbor.data()), cbor.size()));
+    EXPECT_EQ(text.getContents(), "contents");
+    // Wrong message type
+    obj["MessageType"] = "UMPS::MessageFormats::Failure";
+    cbor = nlohmann::json::to_cbor(obj);
+    EXPECT_THROW(text.fromMessage(reinterpret_cast<const char *>
+                                  (cbor.data()), cbor.size()),
+                 std::invalid_argument);
+}
+
 }
@@ -28,30 +28,103 @@ TEST(Messaging, IAuthenticator)
 
 TEST(Messaging, isOkayIP)
 {
-    EXPECT_TRUE(isOkayIP("123.345.323.44"));
+    EXPECT_TRUE(isOkayIP("123.145.223.44"));
+    EXPECT_FALSE(isOkayIP("123.345.323.44"));
     EXPECT_FALSE(isOkayIP("*"));
     EXPECT_FALSE(isOkayIP("122.*.*.233"));
     EXPECT_FALSE(isOkayIP("*.121.233.233"));
+    EXPECT_TRUE(isOkayIP("*.*.*.*"));
     EXPECT_TRUE(isOkayIP("123.*"));
     EXPECT_TRUE(isOkayIP("123.34.*"));
     EXPECT_TRUE(isOkayIP("122.35.23.*"));
+    // Anything the trie accepts is okay
+    EXPECT_TRUE(isOkayIP("10.1.*.*"));
+    EXPECT_TRUE(isOkayIP("10.0.0.0/8"));
+    EXPECT_TRUE(isOkayIP("fe80::/10"));
 }
 
 TEST(Messaging, CheckIP)
 {
     std::set<std::string> ipAddresses;
     ipAddresses.insert("127.12.24.58");
-    EXPECT_TRUE(ipExists("127.12.24.58",  ipAddresses));
-    EXPECT_FALSE(ipExists("127.12.24.47", ipAddresses));
-
-    ipAddresses.insert("128.*");
-    EXPECT_TRUE(ipExists("128.488.832.12", ipAddresses));   
-
-    EXPECT_TRUE(ipExists("128.488.*", ipAddresses));
-    ipAddresses.insert("128.488.*");
-    EXPECT_TRUE(ipExists("128.489.832.12", ipAddresses));
+    IPAddressTrie trie(ipAddresses);
+    EXPECT_EQ(trie.size(), 1);
+    EXPECT_TRUE(trie.contains("127.12.24.58"));
+    EXPECT_FALSE(trie.contains("127.12.24.47"));
+
+    trie.insert("128.*");
+    EXPECT_TRUE(trie.contains("128.48.83.12"));
+    EXPECT_FALSE(trie.contains("129.48.83.12"));
+
+    EXPECT_TRUE(trie.contains("128.48.*"));
+    trie.insert("128.48.*");
+    EXPECT_TRUE(trie.contains("128.49.83.12"));
+
+    EXPECT_FALSE(trie.contains("44.88.85.84"));
+    // Can't parse
+    EXPECT_FALSE(trie.contains("128.488.832.12"));
+    EXPECT_FALSE(trie.contains("not an address"));
+    EXPECT_THROW(trie.insert("128.488.*"), std::invalid_argument);
+    EXPECT_THROW(trie.insert("122.*.*.233"), std::invalid_argument);
+    EXPECT_THROW(trie.insert("10.0.0.0/33"), std::invalid_argument);
+
+    // CIDR
+    trie.insert("10.0.0.0/8");
+    trie.insert("192.168.4.0/22");
+    EXPECT_TRUE(trie.contains("10.255.1.2"));
+    EXPECT_TRUE(trie.contains("10.2.0.0/16"));
+    EXPECT_FALSE(trie.contains("11.0.0.0"));
+    EXPECT_TRUE(trie.contains("192.168.7.255"));
+    EXPECT_FALSE(trie.contains("192.168.8.0"));
+    EXPECT_FALSE(trie.contains("192.168.0.0/16"));
+
+    // IPv6 and IPv4-mapped IPv6
+    EXPECT_FALSE(trie.contains("fe80::1"));
+    trie.insert("fe80::/10");
+    trie.insert("2001:db8::7");
+    EXPECT_TRUE(trie.contains("fe80::1"));
+    EXPECT_TRUE(trie.contains("febf:ffff::1"));
+    EXPECT_FALSE(trie.contains("fec0::1"));
+    EXPECT_TRUE(trie.contains("2001:db8::7"));
+    EXPECT_FALSE(trie.contains("2001:db8::8"));
+    EXPECT_TRUE(trie.contains("::ffff:10.1.2.3"));
+    EXPECT_FALSE(trie.contains("::ffff:11.1.2.3"));
+
+    // Everything
+    trie.insert("*.*.*.*");
+    EXPECT_TRUE(trie.contains("44.88.85.84"));
+    EXPECT_TRUE(trie.contains("::1"));
+}
 
-    EXPECT_FALSE(ipExists("44.883.85.848", ipAddresses));
+TEST(Messaging, SQLite3AuthenticatorBlacklist)
+{
+    SQLite3Authenticator authenticator;
+    EXPECT_EQ(authenticator.isBlacklisted("10.1.2.3").first,
+              IAuthenticator::okayStatus());
+    authenticator.addToBlacklist("10.0.0.0/8");
+    authenticator.addToBlacklist("172.16.*");
+    EXPECT_THROW(authenticator.addToBlacklist("10.0.0.0/40"),
+                 std::invalid_argument);
+    EXPECT_NE(authenticator.isBlacklisted("10.1.2.3").first,
+              IAuthenticator::okayStatus());
+    EXPECT_NE(authenticator.isBlacklisted("172.16.8.9").first,
+              IAuthenticator::okayStatus());
+    EXPECT_EQ(authenticator.isBlacklisted("172.17.8.9").first,
+              IAuthenticator::okayStatus());
+    EXPECT_THROW(authenticator.addToWhitelist("10.4.0.0/16"),
+                 std::invalid_argument);
+    authenticator.removeFromBlacklist("10.0.0.0/8");
+    EXPECT_EQ(authenticator.isBlacklisted("10.1.2.3").first,
+              IAuthenticator::okayStatus());
+    EXPECT_NO_THROW(authenticator.addToWhitelist("10.4.0.0/16"));
+    EXPECT_EQ(authenticator.isWhitelisted("10.4.1.1").first,
+              IAuthenticator::okayStatus());
+    // Whitelisted ranges can't be blacklisted either
+    EXPECT_THROW(authenticator.addToBlacklist("10.4.1.1"),
+                 std::invalid_argument);
+    EXPECT_THROW(authenticator.addToBlacklist("10.4.*.*"),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(authenticator.addToBlacklist("10.5.*.*"));
 }
 
 TEST(Messaging, CertificateUserNameAndPassword)
@@ -379,6 +452,37 @@ TEST(Messaging, SQLite3Authenticator)
         std::tie(status, reason) = auth.isValid(certificate);
         EXPECT_EQ(status, auth.okayStatus());
     }
+    // Verified credentials are cached but a wrong password is never valid
+    Certificate::UserNameAndPassword credentials;
+    credentials.setUserName("user0");
+    credentials.setPassword("password0");
+    Certificate::UserNameAndPassword wrongCredentials;
+    wrongCredentials.setUserName("user0");
+    wrongCredentials.setPassword("password1");
+    for (int i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(auth.isValid(credentials).first, auth.okayStatus());
+        EXPECT_NE(auth.isValid(wrongCredentials).first, auth.okayStatus());
+    }
+    // Changes made through another connection invalidate the cache
+    {
+    SQLite3Authenticator administrator;
+    EXPECT_NO_THROW(administrator.openUsersTable(usersTable, false));
+    Certificate::UserNameAndPassword newCredentials;
+    newCredentials.setUserName("user0");
+    newCredentials.setPassword("newPassword0");
+    auto user = users.at(0);
+    user.setHashedPassword(
+        newCredentials.getHashedPassword(Certificate::HashLevel::Interactive));
+    EXPECT_NO_THROW(administrator.updateUser(user));
+    EXPECT_NE(auth.isValid(credentials).first, auth.okayStatus());
+    EXPECT_EQ(auth.isValid(newCredentials).first, auth.okayStatus());
+    EXPECT_NO_THROW(administrator.deleteUser(users.at(1)));
+    Certificate::UserNameAndPassword deletedCredentials;
+    deletedCredentials.setUserName("user1");
+    deletedCredentials.setPassword("password1");
+    EXPECT_NE(auth.isValid(deletedCredentials).first, auth.okayStatus());
+    }
 
     std::remove(usersTable.c_str());
     std::remove(blacklistTable.c_str());
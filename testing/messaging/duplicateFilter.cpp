@@ -0,0 +1,78 @@
+#include <string>
+#include <string_view>
+#include "private/messaging/sequenceStamp.hpp"
+#include "private/messaging/duplicateFilter.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(Messaging, SequenceStamp)
+{
+    ::SequenceStamp stamp;
+    stamp.origin = 0x0123456789ABCDEF;
+    stamp.sequence = 0xFEDCBA9876543210;
+    auto frame = ::packSequenceStamp(stamp);
+    EXPECT_EQ(frame.size(), ::SEQUENCE_STAMP_SIZE);
+    ::SequenceStamp stampBack;
+    EXPECT_TRUE(::unpackSequenceStamp(std::string_view {frame.data(),
+                                                        frame.size()},
+                                      &stampBack));
+    EXPECT_EQ(stampBack.origin, stamp.origin);
+    EXPECT_EQ(stampBack.sequence, stamp.sequence);
+    // Payloads aren't mistaken for stamps
+    EXPECT_FALSE(::unpackSequenceStamp(std::string(::SEQUENCE_STAMP_SIZE, 'a'),
+                                       &stampBack));
+    EXPECT_FALSE(::unpackSequenceStamp(std::string_view {frame.data(),
+                                                         frame.size() - 1},
+                                       &stampBack));
+    // Messages are numbered per topic
+    ::SequenceCounter counter;
+    EXPECT_EQ(counter.next("text"), 1);
+    EXPECT_EQ(counter.next("text"), 2);
+    EXPECT_EQ(counter.next("failure"), 1);
+    EXPECT_EQ(counter.next("text"), 3);
+}
+
+TEST(Messaging, DuplicateFilter)
+{
+    const std::string text{"UMPS::MessageFormats::Text"};
+    const std::string failure{"UMPS::MessageFormats::Failure"};
+    ::DuplicateFilter filter;
+    ::SequenceStamp stamp{1, 1};
+    EXPECT_TRUE(filter.accept(text, stamp));
+    EXPECT_FALSE(filter.accept(text, stamp));
+    // Streams are per origin and topic
+    EXPECT_TRUE(filter.accept(failure, stamp));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {2, 1}));
+    EXPECT_EQ(filter.size(), 3);
+    // Out of order messages within the window are accepted once
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, 5}));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, 3}));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, 2}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, 3}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, 5}));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, 4}));
+    // Slide the window well past the old messages
+    auto latest = 5 + ::DuplicateFilter::WINDOW_SIZE;
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, latest}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, 5})); // Too old
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, 6}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, 6}));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, latest - 1}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, latest - 1}));
+    // A jump larger than the window forgets everything
+    latest = latest + 10*::DuplicateFilter::WINDOW_SIZE;
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, latest}));
+    EXPECT_TRUE(filter.accept(text, ::SequenceStamp {1, latest - 1}));
+    EXPECT_FALSE(filter.accept(text, ::SequenceStamp {1, latest}));
+    // The table is bounded
+    for (uint64_t origin = 0; origin < 2*::DuplicateFilter::MAX_STREAMS;
+         ++origin)
+    {
+        EXPECT_TRUE(filter.accept(text, ::SequenceStamp {100 + origin, 1}));
+    }
+    EXPECT_EQ(filter.size(), ::DuplicateFilter::MAX_STREAMS);
+}
+
+}
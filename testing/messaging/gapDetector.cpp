@@ -0,0 +1,86 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include "private/messaging/sequenceStamp.hpp"
+#include "private/messaging/gapDetector.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Gap
+{
+    uint64_t publisher{0};
+    std::string topic;
+    uint64_t nMissed{0};
+};
+
+TEST(Messaging, SequenceStamper)
+{
+    ::SequenceStamper stamper1;
+    ::SequenceStamper stamper2;
+    // Restarted publishers get a new identity
+    EXPECT_NE(stamper1.getOrigin(), stamper2.getOrigin());
+    auto stamp = stamper1.next("text");
+    EXPECT_EQ(stamp.origin, stamper1.getOrigin());
+    EXPECT_EQ(stamp.sequence, 1);
+    EXPECT_EQ(stamper1.next("text").sequence, 2);
+    EXPECT_EQ(stamper1.next("failure").sequence, 1);
+}
+
+TEST(Messaging, GapDetector)
+{
+    const std::string text{"UMPS::MessageFormats::Text"};
+    const std::string failure{"UMPS::MessageFormats::Failure"};
+    std::vector<Gap> gaps;
+    ::GapDetector detector;
+    detector.setCallback([&gaps](const uint64_t publisher,
+                                 const std::string_view topic,
+                                 const uint64_t nMissed)
+                         {
+                             gaps.push_back(Gap {publisher,
+                                                 std::string {topic},
+                                                 nMissed});
+                         });
+    // Joining a stream part way through isn't a gap
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 10}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 11}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 15}), 3);
+    ASSERT_EQ(gaps.size(), 1);
+    EXPECT_EQ(gaps[0].publisher, 1);
+    EXPECT_EQ(gaps[0].topic, text);
+    EXPECT_EQ(gaps[0].nMissed, 3);
+    // Streams are per publisher and topic
+    EXPECT_EQ(detector.update(failure, ::SequenceStamp {1, 1}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {2, 1}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {2, 2}), 0);
+    EXPECT_EQ(detector.update(failure, ::SequenceStamp {1, 3}), 1);
+    EXPECT_EQ(detector.size(), 3);
+    // Late and repeated messages don't change the counts
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 13}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 15}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 16}), 0);
+    EXPECT_EQ(gaps.size(), 2);
+    EXPECT_EQ(detector.getNumberOfSequencedMessages(), 10);
+    EXPECT_EQ(detector.getNumberOfMissedMessages(), 4);
+    EXPECT_EQ(detector.getNumberOfGaps(), 2);
+    // Clearing resets the streams and counts but keeps the callback
+    detector.clear();
+    EXPECT_EQ(detector.size(), 0);
+    EXPECT_EQ(detector.getNumberOfSequencedMessages(), 0);
+    EXPECT_EQ(detector.getNumberOfMissedMessages(), 0);
+    EXPECT_EQ(detector.getNumberOfGaps(), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 20}), 0);
+    EXPECT_EQ(detector.update(text, ::SequenceStamp {1, 22}), 1);
+    EXPECT_EQ(gaps.size(), 3);
+    // The table is bounded
+    for (uint64_t publisher = 0; publisher < 2*::GapDetector::MAX_STREAMS;
+         ++publisher)
+    {
+        EXPECT_EQ(detector.update(text,
+                                  ::SequenceStamp {100 + publisher, 1}), 0);
+    }
+    EXPECT_EQ(detector.size(), ::GapDetector::MAX_STREAMS);
+}
+
+}
@@ -0,0 +1,110 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include "private/messaging/lastValueCache.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::vector<std::vector<std::string>>
+    getCachedValues(const ::LastValueCache &cache,
+                    const std::string &subscription)
+{
+    std::vector<std::vector<std::string>> values;
+    cache.forEach(subscription,
+                  [&values](const std::vector<std::string> &frames)
+                  {
+                      values.push_back(frames);
+                  });
+    return values;
+}
+
+TEST(Messaging, LastValueCache)
+{
+    const std::string text{"UMPS::MessageFormats::Text"};
+    const std::string failure{"UMPS::MessageFormats::Failure"};
+    EXPECT_THROW(::LastValueCache(0, 1024), std::invalid_argument);
+    EXPECT_THROW(::LastValueCache(10, 0), std::invalid_argument);
+    ::LastValueCache cache(2, 1024);
+    EXPECT_EQ(cache.size(), 0);
+    // Only the most recent message on a topic is kept
+    cache.update({text, "first"});
+    cache.update({text, "second"});
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.getNumberOfBytes(), text.size() + 6);
+    auto values = getCachedValues(cache, text);
+    ASSERT_EQ(values.size(), 1);
+    ASSERT_EQ(values[0].size(), 2);
+    EXPECT_EQ(values[0][0], text);
+    EXPECT_EQ(values[0][1], "second");
+    // Subscriptions are prefixes
+    cache.update({failure, "oops"});
+    EXPECT_EQ(getCachedValues(cache, "").size(), 2);
+    EXPECT_EQ(getCachedValues(cache, "UMPS::MessageFormats::").size(), 2);
+    EXPECT_EQ(getCachedValues(cache, failure).size(), 1);
+    EXPECT_TRUE(getCachedValues(cache, "UMPS::ProxyBroadcasts").empty());
+    // The least recently updated topic is evicted first
+    cache.update({text, "third"});
+    cache.update({"UMPS::MessageFormats::Pick", "pick"});
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(getCachedValues(cache, failure).empty());
+    values = getCachedValues(cache, "");
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(values[0][1], "third");
+    EXPECT_EQ(values[1][1], "pick");
+}
+
+TEST(Messaging, LastValueCacheBytes)
+{
+    const std::string topic{"topic"};
+    ::LastValueCache cache(100, 32);
+    cache.update({topic + "1", std::string(10, 'a')});
+    cache.update({topic + "2", std::string(10, 'b')});
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.getNumberOfBytes(), 32);
+    // Exceeds the size so the oldest is evicted
+    cache.update({topic + "3", std::string(1, 'c')});
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.getNumberOfBytes(), 23);
+    EXPECT_TRUE(getCachedValues(cache, topic + "1").empty());
+    // A message that is too big isn't cached and the stale value is dropped
+    cache.update({topic + "2", std::string(64, 'd')});
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.getNumberOfBytes(), 7);
+    EXPECT_TRUE(getCachedValues(cache, topic + "2").empty());
+}
+
+TEST(Messaging, LastValueCacheKeyExtractor)
+{
+    const std::string topic{"UMPS::ProxyBroadcasts::Heartbeat::Status"};
+    // The key is the message up to the first colon
+    ::LastValueCache cache(10, 1024,
+        [](const std::string_view, const std::string_view message)
+        {
+            auto colon = message.find(':');
+            if (colon == std::string_view::npos)
+            {
+                throw std::invalid_argument("No key");
+            }
+            return std::string {message.substr(0, colon)};
+        });
+    cache.update({topic, "moduleA:alive"});
+    cache.update({topic, "moduleB:alive"});
+    cache.update({topic, "moduleA:disconnected"});
+    cache.update({topic, "garbage"});
+    cache.update({topic, "more garbage"});
+    EXPECT_EQ(cache.size(), 3);
+    auto values = getCachedValues(cache, topic);
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(values[0][1], "moduleB:alive");
+    EXPECT_EQ(values[1][1], "moduleA:disconnected");
+    EXPECT_EQ(values[2][1], "more garbage");
+    // Keys are scoped to the topic
+    cache.update({"other", "moduleA:alive"});
+    EXPECT_EQ(cache.size(), 4);
+    EXPECT_EQ(getCachedValues(cache, topic).size(), 3);
+}
+
+}
@@ -7,6 +7,7 @@
 #include "umps/messaging/publisherSubscriber/subscriberOptions.hpp"
 #include "umps/messaging/publisherSubscriber/publisherOptions.hpp"
 #include "umps/messaging/requestRouter/requestOptions.hpp"
+#include "umps/messaging/requestRouter/routerOptions.hpp"
 #include "umps/messaging/routerDealer/proxyOptions.hpp"
 #include "umps/messaging/routerDealer/requestOptions.hpp"
 #include "umps/messaging/routerDealer/replyOptions.hpp"
@@ -86,15 +87,19 @@ TEST(Messaging, PubSubPublisherOptions)
     EXPECT_NO_THROW(options.setAddress(address));
     EXPECT_NO_THROW(options.setSendHighWaterMark(highWaterMark));
     EXPECT_NO_THROW(options.setSendTimeOut(timeOut));
+    EXPECT_FALSE(options.sendSequenceNumbers());
+    options.enableSequenceNumbers();
 
     PublisherSubscriber::PublisherOptions optionsCopy(options);
 
     EXPECT_EQ(optionsCopy.getAddress(), address);
     EXPECT_EQ(optionsCopy.getSendHighWaterMark(), highWaterMark);
     EXPECT_EQ(optionsCopy.getSendTimeOut(), timeOut);
+    EXPECT_TRUE(optionsCopy.sendSequenceNumbers());
 
     options.clear();
     EXPECT_EQ(options.getSendHighWaterMark(), zero); 
+    EXPECT_FALSE(options.sendSequenceNumbers());
 }
 
 TEST(Messaging, PubSubSubscriberOptions)
@@ -115,6 +120,14 @@ TEST(Messaging, PubSubSubscriberOptions)
     EXPECT_NO_THROW(options.setMessageTypes(messageTypes));
     EXPECT_NO_THROW(options.setReceiveHighWaterMark(highWaterMark));
     EXPECT_NO_THROW(options.setReceiveTimeOut(timeOut));
+    EXPECT_FALSE(options.getGapCallback());
+    uint64_t nMissedBack{0};
+    options.setGapCallback(
+        [&nMissedBack](const uint64_t, const std::string_view,
+                       const uint64_t nMissed)
+        {
+            nMissedBack = nMissed;
+        });
 
     PublisherSubscriber::SubscriberOptions optionsCopy(options);
 
@@ -125,11 +138,16 @@ TEST(Messaging, PubSubSubscriberOptions)
     auto messagesBack = optionsCopy.getMessageTypes();
     EXPECT_TRUE(messagesBack.contains(textMessage));
     EXPECT_TRUE(messagesBack.contains(failureMessage));
+    auto gapCallback = optionsCopy.getGapCallback();
+    ASSERT_TRUE(gapCallback);
+    gapCallback(1, textMessage->getMessageType(), 3);
+    EXPECT_EQ(nMissedBack, 3);
 
     options.clear();
     EXPECT_EQ(options.getReceiveHighWaterMark(), zero); 
     EXPECT_EQ(options.getReceiveTimeOut(), std::chrono::milliseconds{-1});
     EXPECT_FALSE(options.haveMessageTypes());
+    EXPECT_FALSE(options.getGapCallback());
 }
 
 TEST(Messaging, XPubXSubProxyOptions)
@@ -145,9 +163,50 @@ TEST(Messaging, XPubXSubProxyOptions)
     options.setFrontendHighWaterMark(frontendHWM);
     options.setBackendAddress(backendAddress);
     options.setBackendHighWaterMark(backendHWM);
+    EXPECT_FALSE(options.collectTopicStatistics());
+    EXPECT_FALSE(options.backendNoDrop());
+    EXPECT_FALSE(options.filterTopics());
+    options.enableTopicStatistics();
+    options.enableBackendNoDrop();
+    options.enableTopicFiltering();
+    EXPECT_FALSE(options.haveLastValueCache());
+    EXPECT_THROW(options.setLastValueCacheCapacity(-1), std::invalid_argument);
+    EXPECT_THROW(options.setLastValueCacheMaximumBytes(0),
+                 std::invalid_argument);
+    options.setLastValueCacheCapacity(64);
+    options.setLastValueCacheMaximumBytes(1024);
+    EXPECT_FALSE(options.haveSnapshotAddress());
+    EXPECT_THROW(options.setSnapshotAddress(""), std::invalid_argument);
+    options.setSnapshotAddress("tcp://127.0.0.1:5557");
+    EXPECT_FALSE(options.isFederated());
+    EXPECT_THROW(options.addUpstreamProxy(""), std::invalid_argument);
+    options.enableFederation();
+    options.addUpstreamProxy("tcp://127.0.0.3:5556");
+    options.addUpstreamProxy("tcp://127.0.0.4:5556");
+    options.setLastValueCacheKeyExtractor(
+        [](const std::string_view, const std::string_view message)
+        {
+            return std::string {message.substr(0, 1)};
+        });
     //options.setName(name);
   
     XPublisherXSubscriber::ProxyOptions optionsCopy(options);
+    EXPECT_TRUE(optionsCopy.collectTopicStatistics());
+    EXPECT_TRUE(optionsCopy.backendNoDrop());
+    EXPECT_TRUE(optionsCopy.filterTopics());
+    EXPECT_TRUE(optionsCopy.haveLastValueCache());
+    EXPECT_EQ(optionsCopy.getLastValueCacheCapacity(), 64);
+    EXPECT_EQ(optionsCopy.getLastValueCacheMaximumBytes(), 1024);
+    auto keyExtractor = optionsCopy.getLastValueCacheKeyExtractor();
+    ASSERT_TRUE(keyExtractor);
+    EXPECT_EQ(keyExtractor("topic", "key"), "k");
+    EXPECT_TRUE(optionsCopy.haveSnapshotAddress());
+    EXPECT_EQ(optionsCopy.getSnapshotAddress(), "tcp://127.0.0.1:5557");
+    EXPECT_TRUE(optionsCopy.isFederated());
+    auto upstreamProxies = optionsCopy.getUpstreamProxies();
+    ASSERT_EQ(upstreamProxies.size(), 2);
+    EXPECT_EQ(upstreamProxies[0], "tcp://127.0.0.3:5556");
+    EXPECT_EQ(upstreamProxies[1], "tcp://127.0.0.4:5556");
 
     EXPECT_EQ(optionsCopy.getFrontendAddress(), frontendAddress);
     EXPECT_EQ(optionsCopy.getBackendAddress(), backendAddress);
@@ -158,6 +217,15 @@ TEST(Messaging, XPubXSubProxyOptions)
     options.clear();
     EXPECT_EQ(options.getFrontendHighWaterMark(), zero);
     EXPECT_EQ(options.getBackendHighWaterMark(), zero);
+    EXPECT_FALSE(options.collectTopicStatistics());
+    EXPECT_FALSE(options.backendNoDrop());
+    EXPECT_FALSE(options.filterTopics());
+    EXPECT_FALSE(options.haveLastValueCache());
+    EXPECT_EQ(options.getLastValueCacheMaximumBytes(), 16*1024*1024);
+    EXPECT_FALSE(options.getLastValueCacheKeyExtractor());
+    EXPECT_FALSE(options.haveSnapshotAddress());
+    EXPECT_FALSE(options.isFederated());
+    EXPECT_TRUE(options.getUpstreamProxies().empty());
 }
 
 TEST(Messaging, XPubXSubPublisherOptions)
@@ -171,16 +239,20 @@ TEST(Messaging, XPubXSubPublisherOptions)
     options.setAddress(address);
     options.setHighWaterMark(highWaterMark);
     options.setTimeOut(timeOut);
+    EXPECT_FALSE(options.sendSequenceNumbers());
+    options.enableSequenceNumbers();
   
     XPublisherXSubscriber::PublisherOptions optionsCopy(options);
 
     EXPECT_EQ(optionsCopy.getAddress(), address);
     EXPECT_EQ(optionsCopy.getHighWaterMark(), highWaterMark);
     EXPECT_EQ(optionsCopy.getTimeOut(), timeOut);
+    EXPECT_TRUE(optionsCopy.sendSequenceNumbers());
    
     options.clear();
     EXPECT_EQ(options.getHighWaterMark(), zero);
     EXPECT_EQ(options.getTimeOut(), negativeOne);
+    EXPECT_FALSE(options.sendSequenceNumbers());
 }
 
 TEST(Messaging, XPubXSubSubscriberOptions)
@@ -201,6 +273,17 @@ TEST(Messaging, XPubXSubSubscriberOptions)
     EXPECT_NO_THROW(options.setMessageTypes(messageTypes));
     EXPECT_NO_THROW(options.setReceiveHighWaterMark(highWaterMark));
     EXPECT_NO_THROW(options.setReceiveTimeOut(timeOut));
+    EXPECT_FALSE(options.getGapCallback());
+    uint64_t nMissedBack{0};
+    options.setGapCallback(
+        [&nMissedBack](const uint64_t, const std::string_view,
+                       const uint64_t nMissed)
+        {
+            nMissedBack = nMissed;
+        });
+    EXPECT_FALSE(options.haveSnapshotAddress());
+    EXPECT_THROW(options.setSnapshotAddress(""), std::invalid_argument);
+    options.setSnapshotAddress("tcp://127.0.0.1:5557");
 
     XPublisherXSubscriber::SubscriberOptions optionsCopy(options);
 
@@ -211,11 +294,18 @@ TEST(Messaging, XPubXSubSubscriberOptions)
     auto messagesBack = optionsCopy.getMessageTypes();
     EXPECT_TRUE(messagesBack.contains(textMessage));
     EXPECT_TRUE(messagesBack.contains(failureMessage));
+    auto gapCallback = optionsCopy.getGapCallback();
+    ASSERT_TRUE(gapCallback);
+    gapCallback(1, textMessage->getMessageType(), 3);
+    EXPECT_EQ(nMissedBack, 3);
+    EXPECT_EQ(optionsCopy.getSnapshotAddress(), "tcp://127.0.0.1:5557");
 
     options.clear();
     EXPECT_EQ(options.getReceiveHighWaterMark(), zero);
     EXPECT_EQ(options.getReceiveTimeOut(), std::chrono::milliseconds{-1});
     EXPECT_FALSE(options.haveMessageTypes());
+    EXPECT_FALSE(options.getGapCallback());
+    EXPECT_FALSE(options.haveSnapshotAddress());
 }
 
 TEST(Messaging, RequestRouterRequestOptions)
@@ -250,6 +340,27 @@ TEST(Messaging, RequestRouterRequestOptions)
     EXPECT_EQ(options.getTimeOut(), negativeOne);
 }
 
+TEST(Messaging, RequestRouterRouterOptions)
+{
+    RequestRouter::RouterOptions options;
+    const std::string address = "tcp://127.0.0.2:5556";
+    const int hwm = 120;
+    const int nWorkers = 4;
+    EXPECT_EQ(options.getNumberOfWorkers(), 1);
+    EXPECT_NO_THROW(options.setAddress(address));
+    EXPECT_NO_THROW(options.setHighWaterMark(hwm));
+    EXPECT_NO_THROW(options.setNumberOfWorkers(nWorkers));
+    EXPECT_THROW(options.setNumberOfWorkers(0), std::invalid_argument);
+
+    RequestRouter::RouterOptions optionsCopy(options);
+    EXPECT_EQ(optionsCopy.getAddress(), address);
+    EXPECT_EQ(optionsCopy.getHighWaterMark(), hwm);
+    EXPECT_EQ(optionsCopy.getNumberOfWorkers(), nWorkers);
+
+    options.clear();
+    EXPECT_EQ(options.getNumberOfWorkers(), 1);
+}
+
 TEST(Messaging, RouterDealerProxyOptions)
 {
     const std::string frontendAddress = "tcp://127.0.0.1:5555";
@@ -286,12 +397,17 @@ TEST(Messaging, RouterDealerRequestOptions)
     const std::string address = "tcp://127.0.0.2:5556";
     const std::chrono::milliseconds sendTimeOut{120};
     const std::chrono::milliseconds receiveTimeOut{150};
+    const int nOutstandingRequests{8};
     UAuth::ZAPOptions zapOptions;
     zapOptions.setStrawhouseClient();
     std::unique_ptr<UMPS::MessageFormats::IMessage> textMessage
         = std::make_unique<UMPS::MessageFormats::Text> (); 
     UMPS::MessageFormats::Messages messageFormats;
     messageFormats.add(textMessage);
+    EXPECT_THROW(options.setMaximumNumberOfOutstandingRequests(0),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(options.setMaximumNumberOfOutstandingRequests(
+                    nOutstandingRequests));
     EXPECT_NO_THROW(options.setSendHighWaterMark(sendhwm));
     EXPECT_NO_THROW(options.setReceiveHighWaterMark(rcvhwm));
     EXPECT_NO_THROW(options.setZAPOptions(zapOptions));
@@ -308,6 +424,8 @@ TEST(Messaging, RouterDealerRequestOptions)
     EXPECT_EQ(options.getAddress(), address);
     EXPECT_EQ(options.getSendTimeOut(), sendTimeOut);
     EXPECT_EQ(options.getReceiveTimeOut(), receiveTimeOut);
+    EXPECT_EQ(options.getMaximumNumberOfOutstandingRequests(),
+              nOutstandingRequests);
     EXPECT_TRUE(options.getMessageFormats().contains(textMessage));
 
     options.clear();
@@ -316,6 +434,7 @@ TEST(Messaging, RouterDealerRequestOptions)
     const std::chrono::milliseconds negativeOne{-1};
     EXPECT_EQ(options.getSendTimeOut(), std::chrono::milliseconds {0});
     EXPECT_EQ(options.getReceiveTimeOut(), negativeOne);
+    EXPECT_EQ(options.getMaximumNumberOfOutstandingRequests(), 32);
 }
 
 TEST(Messaging, RouterDealerReplyOptions)
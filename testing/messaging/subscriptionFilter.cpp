@@ -0,0 +1,68 @@
+#include <string>
+#include <vector>
+#include "private/messaging/subscriptionFilter.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::string subscribe(const std::string &topic)
+{
+    return std::string {"\1"} + topic;
+}
+
+std::string unsubscribe(const std::string &topic)
+{
+    return std::string {"\0", 1} + topic;
+}
+
+TEST(Messaging, SubscriptionFilter)
+{
+    const std::string text{"UMPS::MessageFormats::Text"};
+    const std::string failure{"UMPS::MessageFormats::Failure"};
+    const std::string status{"UMPS::ProxyBroadcasts::Heartbeat::Status"};
+    const std::string pick{"UMPS::MessageFormats::Pick"};
+    ::SubscriptionFilter filter;
+    // Nobody has subscribed so nothing is wanted
+    EXPECT_FALSE(filter.wants(text));
+    // Three subscribers on disjoint topics.  Two want text.
+    EXPECT_TRUE(filter.update(subscribe(text)));
+    EXPECT_FALSE(filter.update(subscribe(text)));
+    EXPECT_TRUE(filter.update(subscribe(failure)));
+    EXPECT_TRUE(filter.update(subscribe(status)));
+    EXPECT_EQ(filter.size(), 3);
+    EXPECT_EQ(filter.getNumberOfSubscribers(text), 2);
+    EXPECT_EQ(filter.getNumberOfSubscribers(failure), 1);
+    EXPECT_EQ(filter.getNumberOfSubscribers(pick), 0);
+    EXPECT_TRUE(filter.wants(text));
+    EXPECT_TRUE(filter.wants(text)); // Cached
+    EXPECT_TRUE(filter.wants(failure));
+    EXPECT_TRUE(filter.wants(status));
+    EXPECT_FALSE(filter.wants(pick));
+    EXPECT_FALSE(filter.wants("UMPS::MessageFormats::Tex"));
+    // Topics that extend a subscription match as with ZeroMQ's prefixes
+    EXPECT_TRUE(filter.wants(text + "Extended"));
+    // Only the last unsubscriber is forwarded
+    EXPECT_FALSE(filter.update(unsubscribe(text)));
+    EXPECT_TRUE(filter.wants(text));
+    EXPECT_TRUE(filter.update(unsubscribe(text)));
+    EXPECT_FALSE(filter.wants(text));
+    // Spurious unsubscribes aren't forwarded
+    EXPECT_FALSE(filter.update(unsubscribe(text)));
+    EXPECT_FALSE(filter.update(unsubscribe(pick)));
+    EXPECT_EQ(filter.size(), 2);
+    // Non-subscription messages pass through untouched
+    EXPECT_TRUE(filter.update("not a subscription"));
+    EXPECT_TRUE(filter.update(""));
+    // A subscriber to everything wants everything
+    EXPECT_TRUE(filter.update(subscribe("")));
+    EXPECT_TRUE(filter.wants(pick));
+    EXPECT_TRUE(filter.update(unsubscribe("")));
+    EXPECT_FALSE(filter.wants(pick));
+    EXPECT_TRUE(filter.update(unsubscribe(failure)));
+    EXPECT_TRUE(filter.update(unsubscribe(status)));
+    EXPECT_EQ(filter.size(), 0);
+    EXPECT_FALSE(filter.wants(status));
+}
+
+}
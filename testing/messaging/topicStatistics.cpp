@@ -0,0 +1,65 @@
+#include <string>
+#include <nlohmann/json.hpp>
+#include "private/messaging/topicStatistics.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(Messaging, TopicStatistics)
+{
+    ::TopicStatistics statistics;
+    const std::string pick{"UMPS::MessageFormats::Pick"};
+    const std::string status{"UMPS::ProxyBroadcasts::Heartbeat::Status"};
+    for (int i = 0; i < 10; ++i)
+    {
+        statistics.addMessage(pick, 100);
+    }
+    statistics.addMessage(status, 40);
+    statistics.addDrop(pick);
+    statistics.addMessage(pick, 100);
+    // Subscribe, subscribe, unsubscribe
+    EXPECT_TRUE(statistics.addSubscription(std::string {"\1"} + pick));
+    EXPECT_TRUE(statistics.addSubscription(std::string {"\1"} + pick));
+    EXPECT_TRUE(statistics.addSubscription(std::string {"\1"} + status));
+    EXPECT_TRUE(statistics.addSubscription(std::string {"\0", 1} + status));
+    // An extra unsubscribe doesn't underflow
+    EXPECT_TRUE(statistics.addSubscription(std::string {"\0", 1} + status));
+    EXPECT_FALSE(statistics.addSubscription("not a subscription"));
+    EXPECT_FALSE(statistics.addSubscription(""));
+    EXPECT_EQ(statistics.size(), 2);
+
+    auto obj = statistics.toJSONObject();
+    ASSERT_EQ(obj["Topics"].size(), 2);
+    // Sorted by topic
+    auto pickObj = obj["Topics"][0];
+    EXPECT_EQ(pickObj["Topic"].get<std::string> (), pick);
+    EXPECT_EQ(pickObj["Messages"].get<uint64_t> (), 11);
+    EXPECT_EQ(pickObj["Bytes"].get<uint64_t> (), 1100);
+    EXPECT_EQ(pickObj["Drops"].get<uint64_t> (), 1);
+    EXPECT_EQ(pickObj["Subscribers"].get<uint64_t> (), 2);
+    auto statusObj = obj["Topics"][1];
+    EXPECT_EQ(statusObj["Topic"].get<std::string> (), status);
+    EXPECT_EQ(statusObj["Messages"].get<uint64_t> (), 1);
+    EXPECT_EQ(statusObj["Bytes"].get<uint64_t> (), 40);
+    EXPECT_EQ(statusObj["Drops"].get<uint64_t> (), 0);
+    EXPECT_EQ(statusObj["Subscribers"].get<uint64_t> (), 0);
+
+    // The number of topics is bounded
+    statistics.clear();
+    EXPECT_EQ(statistics.size(), 0);
+    for (size_t i = 0; i < 2*::TopicStatistics::MAX_TOPICS; ++i)
+    {
+        statistics.addMessage("topic" + std::to_string(i), 1);
+    }
+    EXPECT_EQ(statistics.size(), ::TopicStatistics::MAX_TOPICS + 1);
+    obj = statistics.toJSONObject();
+    uint64_t nMessages{0};
+    for (const auto &topic : obj["Topics"])
+    {
+        nMessages = nMessages + topic["Messages"].get<uint64_t> ();
+    }
+    EXPECT_EQ(nMessages, 2*::TopicStatistics::MAX_TOPICS);
+}
+
+}
@@ -1,6 +1,7 @@
 #include <string>
 #include <filesystem>
 #include <chrono>
+#include <nlohmann/json.hpp>
 #include "umps/services/command/moduleDetails.hpp"
 #include "umps/services/command/requestorOptions.hpp"
 #include "umps/services/command/availableCommandsRequest.hpp"
@@ -21,6 +22,7 @@
 #include "umps/messaging/requestRouter/requestOptions.hpp"
 #include "umps/messaging/routerDealer/replyOptions.hpp"
 #include "umps/authentication/zapOptions.hpp"
+#include "private/proxyServices/command/modulesMap.hpp"
 #include <gtest/gtest.h>
 
 namespace
@@ -102,6 +104,14 @@ TEST(Command, ProxyOptions)
     options.setFrontendHighWaterMark(frontendHWM);
     options.setBackendHighWaterMark(backendHWM);
     options.setZAPOptions(zapOptions);
+    EXPECT_EQ(options.getTimerResolution(), std::chrono::milliseconds {100});
+    EXPECT_THROW(options.setTimerResolution(std::chrono::milliseconds {0}),
+                 std::invalid_argument);
+    options.setTimerResolution(std::chrono::milliseconds {25});
+    EXPECT_EQ(options.getNumberOfInputOutputThreads(), 1);
+    EXPECT_THROW(options.setNumberOfInputOutputThreads(0),
+                 std::invalid_argument);
+    options.setNumberOfInputOutputThreads(4);
 
     ProxyOptions cOptions(options);
     EXPECT_EQ(cOptions.getFrontendAddress(), frontend);
@@ -109,6 +119,8 @@ TEST(Command, ProxyOptions)
     EXPECT_EQ(cOptions.getFrontendHighWaterMark(), frontendHWM);
     EXPECT_EQ(cOptions.getBackendHighWaterMark(), backendHWM);
     EXPECT_EQ(cOptions.getPingIntervals(), pingIntervalsSorted);
+    EXPECT_EQ(cOptions.getTimerResolution(), std::chrono::milliseconds {25});
+    EXPECT_EQ(cOptions.getNumberOfInputOutputThreads(), 4);
 }
 
 TEST(Command, ModuleDetails)
@@ -200,6 +212,16 @@ These are the options:
     EXPECT_NO_THROW(rCopy.fromMessage(response.toMessage()));
     EXPECT_EQ(response.getCommands(), commands);
 
+    // Older messages may have null commands
+    nlohmann::json obj;
+    obj["MessageType"] = response.getMessageType();
+    obj["MessageVersion"] = response.getMessageVersion();
+    obj["Commands"] = nullptr;
+    auto v = nlohmann::json::to_cbor(obj);
+    AvailableCommandsResponse nullCommands;
+    EXPECT_NO_THROW(nullCommands.fromMessage(std::string(v.begin(), v.end())));
+    EXPECT_TRUE(nullCommands.getCommands().empty());
+
     response.clear();
     EXPECT_EQ(response.getMessageType(),
               "UMPS::Services::Command::AvailableCommandsResponse");
@@ -326,6 +348,157 @@ TEST(ProxyCommand, ModuleDetails)
     EXPECT_EQ(details.getParentProcessIdentifier(), ppid);
 }
 
+TEST(ProxyCommand, ModulesMap)
+{
+    const std::vector<std::chrono::milliseconds> pingIntervals{
+        std::chrono::milliseconds {1000}};
+    ::ModulesMap modulesMap;
+    UMPS::ProxyServices::Command::ModuleDetails details;
+    details.setName("TestModule");
+    details.setInstance(2);
+    auto otherInstance = details;
+    otherInstance.setInstance(3);
+    auto otherName = details;
+    otherName.setName("OtherModule");
+    EXPECT_NO_THROW(modulesMap.insert(
+        std::pair{"worker1", ::Module(details, pingIntervals)}));
+    EXPECT_NO_THROW(modulesMap.insert(
+        std::pair{"worker2", ::Module(otherInstance, pingIntervals)}));
+    EXPECT_NO_THROW(modulesMap.insert(
+        std::pair{"worker3", ::Module(otherName, pingIntervals)}));
+    // Worker and module must be unique
+    EXPECT_THROW(modulesMap.insert(
+        std::pair{"worker1", ::Module(details, pingIntervals)}),
+        std::invalid_argument);
+    EXPECT_THROW(modulesMap.insert(
+        std::pair{"worker4", ::Module(details, pingIntervals)}),
+        std::invalid_argument);
+    EXPECT_EQ(modulesMap.size(), 3);
+    EXPECT_TRUE(modulesMap.contains(details));
+    EXPECT_FALSE(modulesMap.contains(std::string {"worker4"}));
+    EXPECT_EQ(modulesMap.getAddress("TestModule", 2), "worker1");
+    EXPECT_EQ(modulesMap.getAddress("TestModule", 3), "worker2");
+    EXPECT_EQ(modulesMap.getAddress("OtherModule", 2), "worker3");
+    EXPECT_TRUE(modulesMap.getAddress("OtherModule", 3).empty());
+    // Snapshots are shared until the modules change
+    auto snapshot = modulesMap.getSnapshot();
+    EXPECT_EQ(snapshot, modulesMap.getSnapshot());
+    EXPECT_EQ(snapshot->modules.size(), 3);
+    // Erasing the worker must remove it from the index
+    modulesMap.erase("worker1");
+    EXPECT_NE(snapshot, modulesMap.getSnapshot());
+    EXPECT_EQ(snapshot->addressByModule.size(), 3);
+    EXPECT_FALSE(modulesMap.contains(details));
+    EXPECT_TRUE(modulesMap.getAddress("TestModule", 2).empty());
+    EXPECT_EQ(modulesMap.size(), 2);
+    // Now the module can register from another worker
+    EXPECT_NO_THROW(modulesMap.insert(
+        std::pair{"worker4", ::Module(details, pingIntervals)}));
+    EXPECT_EQ(modulesMap.getAddress("TestModule", 2), "worker4");
+    EXPECT_EQ(modulesMap.toVector().size(), 3);
+}
+
+TEST(ProxyCommand, ModulesMapVersions)
+{
+    const std::vector<std::chrono::milliseconds> pingIntervals{
+        std::chrono::milliseconds {1000}};
+    ::ModulesMap modulesMap;
+    UMPS::ProxyServices::Command::ModuleDetails details;
+    details.setName("TestModule");
+    auto otherModule = details;
+    otherModule.setName("OtherModule");
+    auto newModule = details;
+    newModule.setName("NewModule");
+    modulesMap.insert(std::pair{"worker1", ::Module(details, pingIntervals)});
+    modulesMap.insert(std::pair{"worker2",
+                                ::Module(otherModule, pingIntervals)});
+    auto version = modulesMap.getVersion();
+    EXPECT_EQ(modulesMap.getSnapshot()->version, version);
+    std::vector<UMPS::ProxyServices::Command::ModuleDetails> added;
+    std::vector<UMPS::ProxyServices::Command::ModuleDetails> removed;
+    uint64_t currentVersion{0};
+    EXPECT_TRUE(modulesMap.getChangesSince(version, &added, &removed,
+                                           &currentVersion));
+    EXPECT_TRUE(added.empty());
+    EXPECT_TRUE(removed.empty());
+    EXPECT_EQ(currentVersion, version);
+    // Re-registering from a new worker is a removal and an addition.
+    // A module that comes and goes is not reported.
+    modulesMap.erase("worker1");
+    modulesMap.insert(std::pair{"worker3", ::Module(details, pingIntervals)});
+    modulesMap.insert(std::pair{"worker4", ::Module(newModule, pingIntervals)});
+    modulesMap.erase("worker4");
+    modulesMap.erase("worker2");
+    EXPECT_EQ(modulesMap.getVersion(), version + 5);
+    EXPECT_TRUE(modulesMap.getChangesSince(version, &added, &removed,
+                                           &currentVersion));
+    EXPECT_EQ(currentVersion, version + 5);
+    ASSERT_EQ(added.size(), 1);
+    EXPECT_EQ(added.at(0).getName(), "TestModule");
+    ASSERT_EQ(removed.size(), 2);
+    EXPECT_EQ(removed.at(0).getName() == "TestModule" ?
+              removed.at(1).getName() : removed.at(0).getName(),
+              "OtherModule");
+    // Unknown versions need the full list
+    EXPECT_FALSE(modulesMap.getChangesSince(version + 6, &added, &removed,
+                                            &currentVersion));
+    EXPECT_FALSE(modulesMap.getChangesSince(1, &added, &removed,
+                                            &currentVersion));
+}
+
+TEST(ProxyCommand, ModulesMapDeadlines)
+{
+    using namespace std::chrono_literals;
+    const std::vector<std::chrono::milliseconds> pingIntervals{10ms, 20ms};
+    ::ModulesMap modulesMap;
+    UMPS::ProxyServices::Command::ModuleDetails details;
+    details.setName("TestModule");
+    ::Module module(details, pingIntervals, 30ms);
+    auto t0 = module.mLastResponse;
+    auto otherModule = module;
+    otherModule.mDetails.setName("OtherModule");
+    otherModule.mLastResponse = t0 + 1000ms;
+    modulesMap.insert(std::pair{"worker1", module});
+    modulesMap.insert(std::pair{"worker2", otherModule});
+
+    std::vector<std::string> pings;
+    std::vector<std::pair<std::string,
+                          UMPS::ProxyServices::Command::ModuleDetails>> expired;
+    modulesMap.processDeadlines(t0 + 5ms, &pings, &expired);
+    EXPECT_TRUE(pings.empty());
+    EXPECT_TRUE(expired.empty());
+    // First ping
+    modulesMap.processDeadlines(t0 + 10ms, &pings, &expired);
+    ASSERT_EQ(pings.size(), 1);
+    EXPECT_EQ(pings[0], "worker1");
+    // Don't ping again until the next interval
+    pings.clear();
+    modulesMap.processDeadlines(t0 + 15ms, &pings, &expired);
+    EXPECT_TRUE(pings.empty());
+    modulesMap.processDeadlines(t0 + 25ms, &pings, &expired);
+    EXPECT_EQ(pings.size(), 1);
+    EXPECT_TRUE(expired.empty());
+    // Time out
+    pings.clear();
+    modulesMap.processDeadlines(t0 + 30ms, &pings, &expired);
+    EXPECT_TRUE(pings.empty());
+    ASSERT_EQ(expired.size(), 1);
+    EXPECT_EQ(expired[0].first, "worker1");
+    EXPECT_EQ(expired[0].second.getName(), "TestModule");
+    EXPECT_FALSE(modulesMap.contains(details));
+    EXPECT_EQ(modulesMap.size(), 1);
+    // A late check sends one ping for all the elapsed intervals
+    expired.clear();
+    modulesMap.processDeadlines(t0 + 1025ms, &pings, &expired);
+    EXPECT_EQ(pings.size(), 1);
+    EXPECT_TRUE(expired.empty());
+    modulesMap.processDeadlines(t0 + 1029ms, &pings, &expired);
+    EXPECT_EQ(pings.size(), 1);
+    modulesMap.processDeadlines(t0 + 1030ms, &pings, &expired);
+    EXPECT_EQ(expired.size(), 1);
+    EXPECT_TRUE(modulesMap.empty());
+}
+
 TEST(Command, AvailableModulesRequest)
 {
     const int64_t identifier{48233};
@@ -335,11 +508,21 @@ TEST(Command, AvailableModulesRequest)
     AvailableModulesRequest rCopy;
     EXPECT_NO_THROW(rCopy.fromMessage(request.toMessage()));
     EXPECT_EQ(rCopy.getIdentifier(), identifier);
+    EXPECT_FALSE(rCopy.haveSinceVersion());
     EXPECT_EQ(rCopy.getMessageType(),
               "UMPS::ProxyServices::Command::AvailableModulesRequest");
 
+    const uint64_t sinceVersion{1668200000000000};
+    request.setSinceVersion(sinceVersion);
+    EXPECT_NO_THROW(rCopy.fromMessage(request.toMessage()));
+    EXPECT_TRUE(rCopy.haveSinceVersion());
+    EXPECT_EQ(rCopy.getSinceVersion(), sinceVersion);
+
     request.clear();
     EXPECT_EQ(request.getIdentifier(), 0); 
+    EXPECT_FALSE(request.haveSinceVersion());
+    EXPECT_THROW(static_cast<void> (request.getSinceVersion()),
+                 std::runtime_error);
 }
 
 TEST(Command, AvailableModulesResponse)
@@ -377,6 +560,24 @@ TEST(Command, AvailableModulesResponse)
         }
         EXPECT_TRUE(lMatch);
     }
+    EXPECT_EQ(rCopy.getVersion(), 0);
+    EXPECT_FALSE(rCopy.isIncremental());
+    // Incremental response
+    const uint64_t version{1668200000000123};
+    response.setVersion(version);
+    response.setIncremental(true);
+    response.setModules(std::vector<UMPS::ProxyServices::Command::ModuleDetails>
+                        {details[0]});
+    response.setRemovedModules(
+        std::vector<UMPS::ProxyServices::Command::ModuleDetails> {details[1]});
+    EXPECT_NO_THROW(rCopy.fromMessage(response.toMessage()));
+    EXPECT_EQ(rCopy.getVersion(), version);
+    EXPECT_TRUE(rCopy.isIncremental());
+    ASSERT_EQ(rCopy.getModules().size(), 1);
+    EXPECT_TRUE(rCopy.getModules().at(0) == details[0]);
+    ASSERT_EQ(rCopy.getRemovedModules().size(), 1);
+    EXPECT_TRUE(rCopy.getRemovedModules().at(0) == details[1]);
+
     response.clear();
     EXPECT_EQ(response.getMessageType(),
               "UMPS::ProxyServices::Command::AvailableModulesResponse");
@@ -411,6 +612,11 @@ TEST(Command, ReplierOptions)
     EXPECT_NO_THROW(options.setPollingTimeOut(timeOut));
     EXPECT_NO_THROW(options.setSendHighWaterMark(sendHWM));
     EXPECT_NO_THROW(options.setReceiveHighWaterMark(receiveHWM));
+    EXPECT_THROW(options.setNumberOfWorkers(-1), std::invalid_argument);
+    EXPECT_NO_THROW(options.setNumberOfWorkers(3));
+    EXPECT_THROW(options.setMaximumNumberOfRequestsInFlight(0),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(options.setMaximumNumberOfRequestsInFlight(12));
     options.setCallback(std::bind(&dumbyCallback,
                                  std::placeholders::_1,
                                  std::placeholders::_2,
@@ -424,6 +630,8 @@ TEST(Command, ReplierOptions)
     EXPECT_EQ(copy.getOptions().getSendHighWaterMark(), sendHWM);
     EXPECT_EQ(copy.getOptions().getReceiveHighWaterMark(), receiveHWM);
     EXPECT_TRUE(copy.getModuleDetails() == details);
+    EXPECT_EQ(copy.getNumberOfWorkers(), 3);
+    EXPECT_EQ(copy.getMaximumNumberOfRequestsInFlight(), 12);
 
     options.clear();
     zapOptions.clear();
@@ -433,6 +641,8 @@ TEST(Command, ReplierOptions)
               zapOptions.getSecurityLevel()); 
     EXPECT_EQ(options.getSendHighWaterMark(), 0);
     EXPECT_EQ(options.getReceiveHighWaterMark(), 0);
+    EXPECT_EQ(options.getNumberOfWorkers(), 0);
+    EXPECT_EQ(options.getMaximumNumberOfRequestsInFlight(), 64);
     EXPECT_FALSE(options.haveAddress());
     EXPECT_FALSE(options.haveModuleDetails());
 } 
@@ -0,0 +1,86 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include "private/ringBuffer.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(Utilities, SPSCRingBuffer)
+{
+    SPSCRingBuffer<std::unique_ptr<int>> buffer(3);
+    EXPECT_EQ(buffer.capacity(), 4);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.getFileDescriptor(), -1);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(buffer.try_push(std::make_unique<int> (i)));
+    }
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_FALSE(buffer.try_push(std::make_unique<int> (4)));
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(buffer.try_pop(&value));
+    EXPECT_EQ(*value, 0);
+    auto next = buffer.try_pop();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(**next, 1);
+    // Wrap around
+    EXPECT_TRUE(buffer.try_push(std::make_unique<int> (4)));
+    EXPECT_TRUE(buffer.try_push(std::make_unique<int> (5)));
+    for (int i = 2; i < 6; ++i)
+    {
+        EXPECT_TRUE(buffer.try_pop(&value));
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_FALSE(buffer.try_pop(&value));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(Utilities, MPSCRingBuffer)
+{
+    constexpr int nProducers{4};
+    constexpr int nValues{20000};
+    MPSCRingBuffer<std::pair<int, int>> buffer(64, true);
+    EXPECT_GE(buffer.getFileDescriptor(), 0);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < nProducers; ++producer)
+    {
+        producers.push_back(std::thread([&buffer, producer]()
+        {
+            for (int i = 0; i < nValues; ++i)
+            {
+                while (!buffer.try_push(std::pair{producer, i}))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    // Each producer's values must arrive in order
+    std::vector<int> expected(nProducers, 0);
+    std::pair<int, int> value;
+    int nReceived{0};
+    while (nReceived < nProducers*nValues)
+    {
+        if (buffer.wait_until_and_pop(&value,
+                                      std::chrono::milliseconds {1000}))
+        {
+            EXPECT_EQ(value.second, expected.at(value.first));
+            expected.at(value.first) = value.second + 1;
+            nReceived = nReceived + 1;
+        }
+        else
+        {
+            break;
+        }
+    }
+    for (auto &producer : producers){producer.join();}
+    EXPECT_EQ(nReceived, nProducers*nValues);
+    EXPECT_FALSE(buffer.wait_until_and_pop(&value,
+                                           std::chrono::milliseconds {5}));
+}
+
+}